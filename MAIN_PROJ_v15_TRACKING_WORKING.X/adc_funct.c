@@ -0,0 +1,147 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the analog IR front end. The
+ |               amplitudes are written by the low priority interrupt only.
+ |               The ADC configuration can be found on init_adc() of
+ |               hal_pic.c
+ +===========================================================================*/
+#include "hal.h"
+#include "adc_funct.h"
+#include "battery_funct.h"
+
+#ifdef IR_ANALOG
+
+uint16_t adc_level[2]; // Amplitude of each sensor in ADC counts, Q5
+unsigned char adc_on = 0; // 1 while a pulse is received
+unsigned char adc_loops = 0; // Loops since the last supply sample
+
+/*=============================================================================
+ |  Function adc_service
+ |
+ |  Purpose: adc_service takes the words sampled by the last loop of the
+ |           ADC from the FIFO: the pair of sensors, then the supply
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by the low priority interrupt on every entry, as the
+ |            ADC interrupt is enabled along the tick. The FIFO holds the
+ |            4 words of a loop, AN0 - AN3, and interrupts once full, so a
+ |            word is lost if the interrupt is held off for longer than
+ |            about 350 us after (e.g. by the high priority interrupt). The
+ |            FIFO is then out of step with the loop, and is emptied with
+ |            the loop stopped before sampling resumes. Only every
+ |            ADC_SUPPLY_EVERY loop passes the supply on, as it changes
+ |            slowly.
++============================================================================*/
+
+void adc_service(void) {
+    uint16_t right, supply;
+
+    if (!hal_adc_flag()) {
+        return;
+    }
+    hal_adc_clear();
+    if (hal_adc_overflow()) {
+        hal_adc_stop();
+        while (!hal_adc_empty()) {
+            (void) hal_adc_read();
+        }
+        hal_adc_overflow_clear();
+        hal_adc_start();
+        return;
+    }
+    right = hal_adc_read();
+    adc_pair(right, hal_adc_read());
+    supply = hal_adc_read();
+    (void) hal_adc_read(); // AN3, unused
+    if (++adc_loops >= ADC_SUPPLY_EVERY) {
+        adc_loops = 0;
+        bat_sample(supply);
+    }
+}
+
+/*=============================================================================
+ |  Function adc_pair
+ |
+ |  Purpose: adc_pair updates the amplitude of both sensors from a pair
+ |           sampled simultaneously
+ |
+ |  Parameters:
+ |      right (uint16_t) - Sample of sensor 0 (IR3), 0 - 1023
+ |      left (uint16_t) - Sample of sensor 1 (IR2), 0 - 1023
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: A pulse is received while the sum of the pair is ADC_FLOOR
+ |            or more, so a beacon seen by one sensor only is taken. The
+ |            first pair of a pulse sets the amplitudes, and each further
+ |            pair moves them by 1 / 2^ADC_SHIFT of the difference, which
+ |            smooths the noise of each sample while following the
+ |            amplitude within the pulse. Both sensors are taken alike on
+ |            the same pairs, so their ratio, the bearing, is not skewed
+ |            by the smoothing.
++============================================================================*/
+
+void adc_pair(uint16_t right, uint16_t left) {
+    if (right + left < ADC_FLOOR) {
+        adc_on = 0; // Between pulses, the amplitudes held
+        return;
+    }
+    right <<= ADC_Q;
+    left <<= ADC_Q;
+    if (adc_on == 0) {
+        adc_on = 1;
+        adc_level[0] = right;
+        adc_level[1] = left;
+        return;
+    }
+    adc_level[0] += (int16_t) (right - adc_level[0]) >> ADC_SHIFT;
+    adc_level[1] += (int16_t) (left - adc_level[1]) >> ADC_SHIFT;
+}
+
+/*=============================================================================
+ |  Function adc_ir
+ |
+ |  Purpose: adc_ir returns the amplitude of a sensor, for get_ir()
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |
+ |  Returns:
+ |      Unsigned integer of the amplitude times ADC_SCALE, 0 - 49104, as
+ |      the pulse width in us of the capture, or 0 before the first pulse
++============================================================================*/
+
+unsigned int adc_ir(unsigned char sensor) {
+    uint16_t level;
+
+    hal_irq_low_off(); // Amplitude written by the ADC interrupt
+    level = adc_level[sensor];
+    hal_irq_low_on();
+    return (unsigned int) (((uint32_t) level * ADC_SCALE) >> ADC_Q);
+}
+
+#endif
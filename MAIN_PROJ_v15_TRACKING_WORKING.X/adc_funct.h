@@ -0,0 +1,67 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the analog IR front
+ |               end, an alternative to the capture of the receiver outputs
+ |               for sensors with an analog output, selected by building
+ |               with IR_ANALOG defined (which implies BEACON_RAW, as there
+ |               are no edges to track). The high speed ADC samples both
+ |               sensors simultaneously in a continuous loop, sensor 0 (IR3)
+ |               on AN0 and sensor 1 (IR2) on AN1, at about 1.1 kHz per pair
+ |               (see init_adc()), followed by the supply on AN2 (see
+ |               battery_funct.h), and the low priority interrupt takes
+ |               each pair from the ADC FIFO as it fills. While a pulse is
+ |               received, the amplitude of each sensor is smoothed over
+ |               the pairs (see adc_pair()), so get_ir() returns a reading
+ |               updated about every 0.9 ms within each pulse rather than
+ |               once per pulse, scaled to the pulse width captured for
+ |               the same signal. Between pulses the reading of the last
+ |               pulse is held, as a capture buffer holds its last width.
+ |               Without IR_ANALOG every call compiles to nothing, and the
+ |               supply is sampled on its own. Detailed function
+ |               descriptions can be found in the adc_funct.c file.
+ +===========================================================================*/
+
+#ifndef ADC_FUNCT_H
+#define	ADC_FUNCT_H
+
+#include <stdint.h>
+
+#define ADC_SUPPLY_EVERY 16 // Loops per supply sample, about 14 ms
+#define ADC_FLOOR 64 // Sum of a pair from which a pulse is received
+#define ADC_SHIFT 2 // Smoothing of the amplitude, over about 4 pairs
+#define ADC_Q 5 // Fractional bits of the amplitude
+#define ADC_SCALE 48 // Reading per ADC count, 1023 close to 50 ms
+
+#ifdef IR_ANALOG
+// ADC interrupt flag, for the trace of lp_timer()
+#define adc_flag() hal_adc_flag()
+
+void adc_service(void);
+void adc_pair(uint16_t right, uint16_t left);
+unsigned int adc_ir(unsigned char sensor);
+#else
+#define adc_flag() 0
+#define adc_service() ((void) 0)
+#endif
+
+#endif
@@ -0,0 +1,248 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the supply monitor. The
+ |               supply is written by the low priority interrupt, and the
+ |               duty scale by the main program only. The ADC configuration
+ |               can be found on init_adc() of hal_pic.c
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "record_funct.h"
+#include "replay_funct.h"
+#include "fix_funct.h"
+#include "battery_funct.h"
+
+unsigned char bat_gain = BAT_GAIN_ONE; // Main program only
+uint16_t bat_level = 0; // Smoothed supply, ADC counts in Q3, 0 before a sample
+unsigned char bat_fresh = 0; // Sampled since the duty scale was updated
+unsigned char bat_ms = 0; // Ticks since the last conversion
+#ifdef BAT_REPORT
+uint16_t bat_rest = 0; // Supply when last at rest, Q3
+uint16_t bat_low = 0xFFFF; // Lowest supply under load this RUN, Q3
+unsigned char bat_driven = 0; // Bit per motor channel with a duty
+#endif
+
+#ifndef IR_ANALOG
+/*=============================================================================
+ |  Function bat_service
+ |
+ |  Purpose: bat_service takes the conversion of the supply started by the
+ |           last call, and starts the next, every BAT_MS
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by the low priority interrupt on every tick. The
+ |            conversion takes about 350 us, so is long done by the next
+ |            call, and the main program never waits for it. The ADC
+ |            interrupt is not enabled, but its flag is cleared, as it is
+ |            read by the trace of lp_timer().
++============================================================================*/
+
+void bat_service(void) {
+    if (++bat_ms < BAT_MS) {
+        return;
+    }
+    bat_ms = 0;
+    if (!hal_adc_empty()) {
+        bat_sample(hal_adc_read());
+    }
+    hal_adc_clear();
+    hal_adc_start();
+}
+#endif
+
+/*=============================================================================
+ |  Function bat_sample
+ |
+ |  Purpose: bat_sample smooths a sample of the supply, and in BAT_REPORT
+ |           builds keeps it at rest or its lowest under load
+ |
+ |  Parameters:
+ |      sample (uint16_t) - AN2, 0 - 1023
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by the low priority interrupt only. The supply is at
+ |            rest while both motors are off, as last set by set_motor_pwm()
+ |            (see bat_duty()), else under load.
++============================================================================*/
+
+void bat_sample(uint16_t sample) {
+    sample <<= BAT_Q;
+    if (bat_level == 0) {
+        bat_level = sample; // First sample
+    } else {
+        bat_level += (int16_t) (sample - bat_level) >> BAT_SHIFT;
+    }
+#ifdef BAT_REPORT
+    if (bat_driven == 0) {
+        bat_rest = bat_level;
+    } else if (bat_level < bat_low) {
+        bat_low = bat_level;
+    }
+#endif
+    bat_fresh = 1;
+}
+
+#ifdef BAT_REPORT
+/*=============================================================================
+ |  Function bat_reset
+ |
+ |  Purpose: bat_reset forgets the lowest supply under load, at the start of
+ |           a RUN
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void bat_reset(void) {
+    hal_irq_low_off();
+    bat_low = 0xFFFF;
+    hal_irq_low_on();
+}
+#endif
+
+/*=============================================================================
+ |  Function bat_poll
+ |
+ |  Purpose: bat_poll updates the duty scale, BAT_NOMINAL_MV over the supply,
+ |           once after each sample
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by the main program only, by bat_duty() and by
+ |            motor_refresh() while the motors hold their power, rather than
+ |            by the interrupt, as the division (see fix_frac()) is shared
+ |            with the main program. The scale only follows changes of
+ |            BAT_GAIN_HYST or more, so the duty does not flicker with the
+ |            noise of the samples, and each change is in the sensor log of
+ |            REPLAY_LOG builds (see replay_funct.h), as it alters the motor
+ |            outputs.
++============================================================================*/
+
+void bat_poll(void) {
+    uint16_t level;
+    unsigned char gain;
+
+    if (bat_fresh) {
+        hal_irq_low_off(); // Supply written by the interrupt
+        bat_fresh = 0;
+        level = bat_level;
+        hal_irq_low_on();
+        if (level >= (BAT_COUNTS(BAT_MIN_MV) << BAT_Q)) {
+            // BAT_NOMINAL_MV / supply in Q7, from half of it in Q15
+            gain = fix_frac(BAT_COUNTS(BAT_NOMINAL_MV) << (BAT_Q - 1), level) >> 7;
+            if (gain > BAT_GAIN_MAX) {
+                gain = BAT_GAIN_MAX;
+            }
+            if ((gain >= bat_gain + BAT_GAIN_HYST) | (gain + BAT_GAIN_HYST <= bat_gain)) {
+                bat_gain = gain;
+                rpl_supply(gain); // Sensor log, REPLAY_LOG builds only
+            }
+        }
+    }
+}
+
+/*=============================================================================
+ |  Function bat_duty
+ |
+ |  Purpose: bat_duty scales the PWM duty of a motor to the supply, for
+ |           set_motor_pwm()
+ |
+ |  Parameters:
+ |      channel (unsigned char) - Motor channel, 0 or 1
+ |      duty (unsigned char) - Duty at BAT_NOMINAL_MV, 0 - PWM_PERIOD
+ |
+ |  Returns:
+ |      Unsigned char of the duty times the duty scale, up to PWM_PERIOD
+ |
+ |  Comments: The duty scale is first updated from the latest sample, if
+ |            any (see bat_poll()).
++============================================================================*/
+
+unsigned char bat_duty(unsigned char channel, unsigned char duty) {
+    uint16_t scaled;
+
+#ifdef BAT_REPORT
+    if (duty == 0) {
+        bat_driven &= ~(1 << channel);
+    } else {
+        bat_driven |= 1 << channel;
+    }
+#endif
+    bat_poll();
+    scaled = fix_mul8(duty, bat_gain) >> 7;
+    return (scaled > PWM_PERIOD) ? PWM_PERIOD : scaled;
+}
+
+#ifdef BAT_REPORT
+/*=============================================================================
+ |  Function bat_dump
+ |
+ |  Purpose: bat_dump sends the supply over serial: now, at rest, lowest
+ |           under load this RUN and the sag, in mV, then the duty scale in
+ |           Q7, as hexadecimal
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: With no load this RUN, the lowest supply is that at rest.
++============================================================================*/
+
+void bat_dump(void) {
+    uint16_t mv[4];
+    unsigned char i;
+
+    hal_irq_low_off();
+    mv[0] = bat_level;
+    mv[1] = bat_rest;
+    mv[2] = (bat_low == 0xFFFF) ? bat_rest : bat_low;
+    hal_irq_low_on();
+    for (i = 0; i < 3; i++) {
+        mv[i] = fix_mul16(mv[i], BAT_MV_Q12) >> (12 + BAT_Q);
+    }
+    mv[3] = (mv[1] > mv[2]) ? mv[1] - mv[2] : 0;
+
+    put_string_serial(TEXT("BAT\r\n"));
+    for (i = 0; i < 4; i++) {
+        put_hex(mv[i] >> 8);
+        put_hex(mv[i]);
+        put_char_serial(' ');
+    }
+    put_hex(bat_gain);
+    put_string_serial(TEXT("\r\nEND\r\n"));
+}
+#endif
@@ -0,0 +1,80 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the supply monitor,
+ |               which keeps the motor speed of each power level independent
+ |               of the battery charge. The battery is read on AN2 (RA2)
+ |               through a 1:BAT_DIVIDER divider, in the background: by a
+ |               single conversion every BAT_MS from the tick, or in
+ |               IR_ANALOG builds from the sequence of the analog IR front
+ |               end (see adc_funct.h). The samples are smoothed, and the
+ |               PWM duty of set_motor_pwm() is scaled by BAT_NOMINAL_MV over
+ |               the supply (see bat_duty()), such that each power gives the
+ |               same mean motor voltage as on the supply at which it was
+ |               tuned, up to BAT_GAIN_MAX, or full duty. Built with
+ |               BAT_REPORT defined, the supply is kept at rest, with both
+ |               motors off, and at its lowest under load since the start of
+ |               the RUN, the difference being the sag, and sent over serial
+ |               when 'V' is received in standby.
+ |               Below BAT_MIN_MV, as when powered by the programmer, the
+ |               duty is left as it was. Detailed function descriptions can
+ |               be found in the battery_funct.c file.
+ +===========================================================================*/
+
+#ifndef BATTERY_FUNCT_H
+#define	BATTERY_FUNCT_H
+
+#include <stdint.h>
+
+#define BAT_DIVIDER 2 // Battery to AN2 divider, 7.2 V read as 3.6 V
+#define BAT_NOMINAL_MV 7200 // Supply at which the powers were tuned
+#define BAT_MIN_MV 4000 // Lowest supply compensated, else no battery
+#define BAT_MS 16 // Sample period, by the tick
+#define BAT_SHIFT 3 // Smoothing of the samples, over about 8
+#define BAT_Q 3 // Fractional bits of the smoothed supply
+#define BAT_GAIN_ONE 128 // Duty scale, Q7
+#define BAT_GAIN_MAX 192 // At most 1.5 times the duty, 4.8 V
+#define BAT_GAIN_HYST 2 // Least change of the duty scale, about 1.5%
+
+// Supply in ADC counts of AN2 (5 V reference) from mV, for constant mV only
+#define BAT_COUNTS(mv) ((uint16_t) ((mv) * 1023UL / (5000UL * BAT_DIVIDER)))
+// mV per ADC count in Q12, for bat_dump()
+#define BAT_MV_Q12 ((uint16_t) (5000.0 * BAT_DIVIDER * 4096 / 1023 + 0.5))
+
+extern unsigned char bat_gain; // Duty scale, Q7
+
+#ifndef IR_ANALOG
+void bat_service(void);
+#else
+#define bat_service() ((void) 0) // Sampled along the IR sensors
+#endif
+void bat_sample(uint16_t sample);
+void bat_poll(void);
+unsigned char bat_duty(unsigned char channel, unsigned char duty);
+#ifdef BAT_REPORT
+void bat_reset(void);
+void bat_dump(void);
+#else
+#define bat_reset() ((void) 0)
+#endif
+
+#endif
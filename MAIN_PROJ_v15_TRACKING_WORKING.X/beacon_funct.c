@@ -0,0 +1,440 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the beacon tracker. The
+ |               tracks and pulses are written by the low priority interrupt
+ |               only, and the main program reads the widths of the locked
+ |               track with it held off. Times are in ticks of the capture
+ |               time base (see BCN_TICK_SHIFT), as the main program resets
+ |               G_time_ms in standby and on every RUN, while the beacons
+ |               are tracked throughout. The signature and limits can be
+ |               found on the header file beacon_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "record_funct.h"
+#include "beacon_funct.h"
+
+#ifndef BEACON_RAW
+
+struct BcnTrack bcn_tracks[BCN_TRACKS]; // Low priority interrupt only
+struct BcnPulse bcn_pulses[BCN_PULSES];
+unsigned char bcn_last = 0; // Index of the latest pulse
+volatile unsigned char bcn_lock = BCN_NONE;
+
+/*=============================================================================
+ |  Function bcn_init
+ |
+ |  Purpose: bcn_init frees every track and pulse
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by cap_init(), with the low priority interrupt held
+ |            off.
++============================================================================*/
+
+void bcn_init(void) {
+    unsigned char i;
+
+    for (i = 0; i < BCN_TRACKS; i++) {
+        bcn_tracks[i].period_tk = 0;
+    }
+    for (i = 0; i < BCN_PULSES; i++) {
+        bcn_pulses[i].sensors = 0;
+    }
+    bcn_last = 0;
+    bcn_lock = BCN_NONE;
+}
+
+/*=============================================================================
+ |  Function bcn_stale
+ |
+ |  Purpose: bcn_stale tells whether a track has missed more than BCN_MISSES
+ |           pulses in a row
+ |
+ |  Parameters:
+ |      *t (struct BcnTrack) - Address of the track, in use
+ |      now (unsigned int) - Time, in ticks
+ |
+ |  Returns:
+ |      Unsigned char, 1 if stale
++============================================================================*/
+
+unsigned char bcn_stale(const struct BcnTrack *t, unsigned int now) {
+    return (unsigned int) (now - t->last_tk) >
+            (BCN_MISSES + 1) * t->period_tk + BCN_TICKS(BCN_TOL_MS);
+}
+
+/*=============================================================================
+ |  Function bcn_predict
+ |
+ |  Purpose: bcn_predict assigns a new pulse to the track which predicted its
+ |           end most closely, within BCN_TOL_MS
+ |
+ |  Parameters:
+ |      now (unsigned int) - Time at the end of the pulse, in ticks
+ |
+ |  Returns:
+ |      Unsigned char of the index of the track, or BCN_NONE
+ |
+ |  Comments: The end is predicted after 1 to BCN_MISSES + 1 periods. Tracks
+ |            which missed more are freed, except the locked one, which
+ |            keeps its widths until another track takes the lock, and is
+ |            predicted in phase for up to BCN_COAST_MS, as the target is
+ |            lost for a while on every turn away from it. Its phase is
+ |            the remainder of the time since its last pulse over the
+ |            period, found by BCN_COAST_SHIFT + 1 shifted subtractions
+ |            rather than a division. The period follows the beacon by 1
+ |            tick per pulse, again rather than by a division, after
+ |            consecutive pulses only.
++============================================================================*/
+
+unsigned char bcn_predict(unsigned int now) {
+    struct BcnTrack *t;
+    unsigned char i, k;
+    unsigned char best = BCN_NONE;
+    unsigned char best_k = 0;
+    int best_err = 0;
+    unsigned int best_abs = BCN_TICKS(BCN_TOL_MS) + 1;
+    unsigned int expect, half, phase, step;
+    int err;
+
+    for (i = 0; i < BCN_TRACKS; i++) {
+        t = &bcn_tracks[i];
+        if (t->period_tk == 0) {
+            continue;
+        }
+        if (bcn_stale(t, now)) {
+            if (i != bcn_lock) {
+                t->period_tk = 0;
+            } else if ((unsigned int) (now - t->last_tk) < BCN_TICKS(BCN_COAST_MS)) {
+                // Found again in phase, after any number of pulses missed
+                half = t->period_tk >> 1;
+                phase = now - t->last_tk + half;
+                for (step = t->period_tk << BCN_COAST_SHIFT; step >= t->period_tk; step >>= 1) {
+                    if (phase >= step) {
+                        phase -= step;
+                    }
+                }
+                err = (int) phase - (int) half;
+                if ((unsigned int) ((err < 0) ? -err : err) < best_abs) {
+                    best_abs = (err < 0) ? -err : err;
+                    best_k = 0;
+                    best = i;
+                }
+            }
+            continue;
+        }
+        expect = 0;
+        for (k = 1; k <= BCN_MISSES + 1; k++) {
+            expect += t->period_tk;
+            err = (int) (now - t->last_tk - expect);
+            if ((unsigned int) ((err < 0) ? -err : err) < best_abs) {
+                best_abs = (err < 0) ? -err : err;
+                best_err = err;
+                best_k = k;
+                best = i;
+            }
+        }
+    }
+    if (best != BCN_NONE) {
+        t = &bcn_tracks[best];
+        t->last_tk = now;
+        if (best_k == 1) {
+            if (best_err > 0) {
+                t->period_tk++;
+            } else if (best_err < 0) {
+                t->period_tk--;
+            }
+        }
+    }
+    return best;
+}
+
+/*=============================================================================
+ |  Function bcn_detect
+ |
+ |  Purpose: bcn_detect looks for a new beacon among the unassigned pulses,
+ |           as two of them spaced as the new pulse is from the later one
+ |
+ |  Parameters:
+ |      now (unsigned int) - Time at the end of the new pulse, in ticks, the
+ |                           latest of bcn_pulses
+ |
+ |  Returns:
+ |      Unsigned char of the index of the new track, or BCN_NONE
+ |
+ |  Comments: The pulses are searched from the latest, so the shortest
+ |            period found is taken rather than a multiple of it. The new
+ |            track takes a free slot, else that of the track heard from
+ |            least recently, but never the locked one.
++============================================================================*/
+
+unsigned char bcn_detect(unsigned int now) {
+    struct BcnPulse *a, *b;
+    struct BcnTrack *t;
+    unsigned char i, j, k, slot;
+    unsigned int period, gap, age, oldest;
+
+    for (i = 1; i < BCN_PULSES; i++) {
+        a = &bcn_pulses[(bcn_last - i) & (BCN_PULSES - 1)];
+        period = now - a->end_tk;
+        if ((a->sensors == 0) | (a->track != BCN_NONE) |
+                (period < BCN_TICKS(BCN_MIN_MS)) | (period > BCN_TICKS(BCN_MAX_MS))) {
+            continue;
+        }
+        for (j = i + 1; j < BCN_PULSES; j++) {
+            b = &bcn_pulses[(bcn_last - j) & (BCN_PULSES - 1)];
+            gap = a->end_tk - b->end_tk;
+            if ((b->sensors == 0) | (b->track != BCN_NONE) |
+                    (gap + BCN_TICKS(BCN_TOL_MS) < period) |
+                    (gap > period + BCN_TICKS(BCN_TOL_MS))) {
+                continue;
+            }
+            // Three pulses a period apart
+            slot = BCN_NONE;
+            oldest = 0;
+            for (k = 0; k < BCN_TRACKS; k++) {
+                age = now - bcn_tracks[k].last_tk;
+                if (bcn_tracks[k].period_tk == 0) {
+                    slot = k;
+                    break;
+                }
+                if ((k != bcn_lock) && (age >= oldest)) {
+                    slot = k;
+                    oldest = age;
+                }
+            }
+            t = &bcn_tracks[slot];
+            t->last_tk = now;
+            t->period_tk = period;
+            t->width[0] = 0;
+            t->width[1] = 0;
+            t->skew_us = 0;
+            t->flags = 0;
+            a->track = slot;
+            b->track = slot;
+            return slot;
+        }
+    }
+    return BCN_NONE;
+}
+
+/*=============================================================================
+ |  Function bcn_pulse
+ |
+ |  Purpose: bcn_pulse assigns a pulse of a sensor to its pulse of both and
+ |           track, and locks to the track of the target beacon
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |      start (uint32_t) - Time at the falling edge, in us
+ |      end (uint32_t) - Time at the rising edge, in us
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by cap_edge(). A pulse of the sensor which has not yet
+ |            seen the latest pulse, ending within BCN_SAME_MS, is of that
+ |            pulse, otherwise it starts a new one. A pulse over
+ |            BCN_PULSE_MS is not taken, as the receiver merges the pulses
+ |            of two beacons which overlap, and gives the track BCN_LONG on
+ |            the second in a row only. The lock moves to a track with the
+ |            signature only once the locked one has gone stale or lost the
+ |            signature, so a second target beacon does not take it over.
+ |            Time in ticks is bits 10 - 25 of the capture time, so it
+ |            wraps every 67 s, which the tracks measure across, and runs
+ |            on as the capture time wraps. It jumps when the capture time
+ |            base loses overflows (see cap_time_us()), after which the
+ |            target is found again as a new track.
++============================================================================*/
+
+void bcn_pulse(unsigned char sensor, uint32_t start, uint32_t end) {
+    struct BcnPulse *p = &bcn_pulses[bcn_last];
+    struct BcnTrack *t;
+    uint32_t width = end - start;
+    int32_t skew = 0;
+    unsigned int now = (unsigned int) (end >> BCN_TICK_SHIFT);
+    unsigned char bit = 1 << sensor;
+    unsigned char lock = bcn_lock;
+    unsigned char k;
+
+    if ((p->sensors == 0) || ((p->sensors & bit) != 0) ||
+            ((unsigned int) (now - p->end_tk) > BCN_TICKS(BCN_SAME_MS))) {
+        bcn_last = (bcn_last + 1) & (BCN_PULSES - 1);
+        p = &bcn_pulses[bcn_last];
+        p->start_us = start;
+        p->end_tk = now;
+        p->sensors = 0;
+        p->track = bcn_predict(now);
+        if (p->track == BCN_NONE) {
+            p->track = bcn_detect(now);
+        }
+    } else {
+        // Second sensor of the pulse, left start minus right start
+        skew = (int32_t) (start - p->start_us);
+        if (sensor == 0) {
+            skew = -skew;
+        }
+    }
+    p->sensors |= bit;
+    if (p->track == BCN_NONE) {
+        return;
+    }
+
+    t = &bcn_tracks[p->track];
+    if (width > BCN_PULSE_MS * 1000UL + BCN_WIDTH_TOL) {
+        // Merged with a pulse of another beacon, unless the next is too
+        t->flags |= (t->flags & BCN_OVER) ? BCN_LONG : BCN_OVER;
+    } else {
+        t->flags &= ~BCN_OVER;
+        t->width[sensor] = (unsigned int) width;
+        if (p->sensors == 3) {
+            t->skew_us = (skew > 32767) ? 32767 : ((skew < -32767) ? -32767 : (int) skew);
+        }
+    }
+    if ((t->period_tk + BCN_TICKS(BCN_TOL_MS) < BCN_TICKS(BCN_PERIOD_MS)) |
+            (t->period_tk > BCN_TICKS(BCN_PERIOD_MS) + BCN_TICKS(BCN_TOL_MS)) | (t->flags & BCN_LONG)) {
+        if (lock == p->track) {
+            bcn_lock = BCN_NONE; // Lost the signature
+        }
+    } else if ((lock == BCN_NONE) || bcn_stale(&bcn_tracks[lock], now)) {
+        if ((lock != BCN_NONE) && (lock != p->track)) {
+            // Widths not yet captured on the new track carried over, as
+            // a capture buffer holds its last width
+            for (k = 0; k < 2; k++) {
+                if (t->width[k] == 0) {
+                    t->width[k] = bcn_tracks[lock].width[k];
+                }
+            }
+        }
+        bcn_lock = p->track;
+    }
+}
+
+/*=============================================================================
+ |  Function bcn_ir
+ |
+ |  Purpose: bcn_ir returns the last pulse width of a sensor on the track of
+ |           the target beacon, for get_ir()
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |
+ |  Returns:
+ |      Unsigned integer of the pulse width in us, as the capture buffer,
+ |      or 0 if the target has not been found
++============================================================================*/
+
+unsigned int bcn_ir(unsigned char sensor) {
+    unsigned int width = 0;
+
+    hal_irq_low_off(); // Width written by the capture interrupt
+    if (bcn_lock != BCN_NONE) {
+        width = bcn_tracks[bcn_lock].width[sensor];
+    }
+    hal_irq_low_on();
+    return width;
+}
+
+/*=============================================================================
+ |  Function bcn_skew
+ |
+ |  Purpose: bcn_skew returns the last skew between the sensors on the track
+ |           of the target beacon
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      Integer of the start of sensor 1 (left) minus that of sensor 0
+ |      (right), in us, positive with the beacon to the right, or 0 if the
+ |      target has not been found
++============================================================================*/
+
+int bcn_skew(void) {
+    int skew = 0;
+
+    hal_irq_low_off(); // Skew written by the capture interrupt
+    if (bcn_lock != BCN_NONE) {
+        skew = bcn_tracks[bcn_lock].skew_us;
+    }
+    hal_irq_low_on();
+    return skew;
+}
+
+/*=============================================================================
+ |  Function bcn_dump
+ |
+ |  Purpose: bcn_dump sends every track in use over serial, one per line:
+ |           index, period in ms, width of sensor 0 and 1 in us, skew in us
+ |           and flags, with 0x80 on the locked track, as hexadecimal
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Each track is copied with the low priority interrupt held off,
+ |            so its values are of the same pulse. The period is converted
+ |            from ticks here, outside the interrupt.
++============================================================================*/
+
+void bcn_dump(void) {
+    struct BcnTrack t;
+    unsigned int period;
+    unsigned char i, flags;
+
+    put_string_serial(TEXT("BCN\r\n"));
+    for (i = 0; i < BCN_TRACKS; i++) {
+        hal_irq_low_off();
+        t = bcn_tracks[i];
+        flags = t.flags | ((i == bcn_lock) ? 0x80 : 0);
+        hal_irq_low_on();
+        if (t.period_tk == 0) {
+            continue;
+        }
+        period = ((unsigned long) t.period_tk << BCN_TICK_SHIFT) / 1000; // In ms
+        put_hex(i);
+        put_char_serial(' ');
+        put_hex(period >> 8);
+        put_hex(period);
+        put_char_serial(' ');
+        put_hex(t.width[0] >> 8);
+        put_hex(t.width[0]);
+        put_char_serial(' ');
+        put_hex(t.width[1] >> 8);
+        put_hex(t.width[1]);
+        put_char_serial(' ');
+        put_hex((unsigned int) t.skew_us >> 8);
+        put_hex(t.skew_us);
+        put_char_serial(' ');
+        put_hex(flags);
+        put_string_serial(TEXT("\r\n"));
+    }
+    put_string_serial(TEXT("END\r\n"));
+}
+
+#endif
@@ -0,0 +1,150 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the beacon tracker,
+ |               which tells the target beacon from any other beacon in view
+ |               (e.g. that of a neighbouring course) by its pulse timing.
+ |               Every pulse of either sensor is time stamped at both edges
+ |               by the capture interrupt (see capture_funct.c). Pulses of
+ |               both sensors ending within BCN_SAME_MS are one, and the
+ |               skew between their starts, left minus right, is a bearing
+ |               cue of every pulse: positive when the right sensor saw the
+ |               pulse first, i.e. the beacon to the right, as the stronger
+ |               signal is received for longer. Pulses are assigned to a track
+ |               per beacon, which predicts the end of the next pulse from
+ |               the repetition period, and new beacons are found as three
+ |               unassigned pulses equally spaced in time. The tracker locks
+ |               to the first track with the signature of the target,
+ |               BCN_PERIOD_MS with no pulse longer than BCN_PULSE_MS, and
+ |               get_ir() returns the last pulse width of each sensor on
+ |               that track only, or 0 before the target is found. The
+ |               tracks are sent over serial when 'B' is received in
+ |               standby.
+ |               Only built with BEACON_TRACK defined. Otherwise, or with
+ |               BEACON_RAW defined (see hal.h), every call compiles to
+ |               nothing and get_ir() returns the capture buffers as they
+ |               stand, which then hold the pulse width measured in
+ |               hardware, as on a course with one beacon. The sensor replay is
+ |               built so (see the Makefile), as its log holds the readings
+ |               of the tracked beacon already. Detailed function
+ |               descriptions can be found in the beacon_funct.c file.
+ +===========================================================================*/
+
+#ifndef BEACON_FUNCT_H
+#define	BEACON_FUNCT_H
+
+#include <stdint.h>
+
+// Signature of the target beacon
+#define BCN_PERIOD_MS 250 // Repetition period
+#define BCN_PULSE_MS 50 // Pulse length, the longest width captured
+#define BCN_TOL_MS 8 // Jitter of a pulse end: receiver delay
+#define BCN_WIDTH_TOL 5000 // Width over BCN_PULSE_MS, in us, from noise
+
+#define BCN_SAME_MS 10 // Captures of both sensors of one pulse
+#define BCN_MIN_MS 60 // Periods of other beacons which are tracked
+#define BCN_MAX_MS 1000
+#define BCN_MISSES 2 // Pulses a track may miss in a row
+#define BCN_COAST_MS 8000 // Time the locked track may miss pulses for
+#define BCN_TRACKS 4 // Beacons tracked at once
+#define BCN_PULSES 8 // Last pulses kept, a power of 2
+#define BCN_NONE 0xFF
+
+// Time base of the tracks: the capture time in us shifted right, 1.024 ms
+// per tick, so the interrupt takes it without a division. The limits above
+// are converted at compile time
+#define BCN_TICK_SHIFT 10
+#define BCN_TICKS(ms) ((unsigned int) (((ms) * 1000UL + \
+        (1UL << (BCN_TICK_SHIFT - 1))) >> BCN_TICK_SHIFT))
+
+// Periods of the target the locked track coasts over, as a power of 2, for
+// the phase found by shifted subtractions (see bcn_predict()). The period,
+// so shifted, must fit in 16 bits
+#define BCN_COAST_SHIFT 6
+#if (BCN_COAST_MS + BCN_PERIOD_MS >= (BCN_PERIOD_MS - BCN_TOL_MS) << BCN_COAST_SHIFT) || \
+        ((BCN_PERIOD_MS + BCN_TOL_MS) << BCN_COAST_SHIFT > 65535)
+#error BCN_COAST_MS too long for BCN_COAST_SHIFT
+#endif
+
+#define BCN_LONG 0x01 // Flag of a track with pulses over BCN_PULSE_MS
+#define BCN_OVER 0x02 // Flag of a track whose last pulse was over
+
+/*=============================================================================
+ |  Structure BcnTrack
+ |
+ |  Purpose: One beacon in view
+ |
+ |  Parameters:
+ |      last_tk (unsigned int) - Time at the end of its last pulse, in ticks
+ |      period_tk (unsigned int) - Repetition period, in ticks, 0 if the
+ |                                 track is free
+ |      width[2] (unsigned int) - Last pulse width of sensor 0 (IR3) and 1
+ |                                (IR2), the intensity, in us
+ |      skew_us (int) - Last skew, start of sensor 1 (left) minus that of
+ |                      sensor 0 (right), on a pulse seen by both
+ |      flags (unsigned char) - BCN_LONG, BCN_OVER
++============================================================================*/
+
+struct BcnTrack {
+    unsigned int last_tk;
+    unsigned int period_tk;
+    unsigned int width[2];
+    int skew_us;
+    unsigned char flags;
+};
+
+/*=============================================================================
+ |  Structure BcnPulse
+ |
+ |  Purpose: One pulse received, by either sensor or both
+ |
+ |  Parameters:
+ |      start_us (uint32_t) - Time at the start of its first capture
+ |      end_tk (unsigned int) - Time at the end of its first capture, in
+ |                              ticks
+ |      sensors (unsigned char) - Bit per sensor captured, 0 if unused
+ |      track (unsigned char) - Index of its track, or BCN_NONE
++============================================================================*/
+
+struct BcnPulse {
+    uint32_t start_us;
+    unsigned int end_tk;
+    unsigned char sensors;
+    unsigned char track;
+};
+
+#ifndef BEACON_RAW
+extern struct BcnTrack bcn_tracks[BCN_TRACKS];
+extern volatile unsigned char bcn_lock; // Track of the target, or BCN_NONE
+
+void bcn_init(void);
+void bcn_pulse(unsigned char sensor, uint32_t start, uint32_t end);
+unsigned int bcn_ir(unsigned char sensor);
+int bcn_skew(void);
+void bcn_dump(void);
+#else
+#define bcn_ir(sensor) hal_capture(sensor)
+#define bcn_skew() 0
+#define bcn_dump() ((void) 0)
+#endif
+
+#endif
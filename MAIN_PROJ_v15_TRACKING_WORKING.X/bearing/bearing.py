@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+# =============================================================================
+#  Assignment: Explosive Ordinance Disposal
+#
+#  Author: Lim Siew Han & Justin Kek
+#  Language: Python 3
+#  Tools: None (see "make bearing")
+#  Microchip: PIC18F4331
+#
+#  School: Imperial College London
+#  Department: Mechanical Engineering
+#  Module: Embedded C for Microcontrollers
+#  Class: MEng Graduating 2021
+# -----------------------------------------------------------------------------
+#  Description: Generator of bearing_table.h, the table of bearing_funct.c
+#               which maps the normalised difference of the two IR readings,
+#               (L - R) / (L + R), to the bearing of the beacon. The angular
+#               response of the sensors is either modelled, as by the
+#               simulator (see sim/sim.c):
+#                   bearing.py [--tube-deg 10] [--half-deg 30] [--cos-n 8]
+#                              [--signal 5 | --linear] [-o bearing_table.h]
+#               or measured, from a CSV file of readings taken with the
+#               vehicle turned to known angles from the beacon:
+#                   bearing.py --csv sweep.csv [-o bearing_table.h]
+#               with columns angle (degrees, positive with the beacon to the
+#               left), left and right (readings of each sensor, normalised
+#               as by ir_normalise()). Readings at opposite angles are
+#               averaged, such that the table is symmetric.
+#
+#               The modelled capture saturates as 50000 * (1 - e^-signal),
+#               where --signal is the signal dead ahead of a tube at the
+#               distance of the table (5 for the simulated course at 2 m).
+#               The ratio, and so the bearing, is then exact at that
+#               distance only; with --linear (or readings well below
+#               saturation) it holds at any distance, as the distance
+#               scales both readings alike.
+#
+#               The table covers the ratio from 0 to that at the edge of
+#               the field of view shared by both tubes, where the bearing
+#               is limited. The exit status is 1 if the ratio does not rise
+#               with the angle over the response.
+# =============================================================================
+import argparse
+import csv
+import math
+import sys
+
+POINTS = 33  # Entries of the table, 32 intervals
+CAPTURE_FULL = 50000  # Pulse width of an infinite signal in us (see sim/sim.c)
+Q15 = 32768
+
+
+def model(tube_deg, half_deg, cos_n, signal):
+    """Ratio of the readings at an angle, and the largest angle seen by both
+    tubes, for tubes at +-tube_deg with a cos^n fall off within half_deg."""
+    def reading(off_deg):
+        s = math.cos(math.radians(off_deg)) ** cos_n
+        if signal is None:
+            return s
+        return CAPTURE_FULL * (1 - math.exp(-signal * s))
+
+    def ratio(angle):
+        left = reading(angle - tube_deg)
+        right = reading(angle + tube_deg)
+        return (left - right) / (left + right)
+
+    return ratio, half_deg - tube_deg
+
+
+def measured(path):
+    """Ratio of the readings at an angle, interpolated between the rows of a
+    CSV file, with opposite angles averaged, and the largest angle."""
+    rows = {}
+    with open(path, newline="") as f:
+        for row in csv.DictReader(f):
+            left = float(row["left"])
+            right = float(row["right"])
+            if left + right > 0:
+                rows[float(row["angle"])] = (left - right) / (left + right)
+    points = []
+    for angle in sorted(a for a in rows if a >= 0):
+        r = rows[angle]
+        if -angle in rows:
+            r = (r - rows[-angle]) / 2
+        points.append((angle, r))
+    if len(points) < 2:
+        raise ValueError("%s: fewer than 2 angles" % path)
+
+    def ratio(angle):
+        for (a0, r0), (a1, r1) in zip(points, points[1:]):
+            if angle <= a1:
+                return r0 + (r1 - r0) * (angle - a0) / (a1 - a0)
+        return points[-1][1]
+
+    return ratio, points[-1][0]
+
+
+def invert(ratio, edge_deg, r):
+    """Angle at which the response gives ratio r, by bisection."""
+    lo, hi = 0.0, edge_deg
+    for _ in range(60):
+        mid = (lo + hi) / 2
+        if ratio(mid) < r:
+            lo = mid
+        else:
+            hi = mid
+    return (lo + hi) / 2
+
+
+def table(ratio, edge_deg):
+    """Step (log2 of the spacing in Q15) and bearings in tenths of a degree,
+    the spacing being the least power of 2 which spans the response."""
+    steps = 200
+    angles = [edge_deg * k / steps for k in range(steps + 1)]
+    ratios = [ratio(a) for a in angles]
+    if any(r1 <= r0 for r0, r1 in zip(ratios, ratios[1:])):
+        raise ValueError("ratio does not rise with the angle")
+    r_max = ratios[-1]
+    step = 0
+    while (POINTS - 1) << step < r_max * Q15:
+        step += 1
+    values = []
+    for k in range(POINTS):
+        r = (k << step) / Q15
+        angle = edge_deg if r >= r_max else invert(ratio, edge_deg, r)
+        values.append(int(round(angle * 10)))
+    return step, values
+
+
+def header(out, source, step, values):
+    """Writes the table as a C header, with CRLF line ends as the sources."""
+    lines = [
+        "/* Bearing of the beacon against the normalised difference of the IR",
+        " * readings, written by bearing/bearing.py (see \"make bearing\") from",
+        " * " + source + ".",
+        " * Entry k is the bearing in tenths of a degree at a ratio of",
+        " * k << BEARING_STEP in Q15. Included by bearing_funct.c only. */",
+        "",
+        "#ifndef BEARING_TABLE_H",
+        "#define\tBEARING_TABLE_H",
+        "",
+        "#define BEARING_POINTS %d" % POINTS,
+        "#define BEARING_STEP %d" % step,
+        "",
+        "const int16_t bearing_table[BEARING_POINTS] = {",
+    ]
+    for k in range(0, POINTS, 8):
+        row = ", ".join(str(v) for v in values[k:k + 8])
+        lines.append("    " + row + ("," if k + 8 < POINTS else ""))
+    lines += ["};", "", "#endif", ""]
+    out.write("\r\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate the bearing table of bearing_funct.c")
+    parser.add_argument("--csv", help="measured readings (angle, left, right), else modelled")
+    parser.add_argument("--tube-deg", type=float, default=10)
+    parser.add_argument("--half-deg", type=float, default=30)
+    parser.add_argument("--cos-n", type=float, default=8)
+    parser.add_argument("--signal", type=float, default=5,
+                        help="signal dead ahead of a tube at the distance of the table")
+    parser.add_argument("--linear", action="store_true", help="model a sensor without saturation")
+    parser.add_argument("-o", "--output", default="bearing_table.h")
+    args = parser.parse_args()
+
+    try:
+        if args.csv:
+            ratio, edge = measured(args.csv)
+            source = "the readings of " + args.csv
+        else:
+            ratio, edge = model(args.tube_deg, args.half_deg, args.cos_n,
+                                None if args.linear else args.signal)
+            source = "the model of tubes at %g degrees, cos^%g within %g degrees, %s" % (
+                args.tube_deg, args.cos_n, args.half_deg,
+                "linear" if args.linear else "signal %g" % args.signal)
+        step, values = table(ratio, edge)
+    except (OSError, KeyError, ValueError) as e:
+        print("bearing: %s" % e, file=sys.stderr)
+        return 1
+    with open(args.output, "w", newline="") as out:
+        header(out, source, step, values)
+    print("%s: %d points, step %d, %.1f degrees at a ratio of %.4f" % (
+        args.output, POINTS, step, values[-1] / 10, ratio(edge)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
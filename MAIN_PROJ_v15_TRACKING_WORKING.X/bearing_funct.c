@@ -0,0 +1,72 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the bearing estimator. The
+ |               table is held in bearing_table.h, generated by
+ |               bearing/bearing.py (see "make bearing"). Function prototypes
+ |               can be found in the header file bearing_funct.h
+ +===========================================================================*/
+#include <stdint.h>
+#include "fix_funct.h"
+#include "bearing_funct.h"
+#include "bearing_table.h"
+
+/*=============================================================================
+ |  Function ir_bearing
+ |
+ |  Purpose: ir_bearing estimates the bearing of the beacon from the left and
+ |           right IR readings
+ |
+ |  Parameters:
+ |      left (unsigned int) - Reading of the left sensor, normalised
+ |      right (unsigned int) - Reading of the right sensor, normalised
+ |
+ |  Returns:
+ |      Integer of the bearing in tenths of a degree (BEARING_DEG per
+ |      degree), positive to the left. 0 if both readings are 0, and limited
+ |      to the last entry of bearing_table, the edge of the field of view
+ |      shared by both sensors
+ |
+ |  Comments: The ratio (L - R) / (L + R) is found by fix_ratio() in Q15,
+ |            and its magnitude looked up in bearing_table, interpolating
+ |            between entries.
++============================================================================*/
+
+int ir_bearing(unsigned int left, unsigned int right) {
+    int16_t ratio = fix_ratio(left, right);
+    uint16_t r = (ratio < 0) ? -ratio : ratio;
+    unsigned char k = (unsigned char) (r >> BEARING_STEP);
+    int16_t bearing;
+
+    if (k >= (BEARING_POINTS - 1)) {
+        bearing = bearing_table[BEARING_POINTS - 1];
+    } else {
+#if BEARING_STEP >= 8
+        bearing = fix_lerp(bearing_table[k], bearing_table[k + 1],
+                (uint8_t) (r >> (BEARING_STEP - 8)));
+#else
+        bearing = fix_lerp(bearing_table[k], bearing_table[k + 1],
+                (uint8_t) (r << (8 - BEARING_STEP)));
+#endif
+    }
+    return (ratio < 0) ? -bearing : bearing;
+}
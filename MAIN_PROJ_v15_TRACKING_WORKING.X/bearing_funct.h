@@ -0,0 +1,42 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the bearing estimator,
+ |               which maps the normalised difference of the two IR
+ |               readings, (L - R) / (L + R), to the bearing of the beacon
+ |               through a table in program memory. The table is generated
+ |               by bearing/bearing.py from the angular response of the
+ |               sensors, modelled or measured, into bearing_table.h. As the
+ |               distance scales both readings alike, the bearing does not
+ |               depend on it while the sensors are below saturation, unlike
+ |               the difference of the readings. Detailed function
+ |               descriptions can be found in the bearing_funct.c file.
+ +===========================================================================*/
+
+#ifndef BEARING_FUNCT_H
+#define	BEARING_FUNCT_H
+
+#define BEARING_DEG 10 // Units of a bearing per degree
+
+int ir_bearing(unsigned int left, unsigned int right);
+
+#endif
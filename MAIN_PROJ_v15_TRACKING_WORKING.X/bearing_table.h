@@ -0,0 +1,21 @@
+/* Bearing of the beacon against the normalised difference of the IR
+ * readings, written by bearing/bearing.py (see "make bearing") from
+ * the model of tubes at 10 degrees, cos^8 within 30 degrees, signal 5.
+ * Entry k is the bearing in tenths of a degree at a ratio of
+ * k << BEARING_STEP in Q15. Included by bearing_funct.c only. */
+
+#ifndef BEARING_TABLE_H
+#define	BEARING_TABLE_H
+
+#define BEARING_POINTS 33
+#define BEARING_STEP 7
+
+const int16_t bearing_table[BEARING_POINTS] = {
+    0, 28, 52, 70, 84, 96, 106, 114,
+    122, 129, 135, 141, 146, 151, 155, 160,
+    164, 167, 171, 175, 178, 181, 184, 187,
+    190, 193, 195, 198, 200, 200, 200, 200,
+    200
+};
+
+#endif
@@ -0,0 +1,165 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the edge capture of both IR
+ |               sensors. The sensors and the TMR5 overflow count are
+ |               written by the low priority interrupt only. The capture
+ |               modes can be found on the header file hal.h, and init_ir()
+ |               of hal_pic.c
+ +===========================================================================*/
+#include "hal.h"
+#include "capture_funct.h"
+#include "beacon_funct.h"
+
+#ifndef BEACON_RAW
+
+struct CapSensor cap_sensors[2]; // Low priority interrupt only
+uint16_t cap_wraps = 0; // TMR5 overflows counted, the upper 16 bits
+
+/*=============================================================================
+ |  Function cap_init
+ |
+ |  Purpose: cap_init forgets the edges of both sensors, clears the capture
+ |           and TMR5 overflow flags and frees the beacon tracker
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called once at power up, after init_ir() has enabled the
+ |            capture interrupts, so with the low priority interrupt held
+ |            off.
++============================================================================*/
+
+void cap_init(void) {
+    hal_irq_low_off();
+    cap_sensors[0].flags = 0;
+    cap_sensors[1].flags = 0;
+    hal_timer_wrap_clear();
+    hal_capture_clear(0);
+    hal_capture_clear(1);
+    bcn_init();
+    hal_irq_low_on();
+}
+
+/*=============================================================================
+ |  Function cap_time_us
+ |
+ |  Purpose: cap_time_us returns TMR5 extended to 32 bits by the overflows
+ |           counted
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      uint32_t of the time since power up, in us
+ |
+ |  Comments: Called by the low priority interrupt, or with it held off. An
+ |            overflow which is pending, not yet counted by cap_service(),
+ |            is counted here if TMR5 has wrapped since, as read in its
+ |            lower half. Overflows are lost while the high priority
+ |            interrupt runs for longer than 65 ms (700 ms on a button
+ |            press), which sets the time back by as many.
++============================================================================*/
+
+uint32_t cap_time_us(void) {
+    uint16_t count = hal_timer_us();
+    uint16_t wraps = cap_wraps;
+
+    if (hal_timer_wrap_flag() && (count < 0x8000)) {
+        wraps++;
+    }
+    return ((uint32_t) wraps << 16) | count;
+}
+
+/*=============================================================================
+ |  Function cap_service
+ |
+ |  Purpose: cap_service counts the TMR5 overflows and takes the edges
+ |           captured by both sensors
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by the low priority interrupt on every entry, as the
+ |            capture and TMR5 interrupts are enabled along the tick.
++============================================================================*/
+
+void cap_service(void) {
+    unsigned char sensor;
+
+    if (hal_timer_wrap_flag()) {
+        hal_timer_wrap_clear();
+        cap_wraps++;
+    }
+    for (sensor = 0; sensor < 2; sensor++) {
+        if (hal_capture_flag(sensor)) {
+            hal_capture_clear(sensor);
+            cap_edge(sensor, hal_capture(sensor), hal_capture_pin(sensor));
+        }
+    }
+}
+
+/*=============================================================================
+ |  Function cap_edge
+ |
+ |  Purpose: cap_edge time stamps an edge of a sensor, and passes each
+ |           complete pulse on to the beacon tracker
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |      count (uint16_t) - TMR5 captured at the edge
+ |      level (unsigned char) - Level of the input after the edge, 0 for a
+ |                              falling edge (pulse start), else rising
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The capture is extended to 32 bits from the time now, so any
+ |            edge up to 65 ms old is time stamped correctly, whatever the
+ |            latency of the interrupt. The direction of the edge is read
+ |            from the input, as both are captured alike. An edge
+ |            overwritten by the next before it was taken loses its pulse,
+ |            as a rising edge is only taken after a falling one.
++============================================================================*/
+
+void cap_edge(unsigned char sensor, uint16_t count, unsigned char level) {
+    struct CapSensor *c = &cap_sensors[sensor];
+    uint32_t now = cap_time_us();
+    uint32_t at = now - (uint16_t) ((uint16_t) now - count);
+
+    if (level == 0) {
+        if (c->flags & CAP_SEEN) {
+            c->period_us = at - c->fall_us;
+        }
+        c->fall_us = at;
+        c->flags = CAP_LOW | CAP_SEEN;
+    } else if (c->flags & CAP_LOW) {
+        c->flags &= ~CAP_LOW;
+        c->width_us = at - c->fall_us;
+        bcn_pulse(sensor, c->fall_us, at);
+    }
+}
+
+#endif
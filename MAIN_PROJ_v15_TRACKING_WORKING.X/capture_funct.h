@@ -0,0 +1,83 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the edge capture of
+ |               both IR sensors. CAP2 and CAP3 capture TMR5 on every edge
+ |               of the receiver outputs, which are low while a pulse is
+ |               received, and the low priority interrupt extends each
+ |               capture to 32 bits by the TMR5 overflows counted so far
+ |               (see cap_time_us()), about 71 minutes at 1 us per count.
+ |               From the edges of each sensor are derived:
+ |                   width - Falling to rising edge, the intensity, as the
+ |                           pulse width captured before, but never wraps
+ |                   period - Falling edge to the previous one
+ |               and every complete pulse is passed on to the beacon
+ |               tracker (see bcn_pulse()), which tells the beacons apart
+ |               and measures the skew between the falling edges of both
+ |               sensors on the same pulse.
+ |               Only built with BEACON_TRACK defined. Otherwise, or with
+ |               BEACON_RAW defined (see hal.h), the capture inputs measure
+ |               the pulse width in hardware instead, and every call
+ |               compiles to nothing. Detailed function descriptions can be
+ |               found in the capture_funct.c file.
+ +===========================================================================*/
+
+#ifndef CAPTURE_FUNCT_H
+#define	CAPTURE_FUNCT_H
+
+#include <stdint.h>
+
+#define CAP_LOW 0x01 // Flag of a sensor within a pulse, falling edge seen
+#define CAP_SEEN 0x02 // Flag of a sensor with a previous falling edge
+
+/*=============================================================================
+ |  Structure CapSensor
+ |
+ |  Purpose: Edges of one sensor
+ |
+ |  Parameters:
+ |      fall_us (uint32_t) - Time of the last falling edge, pulse start
+ |      width_us (uint32_t) - Last pulse width, falling to rising edge
+ |      period_us (uint32_t) - Between the last two falling edges
+ |      flags (unsigned char) - CAP_LOW, CAP_SEEN
++============================================================================*/
+
+struct CapSensor {
+    uint32_t fall_us;
+    uint32_t width_us;
+    uint32_t period_us;
+    unsigned char flags;
+};
+
+#ifndef BEACON_RAW
+extern struct CapSensor cap_sensors[2];
+
+void cap_init(void);
+void cap_service(void);
+uint32_t cap_time_us(void);
+void cap_edge(unsigned char sensor, uint16_t count, unsigned char level);
+#else
+#define cap_init() ((void) 0)
+#define cap_service() ((void) 0)
+#endif
+
+#endif
@@ -0,0 +1,331 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00), Optimisation Level 1 (see "make cycles")
+ |  Microchip: PIC18F4331 (simulated by gpsim)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the main file of the instruction cycle benchmark,
+ |               which is linked with the unmodified firmware (main.c
+ |               compiled with main() renamed to fw_main(), such that its
+ |               interrupt routines are the real ones) and calls each hot
+ |               path once with fixed arguments. The instruction cycles of
+ |               every call are counted by TIMER1 at Fosc/4 and stored in
+ |               cb_cycles[], which cycles.py reads from the simulated RAM
+ |               once cb_halt() is reached.
+ |               TIMER1 holds the exact low 16 bits of a count, and TIMER0
+ |               (16 bit, prescaler 1:256) the number of TIMER1 overflows,
+ |               such that calls of up to 8 s (__delay_ms() included) are
+ |               counted exactly without an overflow interrupt.
+ |               The benchmarks are the CB_ constants below, in the order in
+ |               which they are run and reported. cycles.py subtracts the
+ |               count of CB_EMPTY (timer start and stop alone) from every
+ |               other count.
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "tune_funct.h"
+#include "fmt_funct.h"
+#include "fix_funct.h"
+#include "bearing_funct.h"
+#include "beacon_funct.h"
+#include "capture_funct.h"
+
+// Benchmarks, named in lower case by cycles.py
+enum {
+    CB_EMPTY, // Timer start and stop only
+    CB_SET_MOTOR_PWM, // 75% forward
+    CB_ITOA_5, // itoa_5(54321), as replaced by fmt_dec(), for comparison
+    CB_FMT_DEC, // fmt_dec(54321, 5)
+    CB_FMT_SDEC, // fmt_sdec(-12345, 5)
+    CB_FMT_HEX, // fmt_hex(0xBEEF, 4)
+    CB_LMUL, // 16 x 16 bit product in unsigned long, as replaced by fix_mul16()
+    CB_FIX_MUL16, // fix_mul16(54321, 12345)
+    CB_FIX_MUL_Q8, // fix_mul_q8(-12345, 1.25)
+    CB_FIX_RATIO, // fix_ratio(40000, 30000)
+    CB_FIX_ATAN2, // fix_atan2(-12345, 23456)
+    CB_IR_BEARING, // ir_bearing(49500, 49200), 2 degrees on the default table
+    CB_CAP_EDGE, // cap_edge() of a falling edge, pulse start
+    CB_BCN_DETECT, // bcn_pulse() of the third pulse 250 ms apart, new track
+    CB_BCN_PREDICT, // bcn_pulse() of the next pulse, on the predicted track
+    CB_IR_NORMALISE, // Gain 1.25, offset -100
+    CB_IR_FILTER, // Four readings, 1000 ms of __delay_ms() included
+    CB_CRC8, // One byte
+    CB_LP_TIMER, // Tick interrupt, entry to return, nothing to record
+    CB_HP_RFID_BUTTON, // Button interrupt to RUN, 700 ms delay included
+    CB_GET_PACKET_SERIAL, // 16 byte packet, sent at 9600 baud by tune_tx()
+    CB_COUNT
+};
+
+#define CB_NONE 0xFFFFFFFF // Benchmark not reached
+
+// RFID packet, looped back from TX (RC6) to RX (RC7) by the gpsim script
+#define CB_PACKET "\x02" "0415AB7C33F5\r\n\x03"
+#define CB_PACKET_SIZE 16
+
+volatile unsigned long cb_cycles[CB_COUNT];
+
+// Transmit queue of tune_funct.c, used to send the packet from the interrupt
+extern unsigned char tune_tx_buf[TUNE_TX_SIZE];
+extern volatile unsigned char tune_tx_in;
+extern volatile unsigned char tune_tx_out;
+
+/*=============================================================================
+ |  Function cb_start
+ |
+ |  Purpose: cb_start clears and starts TIMER0 and TIMER1
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: TIMER1 is started last, such that the count starts on return.
++============================================================================*/
+
+void cb_start(void) {
+    T1CON = 0;
+    T0CON = 0;
+    TMR1H = 0; // Buffered, written with TMR1L
+    TMR1L = 0;
+    TMR0H = 0; // Buffered, written with TMR0L, which clears the prescaler
+    TMR0L = 0;
+    T0CON = 0b10000111; // On, 16 bit, instruction clock, prescaler 1:256
+    T1CON = 0b10000001; // 16 bit reads, instruction clock, 1:1, on
+}
+
+/*=============================================================================
+ |  Function cb_stop
+ |
+ |  Purpose: cb_stop stops TIMER1 and TIMER0 and stores the instruction cycles
+ |           counted since cb_start()
+ |
+ |  Parameters:
+ |      id (unsigned char) - Benchmark, index of cb_cycles
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: TIMER0 counts at most 256 cycles less than TIMER1, plus the
+ |            cycles between stopping each, so rounding the difference to
+ |            the nearest 65536 gives the number of TIMER1 overflows.
++============================================================================*/
+
+void cb_stop(unsigned char id) {
+    unsigned long fine;
+    unsigned long coarse;
+    T1CONbits.TMR1ON = 0;
+    T0CONbits.TMR0ON = 0;
+    fine = TMR1L; // Latches TMR1H
+    fine |= (unsigned int) TMR1H << 8;
+    coarse = TMR0L; // Latches TMR0H
+    coarse |= (unsigned int) TMR0H << 8;
+    coarse <<= 8;
+    cb_cycles[id] = (((coarse + 32768 - fine) >> 16) << 16) | fine;
+}
+
+/*=============================================================================
+ |  Function cb_halt
+ |
+ |  Purpose: cb_halt is reached once every benchmark is done, and is the
+ |           breakpoint at which cycles.py stops gpsim
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Never returns)
++============================================================================*/
+
+void cb_halt(void) {
+    while (1);
+}
+
+// itoa_5() and power() as they were before fmt_funct.c, as the reference
+// of CB_ITOA_5
+
+int ref_power(int number, int power) {
+    unsigned char i = 1;
+    int temp = number;
+    while (i < power) {
+        number = number * temp;
+        i++;
+    }
+    if (power == 0) {
+        number = 1;
+    }
+    return number;
+}
+
+void ref_itoa_5(unsigned int number, unsigned char* buffer) {
+    unsigned char k = 0;
+    while (k < 16) {
+        buffer[k] = 0;
+        k++;
+    }
+    unsigned int remainder = 0;
+    unsigned int quotient = 0;
+    unsigned char i = 4;
+    unsigned char j = 0;
+    while (i > 0) {
+        quotient = number / ref_power(10, i);
+        remainder = number % ref_power(10, i);
+        buffer[j] = (quotient + 48); // Convert the numbers to ASCII chars
+        number = remainder;
+        i--;
+        j++;
+    }
+    buffer[j] = (number + 48); // Convert the last number to ASCII char
+}
+
+void main(void) {
+    struct DC_motor motor;
+    struct IRCal cal;
+    unsigned char buffer[16]; // As cleared by ref_itoa_5()
+    unsigned char packet[16];
+    volatile uint16_t a = 54321, b = 12345; // Not folded by the compiler
+    volatile uint32_t product;
+    unsigned char i;
+
+    hal_init_clock();
+    for (i = 0; i < CB_COUNT; i++) {
+        cb_cycles[i] = CB_NONE;
+    }
+    init_pwm(199);
+    init_ir();
+    init_serial();
+    INTCONbits.GIEH = 0; // Enabled by each interrupt benchmark only
+    RCONbits.IPEN = 1; // Priorities, as init_interrupt()
+
+    cb_start();
+    cb_stop(CB_EMPTY);
+
+    motor.power = 75;
+    motor.direction = 0;
+    motor.channel = 0;
+    cb_start();
+    set_motor_pwm(&motor);
+    cb_stop(CB_SET_MOTOR_PWM);
+
+    cb_start();
+    ref_itoa_5(54321, buffer);
+    cb_stop(CB_ITOA_5);
+
+    cb_start();
+    fmt_dec(buffer, 54321, 5);
+    cb_stop(CB_FMT_DEC);
+
+    cb_start();
+    fmt_sdec(buffer, -12345, 5);
+    cb_stop(CB_FMT_SDEC);
+
+    cb_start();
+    fmt_hex(buffer, 0xBEEF, 4);
+    cb_stop(CB_FMT_HEX);
+
+    cb_start();
+    product = (unsigned long) a * b;
+    cb_stop(CB_LMUL);
+
+    cb_start();
+    product = fix_mul16(a, b);
+    cb_stop(CB_FIX_MUL16);
+
+    cb_start();
+    fix_mul_q8(-12345, FIX_Q8(1.25));
+    cb_stop(CB_FIX_MUL_Q8);
+
+    cb_start();
+    fix_ratio(40000, 30000);
+    cb_stop(CB_FIX_RATIO);
+
+    cb_start();
+    fix_atan2(-12345, 23456);
+    cb_stop(CB_FIX_ATAN2);
+
+    cb_start();
+    ir_bearing(49500, 49200);
+    cb_stop(CB_IR_BEARING);
+
+    cap_init();
+    bcn_pulse(0, 955000, 1000000);
+    bcn_pulse(0, 1205000, 1250000);
+    cb_start();
+    cap_edge(0, hal_timer_us(), 0);
+    cb_stop(CB_CAP_EDGE);
+
+    cb_start();
+    bcn_pulse(0, 1455000, 1500000);
+    cb_stop(CB_BCN_DETECT);
+
+    cb_start();
+    bcn_pulse(0, 1705000, 1750000);
+    cb_stop(CB_BCN_PREDICT);
+
+    cal.gain[0] = 320;
+    cal.offset[0] = -100;
+    cb_start();
+    ir_normalise(&cal, 0, 12345);
+    cb_stop(CB_IR_NORMALISE);
+
+    cb_start();
+    ir_filter(0);
+    cb_stop(CB_IR_FILTER);
+
+    cb_start();
+    crc8(0, 0x5A);
+    cb_stop(CB_CRC8);
+
+    // Tick flag set by hand. TMR0L written by hal_tick_clear() is within
+    // the rounding of cb_stop()
+    INTCONbits.TMR0IE = 1;
+    INTCON2bits.TMR0IP = 0;
+    INTCONbits.GIEL = 1;
+    INTCONbits.GIEH = 1;
+    cb_start();
+    INTCONbits.TMR0IF = 1;
+    cb_stop(CB_LP_TIMER);
+    INTCONbits.GIEH = 0;
+    INTCONbits.TMR0IE = 0;
+
+    // Button flag set by hand, in STANDBY
+    G_run = 0;
+    INTCONbits.INT0IE = 1;
+    INTCONbits.GIEH = 1;
+    cb_start();
+    INTCONbits.INT0IF = 1;
+    cb_stop(CB_HP_RFID_BUTTON);
+    INTCONbits.GIEH = 0;
+    INTCONbits.INT0IE = 0;
+
+    // Packet queued for tune_tx(), which the low priority interrupt calls
+    // while TXIF is set. The time on the wire is included
+    for (i = 0; i < CB_PACKET_SIZE; i++) {
+        tune_tx_buf[i] = CB_PACKET[i];
+    }
+    tune_tx_out = 0;
+    tune_tx_in = CB_PACKET_SIZE;
+    hal_uart_tx_irq_low();
+    hal_uart_tx_irq(1);
+    INTCONbits.PEIE = 1;
+    INTCONbits.GIEL = 1;
+    INTCONbits.GIEH = 1;
+    cb_start();
+    get_packet_serial(packet);
+    cb_stop(CB_GET_PACKET_SERIAL);
+    INTCONbits.GIEH = 0;
+
+    cb_halt();
+}
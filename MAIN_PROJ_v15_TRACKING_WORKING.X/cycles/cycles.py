@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+# =============================================================================
+#  Assignment: Explosive Ordinance Disposal
+#
+#  Author: Lim Siew Han & Justin Kek
+#  Language: Python 3
+#  Tools: XC8 (v2.00) and gpsim (0.31 or later)
+#  Microchip: PIC18F4331 (simulated by gpsim)
+#
+#  School: Imperial College London
+#  Department: Mechanical Engineering
+#  Module: Embedded C for Microcontrollers
+#  Class: MEng Graduating 2021
+# -----------------------------------------------------------------------------
+#  Description: Instruction cycle benchmark of the firmware hot paths (see
+#               "make cycles"). Builds cycles.c with the firmware sources
+#               using XC8, runs the image in gpsim until cb_halt(), reads
+#               cb_cycles[] from the simulated RAM and prints the cycles of
+#               each call, less the timer overhead, with the change since
+#               the last entry of the history file, to which the results
+#               are then appended:
+#                   cycles.py [--cc xc8-cc] [--gpsim gpsim]
+#                             [--history cycles/history.csv] [--no-history]
+#               Run from the project directory. The exit status is 1 if the
+#               image cannot be built or run, or a benchmark is not reached.
+# =============================================================================
+import argparse
+import csv
+import datetime
+import os
+import re
+import subprocess
+import sys
+
+CPU = "18F4331"
+FIRMWARE = ["main.c", "functions.c", "dc_motor_funct.c", "lcd_funct.c",
+            "rotate_funct.c", "eeprom_funct.c", "record_funct.c",
+            "tune_funct.c", "replay_funct.c", "profile_funct.c",
+            "supervise_funct.c", "trace_funct.c", "latency_funct.c",
+            "fmt_funct.c", "fix_funct.c", "bearing_funct.c", "beacon_funct.c",
+            "capture_funct.c", "adc_funct.c", "battery_funct.c",
+            "hal_pic.c"]
+# Optional subsystems with hot paths benchmarked: the packet is sent by the
+# reply queue of the tuning protocol, and the capture edges are tracked
+OPTIONS = ["-DTUNE", "-DBEACON_TRACK"]
+BENCH = "cycles/cycles.c"
+OUT_DIR = "build/cycles"
+CB_NONE = 0xFFFFFFFF  # Benchmark not reached, see cycles.c
+LIMIT = 100000000  # Instruction cycles before gpsim is stopped regardless
+MIPS = 2  # 8 MHz clock, 4 clocks per instruction cycle
+
+
+def bench_names():
+    """Names of the benchmarks, in order, from the CB_ enum of cycles.c."""
+    with open(BENCH) as f:
+        text = f.read()
+    body = re.search(r"enum\s*\{(.*?)\}", text, re.S).group(1)
+    names = re.findall(r"^\s*CB_([A-Z0-9_]+)", body, re.M)
+    return [n.lower() for n in names if n != "COUNT"]
+
+
+def build(cc):
+    """Compiles every source to a p-code file and links them, main.c with
+    main() renamed, such that cycles.c provides main(). Returns the paths of
+    the hex and symbol files."""
+    os.makedirs(OUT_DIR, exist_ok=True)
+    objects = []
+    for src in FIRMWARE + [BENCH]:
+        obj = os.path.join(OUT_DIR, os.path.basename(src)[:-2] + ".p1")
+        cmd = [cc, "-mcpu=" + CPU, "-O1", "-I."] + OPTIONS + ["-c", "-o", obj, src]
+        if src == "main.c":
+            cmd.insert(1, "-Dmain=fw_main")
+        subprocess.run(cmd, check=True)
+        objects.append(obj)
+    elf = os.path.join(OUT_DIR, "cycles.elf")
+    subprocess.run([cc, "-mcpu=" + CPU, "-O1", "-o", elf] + objects, check=True)
+    return elf[:-4] + ".hex", elf[:-4] + ".sym"
+
+
+def symbol(sym, name):
+    """Address of a C symbol (with the leading underscore of XC8) from the
+    symbol file."""
+    with open(sym) as f:
+        for line in f:
+            fields = line.split()
+            if (len(fields) >= 2) and (fields[0] == "_" + name):
+                return int(fields[1], 16)
+    raise KeyError("%s not in %s" % (name, sym))
+
+
+def simulate(gpsim, hexfile, halt, first, size):
+    """Runs the image in gpsim until cb_halt(), with TX looped back to RX
+    for the packet of get_packet_serial(), and returns size bytes of RAM
+    from address first, None for any not shown by the register dump."""
+    script = os.path.join(OUT_DIR, "cycles.stc")
+    with open(script, "w") as f:
+        f.write("node cb_loop\n")
+        f.write("attach cb_loop portc6 portc7\n")
+        f.write("break e 0x%x\n" % halt)
+        f.write("break c %d\n" % LIMIT)
+        f.write("run\n")
+        f.write("dump r\n")
+        f.write("quit\n")
+    out = subprocess.run([gpsim, "-i", "-p", "p" + CPU.lower(), "-c", script, hexfile],
+                         stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                         universal_newlines=True).stdout
+    with open(os.path.join(OUT_DIR, "gpsim.log"), "w") as f:
+        f.write(out)
+    # Rows of the dump: address, then 16 bytes in hex ("--" if unimplemented)
+    ram = {}
+    for line in out.splitlines():
+        m = re.match(r"^\s*([0-9a-fA-F]{2,4}):?((?:\s+(?:[0-9a-fA-F]{2}|--)){8,16})\s*$", line)
+        if m is None:
+            continue
+        base = int(m.group(1), 16)
+        for i, byte in enumerate(m.group(2).split()):
+            if byte != "--":
+                ram[base + i] = int(byte, 16)
+    return [ram.get(a) for a in range(first, first + size)]
+
+
+def revision():
+    """Short hash of the checked out commit, with + if modified."""
+    try:
+        rev = subprocess.run(["git", "rev-parse", "--short", "HEAD"], stdout=subprocess.PIPE,
+                             universal_newlines=True, check=True).stdout.strip()
+        dirty = subprocess.run(["git", "status", "--porcelain", "--untracked-files=no", "."],
+                               stdout=subprocess.PIPE, universal_newlines=True).stdout.strip()
+        return rev + ("+" if dirty else "")
+    except (OSError, subprocess.CalledProcessError):
+        return "unknown"
+
+
+def last_results(history):
+    """Cycles of each benchmark in the last run of the history file."""
+    last = {}
+    if os.path.exists(history):
+        with open(history) as f:
+            for row in csv.DictReader(f):
+                last[row["name"]] = int(row["cycles"])
+    return last
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Instruction cycles of the firmware hot paths")
+    parser.add_argument("--cc", default="xc8-cc")
+    parser.add_argument("--gpsim", default="gpsim")
+    parser.add_argument("--history", default="cycles/history.csv")
+    parser.add_argument("--no-history", action="store_true")
+    args = parser.parse_args()
+
+    names = bench_names()
+    try:
+        hexfile, sym = build(args.cc)
+        ram = simulate(args.gpsim, hexfile, symbol(sym, "cb_halt"), symbol(sym, "cb_cycles"),
+                       4 * len(names))
+    except (OSError, subprocess.CalledProcessError, KeyError) as e:
+        print("cycles: %s" % e, file=sys.stderr)
+        return 1
+    if None in ram:
+        print("cycles: cb_cycles not found in the gpsim output, see %s/gpsim.log" % OUT_DIR,
+              file=sys.stderr)
+        return 1
+
+    counts = [ram[4 * i] | (ram[4 * i + 1] << 8) | (ram[4 * i + 2] << 16) | (ram[4 * i + 3] << 24)
+              for i in range(len(names))]
+    overhead = counts[0]
+    last = last_results(args.history)
+    results = []
+    failed = 0
+    print("%-20s %10s %12s %10s" % ("benchmark", "cycles", "us", "change"))
+    for name, count in zip(names[1:], counts[1:]):
+        if count == CB_NONE:
+            print("%-20s %10s" % (name, "not reached"))
+            failed = 1
+            continue
+        cycles = count - overhead
+        change = "" if name not in last else "%+d" % (cycles - last[name])
+        print("%-20s %10d %12.1f %10s" % (name, cycles, cycles / MIPS, change))
+        results.append((name, cycles))
+    print("(timer overhead of %d cycles subtracted)" % overhead)
+
+    if not args.no_history:
+        new = not os.path.exists(args.history)
+        with open(args.history, "a", newline="") as f:
+            out = csv.writer(f, lineterminator="\n")
+            if new:
+                out.writerow(["date", "revision", "name", "cycles"])
+            date = datetime.datetime.now().strftime("%Y-%m-%d %H:%M")
+            rev = revision()
+            for name, cycles in results:
+                out.writerow([date, rev, name, cycles])
+    return failed
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -25,90 +25,139 @@
  |               DC_motor, where a detailed description of its contents can be    
  |               found in the header file dc_motor_struct.h
  +===========================================================================*/
-#include <xc.h>
-#include "functions.h"
+#include "hal.h"
 #include "dc_motor_struct.h"
-#define _XTAL_FREQ 8000000 // For an 8MHz clock frequency
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "trace_funct.h"
+#include "fix_funct.h"
+#include "battery_funct.h"
+
+// Registers of each motor, see main.c for the wiring
+const struct MotorPort motor_ports[2] = {
+    {hal_pwm_duty_low(0), hal_pwm_duty_high(0), 0}, // Pin RB0/PWM0
+    {hal_pwm_duty_low(1), hal_pwm_duty_high(1), 2} // Pin RB2/PWM2
+};
+
+// Duty at BAT_NOMINAL_MV and direction last set on each channel, and the
+// duty scale they were written with, for motor_refresh()
+unsigned char motor_duty[2] = {0, 0};
+unsigned char motor_dir[2] = {0, 0};
+unsigned char motor_gain[2] = {BAT_GAIN_ONE, BAT_GAIN_ONE};
 
 /*=============================================================================
- |  Function init_pwm
+ |  Function set_motor_pwm
  |
- |  Purpose: init_pwm initializes the PIC18F4331's PWM module, on the 
- |           assumption that pins B0 and B2 are being used as output for a 
- |           PWM duty cycle   
+ |  Purpose: set_motor_pwm sets the PWM output from the values in the motor    
+ |           structure. This function designed based on the example given in
+ |           the ECM Lab notes in chapter 5
  |
  |  Parameters: 
- |      PWMperiod (int) - An integer value ranging from 0 - 100
+ |      *m (struct DC_motor) - Address of an instance of the DC_motor structure
  |
  |  Returns: Nothing (Void function)
  |
+ |  Comments: While the emergency stop is latched (G_estop, see hp_rfid()), 
+ |            the outputs are left as MOTOR_CUT() set them, whatever the
+ |            structure holds, so a ramp still running in the main program
+ |            cannot restart the motors (see motor_write()). The duty cycle
+ |            is power * PWM_PERIOD / 100 for powers 0 - 100, found by one
+ |            8 x 8 bit multiplication (see PWM_DUTY_Q7), then scaled to the
+ |            battery, such that each power gives the same motor voltage
+ |            whatever the charge.
+ |
 +============================================================================*/
 
-void init_pwm(int PWMperiod) {
-    // Motor PWM frequency 10kHz = 0.1ms period
-    // Set direction pins to output
-    TRISBbits.RB0 = 0;
-    TRISBbits.RB2 = 0;
-    // Set direction pins to low for PWMon control (25% = 25%)
-    LATBbits.LATB0 = 0;
-    LATBbits.LATB2 = 0;
-
-    // PWM settings
-    PTCON0 = 0b00000000; // free running mode, 1:1 prescaler = 0.5 us
-    PTCON1 = 0b10000000; // enable PWM timer
-    PWMCON0 = 0b01101111; // PWM 1 and 3 enabled
-    PWMCON1 = 0x00; // special features, all 0 (default)
-
-    /* PTPER max = 199 (12-bit res), set PS so that PTPER is as large 
-     * as possible for max resolution
-     * Set PWM period to 199 for Tpwm = 0.1 ms */
-
-    PTPERL = 0b11000111; // base PWM period low byte
-    PTPERH = 0b0; // base PWM period high byte
+void set_motor_pwm(struct DC_motor *m) {
+    //calculate duty cycle (value between 0 and PWM_PERIOD)
+    motor_write(m->channel, m->direction, G_estop ? 0 : fix_mul8(m->power, PWM_DUTY_Q7) >> 7);
 }
 
 /*=============================================================================
- |  Function set_motor_pwm
+ |  Function motor_write
  |
- |  Purpose: set_motor_pwm sets the PWM output from the values in the motor    
- |           structure. This function designed based on the example given in
- |           the ECM Lab notes in chapter 5
+ |  Purpose: motor_write scales a duty cycle to the battery (see bat_duty())
+ |           and writes it and the direction to the registers of a channel
  |
  |  Parameters: 
- |      *m (struct DC_motor) - Address of an instance of the DC_motor structure
+ |      channel (unsigned char) - PWM channel, 0 or 1
+ |      direction (unsigned char) - 1 forward, 0 backwards
+ |      duty (unsigned char) - Duty at BAT_NOMINAL_MV, 0 - PWM_PERIOD
  |
  |  Returns: Nothing (Void function)
  |
+ |  Comments: The registers are written with the interrupts off, and only if
+ |            G_estop is still clear, as a cut by hp_rfid() between the
+ |            caller's check and the writes would otherwise be undone.
 +============================================================================*/
 
-void set_motor_pwm(struct DC_motor *m) {
+void motor_write(unsigned char channel, unsigned char direction, unsigned char duty) {
     int PWMduty; //tmp variable to store PWM duty cycle
+    const struct MotorPort *port = &motor_ports[channel];
 
-    //calculate duty cycle (value between 0 and PWMperiod)
-    PWMduty = (m->power * m->PWMperiod) / 100;
+    motor_duty[channel] = duty;
+    motor_dir[channel] = direction;
+    PWMduty = bat_duty(channel, duty); // compensates battery voltage
+    motor_gain[channel] = bat_gain;
 
-    if (m->direction) //if forward direction
+    if (direction) //if forward direction
     {
         //need to invert duty cycle as direction is high (100% power is a duty cycle of 0)
-        //set dir_pin high in LATB
-        LATB = LATB | (1 << (m->dir_pin));
-        PWMduty = m->PWMperiod - PWMduty;
-    } else //if reverse direction
-    {
-        //set dir_pin low in LATB
-        LATB = LATB & (~(1 << (m->dir_pin)));
+        PWMduty = PWM_PERIOD - PWMduty;
     }
 
-    //write duty cycle value to appropriate registers
-    *(m->dutyLowByte) = PWMduty << 2;
-    *(m->dutyHighByte) = PWMduty >> 6;
+    hal_irq_off(); // hp_rfid() cannot cut the motors until written
+    if (G_estop == 0) {
+        //set dir_pin high in LATB if forward, else low
+        hal_motor_dir(port->dir_pin, direction);
+
+        //write duty cycle value to appropriate registers
+        *(port->dutyLowByte) = PWMduty << 2;
+        *(port->dutyHighByte) = PWMduty >> 6;
+    }
+    hal_irq_on();
+}
+
+/*=============================================================================
+ |  Function motor_refresh
+ |
+ |  Purpose: motor_refresh writes both channels again with the last duty set,
+ |           if the duty scale of the battery has changed since and both
+ |           motors drive the same way
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by the delays of the main program (see delay_ms()), as
+ |            the motors hold their power between ramps, for seconds at a
+ |            time, while the supply sags under their load. Turns on the
+ |            spot keep the duty of their ramp, as their step angles (see
+ |            orientate() and rotate_by()) were set with it.
++============================================================================*/
+
+void motor_refresh(void) {
+    unsigned char channel;
+
+    bat_poll();
+    if (motor_dir[0] != motor_dir[1]) {
+        return; // Turning on the spot
+    }
+    for (channel = 0; channel < 2; channel++) {
+        if (motor_gain[channel] != bat_gain) {
+            motor_write(channel, motor_dir[channel], motor_duty[channel]);
+        }
+    }
 }
 
 /*=============================================================================
  |  Function full_speed
  |
- |  Purpose: full_speed sets the power of two DC_motor structures to 90 (out
- |           of 100), and gradually increases the PWM output to the power value
+ |  Purpose: full_speed sets the power of two DC_motor structures to the 
+ |           cruise power (90 out of 100 by default, see eeprom_funct.h), and
+ |           gradually increases the PWM output to the power value
  |           to avoid slip caused by abrupt speed changes. A direction argument 
  |           allows either forward or reverse movement.
  |
@@ -125,6 +174,7 @@ void set_motor_pwm(struct DC_motor *m) {
 +============================================================================*/
 
 void full_speed(struct DC_motor *mL, struct DC_motor *mR, unsigned char direction) {
+    TRACE_MAIN(TR_MOTOR | TR_M_FULL, (direction << 8) | G_params.cruise_power);
     // 0: forwards, 1: backwards
     mL->direction = direction;
     mR->direction = direction;
@@ -138,7 +188,7 @@ void full_speed(struct DC_motor *mL, struct DC_motor *mR, unsigned char directio
     }
 
     // not to max power to prevent slip
-    for (mR->power; (mR->power) < 90; mR->power++) {
+    for (; (mR->power) < G_params.cruise_power; mR->power++) {
         mL->power = mR->power;
         set_motor_pwm(mL);
         set_motor_pwm(mR);
@@ -172,16 +222,17 @@ void full_speed(struct DC_motor *mL, struct DC_motor *mR, unsigned char directio
 +============================================================================*/
 
 void veer_left(struct DC_motor *mL, struct DC_motor *mR, unsigned char direction) {
+    TRACE_MAIN(TR_MOTOR | TR_M_VEER_LEFT, (direction << 8) | G_params.cruise_power);
     // 0: forwards, 1: backwards
     mL->direction = direction;
     mR->direction = direction;
     // Equate both speeds to be equal first 
     mL->power = mR->power;
 
-    mL->power = 90;
-    mR->power = 90;
+    mL->power = G_params.cruise_power;
+    mR->power = G_params.cruise_power;
 
-    for (mR->power; (mR->power) > (mL->power - 45); mR->power--) {
+    for (; (mR->power) > (mL->power - G_params.veer_drop); mR->power--) {
         //increase motor power until 100
         set_motor_pwm(mL);
         set_motor_pwm(mR);
@@ -215,16 +266,17 @@ void veer_left(struct DC_motor *mL, struct DC_motor *mR, unsigned char direction
 +============================================================================*/
 
 void veer_right(struct DC_motor *mL, struct DC_motor *mR, unsigned char direction) {
+    TRACE_MAIN(TR_MOTOR | TR_M_VEER_RIGHT, (direction << 8) | G_params.cruise_power);
     // 0: forwards, 1: backwards
     mL->direction = direction;
     mR->direction = direction;
     // Equate both speeds to be equal first 
     mL->power = mR->power;
 
-    mL->power = 90;
-    mR->power = 90;
+    mL->power = G_params.cruise_power;
+    mR->power = G_params.cruise_power;
 
-    for (mL->power; (mL->power) > (mR->power - 45); mL->power--) {
+    for (; (mL->power) > (mR->power - G_params.veer_drop); mL->power--) {
         //increase motor power until 100
         set_motor_pwm(mL);
         set_motor_pwm(mR);
@@ -247,13 +299,19 @@ void veer_right(struct DC_motor *mL, struct DC_motor *mR, unsigned char directio
  |
  |  Returns: Nothing (Void function)
  |
+ |  Comments: No ramp is needed once the emergency stop has cut the motors.
+ |
 +============================================================================*/
 
 void stop_all(struct DC_motor *mL, struct DC_motor *mR) {
+    TRACE_MAIN(TR_MOTOR | TR_M_STOP, 0);
+    if (G_estop) {
+        mR->power = 0;
+    }
     // Equate both speeds to be equal first 
     mL->power = mR->power;
 
-    for (mR->power; (mR->power) > 0; mR->power--) {
+    for (; (mR->power) > 0; mR->power--) {
         //decrease motor power until 0
         mL->power = mR->power;
         set_motor_pwm(mL);
@@ -263,47 +321,48 @@ void stop_all(struct DC_motor *mL, struct DC_motor *mR) {
 }
 
 /*=============================================================================
- |  Function turn_left
+ |  Function turn
  |
- |  Purpose: turn_left first invokes the stop_all function to set PWM output to
- |           0, then sets the direction for the two DC_motor structures to be 
- |           opposite and power to 70 (out of 100), gradually increasing the
- |           the PWM to reflect that power
+ |  Purpose: turn first invokes the stop_all function to set PWM output to 0,
+ |           then sets the direction for the two DC_motor structures to be
+ |           opposite and gradually increases the PWM output to the target
+ |           power, turning the vehicle on the spot
  |
  |  Parameters: 
  |      *mL (struct DC_motor) - Address of an instance of the DC_motor 
  |                              structure
- |      *mL (struct DC_motor) - Address of an instance of the DC_motor 
+ |      *mR (struct DC_motor) - Address of an instance of the DC_motor 
  |                              structure
+ |      direction (unsigned char) - 0 (left), 1 (right), as per turn_direction
+ |                                  of the Control structure
+ |      target (char) - Power to ramp up to, which accepts values 0 - 100
  |
  |  Returns: Nothing (Void function)
  |
- |  Comments: Similarly to veer_left and veer_right, the turn_left and 
- |            turn_right functions should be integrated into a single function
- |            in future iterations for memory optimization
+ |  Comments: The ramp takes 2 ms per unit of power, which the rotation model
+ |            in rotate_funct.c relies on when planning a turn.
  |
 +============================================================================*/
 
-void turn_left(struct DC_motor *mL, struct DC_motor *mR) {
+void turn(struct DC_motor *mL, struct DC_motor *mR, unsigned char direction, char target) {
+    TRACE_MAIN(TR_MOTOR | TR_M_TURN, (direction << 8) | target);
     stop_all(mL, mR);
-    mL->direction = 0;
-    mR->direction = 1;
-    for (mL->power; (mL->power) < 70; mL->power++) {
-        //increase motorL power until 60
+    mL->direction = direction;
+    mR->direction = !direction;
+    for (; (mL->power) < target; mL->power++) {
+        //increase motor power until target
         mR->power = mL->power;
         set_motor_pwm(mL);
         set_motor_pwm(mR);
-        __delay_ms(2); //delay of 1 ms
+        __delay_ms(2); //delay of 2 ms
     }
 }
 
 /*=============================================================================
- |  Function turn_right
+ |  Function turn_left
  |
- |  Purpose: turn_right first invokes the stop_all function to set PWM output to
- |           0, then sets the direction for the two DC_motor structures to be 
- |           opposite and power to 70 (out of 100), gradually increasing the
- |           the PWM to reflect that power
+ |  Purpose: turn_left turns the vehicle left on the spot by invoking turn with
+ |           the turn power (70 out of 100 by default, see eeprom_funct.h)
  |
  |  Parameters: 
  |      *mL (struct DC_motor) - Address of an instance of the DC_motor 
@@ -313,22 +372,28 @@ void turn_left(struct DC_motor *mL, struct DC_motor *mR) {
  |
  |  Returns: Nothing (Void function)
  |
- |  Comments: Similarly to veer_left and veer_right, the turn_left and 
- |            turn_right functions should be integrated into a single function
- |            in future iterations for memory optimization
++============================================================================*/
+
+void turn_left(struct DC_motor *mL, struct DC_motor *mR) {
+    turn(mL, mR, 0, G_params.turn_power);
+}
+
+/*=============================================================================
+ |  Function turn_right
+ |
+ |  Purpose: turn_right turns the vehicle right on the spot by invoking turn 
+ |           with the turn power (70 out of 100 by default, see eeprom_funct.h)
+ |
+ |  Parameters: 
+ |      *mL (struct DC_motor) - Address of an instance of the DC_motor 
+ |                              structure
+ |      *mL (struct DC_motor) - Address of an instance of the DC_motor 
+ |                              structure
+ |
+ |  Returns: Nothing (Void function)
  |
 +============================================================================*/
 
 void turn_right(struct DC_motor *mL, struct DC_motor *mR) {
-    stop_all(mL, mR);
-    mL->direction = 1;
-    mR->direction = 0;
-    for (mL->power; (mL->power) < 70; mL->power++) {
-        //increase motorL power until 60
-        mR->power = mL->power;
-        set_motor_pwm(mL);
-        set_motor_pwm(mR);
-        __delay_ms(2); //delay of 1 ms
-    }
-
+    turn(mL, mR, 1, G_params.turn_power);
 }
@@ -30,6 +30,36 @@
 #ifndef _DC_MOTOR_H
 #define _DC_MOTOR_H
 
+#define PWM_PERIOD 199 // Base period of the PWM cycle of both motors
+
+// Duty cycle per unit of power in Q7 (see set_motor_pwm()), rounded up such
+// that a power of 100 gives PWM_PERIOD. Held in 8 bits for a single hardware
+// multiplication
+#define PWM_DUTY_Q7 ((PWM_PERIOD * 128 + 99) / 100)
+#if PWM_DUTY_Q7 > 255
+#error PWM_PERIOD too long for PWM_DUTY_Q7
+#endif
+
+/*=============================================================================
+ |  Structure MotorPort
+ |
+ |  Purpose: Registers of one PWM channel, constant and so held in program
+ |           memory (see motor_ports in dc_motor_funct.c) 
+ |
+ |  Parameters: 
+ |      *dutyLowByte (unsigned char) - Address of the PWM duty low byte
+ |      *dutyHighByte (unsigned char) - Address of the PWM duty high byte
+ |      dir_pin (unsigned char) - PORTB pin of the motor direction
++============================================================================*/
+
+struct MotorPort {
+    unsigned char *dutyLowByte;
+    unsigned char *dutyHighByte;
+    unsigned char dir_pin;
+};
+
+extern const struct MotorPort motor_ports[2];
+
 /*=============================================================================
  |  Structure DC_motor
  |
@@ -38,32 +68,36 @@
  |
  |  Parameters: 
  |      power (char) - The motor power, which accepts values from 0 - 100
- |      direction (char) - A flag where 1 indicates forward and 0 backwards
- |      *dutyLowByte (unsigned char) - Address of the PWM duty low byte
- |      *dutyHighByte (unsigned char) - Address of the PWM duty high byte
- |      dir_pin (char) - A flag that indicates the PORTB direction
- |      PWMperiod (int) - The base period of the PWM cycle
+ |      direction (1 bit) - A flag where 1 indicates forward and 0 backwards
+ |      channel (1 bit) - PWM channel 0 or 1, the index of the motor in
+ |                        motor_ports
  |
- |  Comments: The direction and dir_pin are flags, and could be lumped into a 
- |            single variable and bitwise operations used to determine status,
- |            for greater memory efficiency. Future revisions could 
- |            alternatively consider encapsulating direction as the sign of 
- |            the power variable.
+ |  Comments: Two bytes per motor. The registers, direction pin and PWM
+ |            period are the same for every RUN, so are not stored here.
+ |            Future revisions could consider encapsulating direction as the
+ |            sign of the power variable.
  |
 +============================================================================*/
 
 struct DC_motor { 
     char power;         
-    char direction;    
-    unsigned char *dutyLowByte; 
-    unsigned char *dutyHighByte; 
-    char dir_pin; 
-    int PWMperiod;
+    unsigned direction : 1;
+    unsigned channel : 1;
 };
 
+// Stops both motors at once, without the ramp of stop_all(), for the 
+// interrupts: direction pins low and zero duty (with the direction pin high,
+// zero duty is full power). Pins and channels as set up in main.c
+#define MOTOR_CUT() (hal_motor_dir(0, 0), hal_motor_dir(2, 0), \
+        *hal_pwm_duty_low(0) = 0, *hal_pwm_duty_high(0) = 0, \
+        *hal_pwm_duty_low(1) = 0, *hal_pwm_duty_high(1) = 0)
+
 void init_pwm(int PWMperiod); 
 void set_motor_pwm(struct DC_motor *m);
+void motor_write(unsigned char channel, unsigned char direction, unsigned char duty);
+void motor_refresh(void);
 void stop_all(struct DC_motor *mL, struct DC_motor *mR);
+void turn(struct DC_motor *mL, struct DC_motor *mR, unsigned char direction, char target);
 void turn_left(struct DC_motor *mL, struct DC_motor *mR);
 void turn_right(struct DC_motor *mL, struct DC_motor *mR);
 void full_speed(struct DC_motor *mL, struct DC_motor *mR, unsigned char direction);
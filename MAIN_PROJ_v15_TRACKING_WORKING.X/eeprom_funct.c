@@ -0,0 +1,368 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the data EEPROM and the
+ |               parameter store kept in it. Parameters are stored in two
+ |               alternating slots, each with a version, a sequence number
+ |               and a CRC, such that an interrupted write never loses the
+ |               previous block. The description of the struct Params can be
+ |               found on the header file eeprom_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include <stddef.h>
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "lcd_funct.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "fmt_funct.h"
+
+// Compile error if Params outgrows a slot (version, sequence and CRC bytes)
+typedef char par_fits_slot[(sizeof (struct Params) + 3 <= EE_SLOT_SIZE) ? 1 : -1];
+
+// Parameters editable from the standby menu, in the order they are shown
+const struct ParamInfo par_info[PAR_COUNT] = {
+    {TEXT("GAIN"), offsetof(struct Params, gain), 0, 5, 0, 255},
+    {TEXT("BRG THR"), offsetof(struct Params, bearing_thr), 1, 5, 0, 200},
+    {TEXT("IR MIN"), offsetof(struct Params, ir_min), 1, 500, 30000, 60000},
+    {TEXT("CRUISE"), offsetof(struct Params, cruise_power), 0, 5, 40, 100},
+    {TEXT("TURN"), offsetof(struct Params, turn_power), 0, 5, 30, 100},
+    {TEXT("VEER"), offsetof(struct Params, veer_drop), 0, 5, 0, 90},
+    {TEXT("ACT MS"), offsetof(struct Params, action_ms), 1, 50, 100, 2000},
+    {TEXT("RUN S"), offsetof(struct Params, run_s), 0, 1, 0, 20},
+};
+
+unsigned char par_slot = EE_SLOT_A; // Slot G_params was loaded from
+unsigned char par_seq = 0; // Sequence number of that slot
+
+/*=============================================================================
+ |  Function ee_read
+ |
+ |  Purpose: ee_read returns a byte from the data EEPROM
+ |
+ |  Parameters:
+ |      address (unsigned char) - Address of the byte, 0 - 255
+ |
+ |  Returns:
+ |      Unsigned char stored at the address
++============================================================================*/
+
+unsigned char ee_read(unsigned char address) {
+    unsigned char data;
+    hal_irq_low_off(); // Hold off recorder, see rec_service()
+    while (hal_ee_busy()); // Wait for any write to complete
+    data = hal_ee_read(address);
+    hal_irq_low_on();
+    return data;
+}
+
+/*=============================================================================
+ |  Function ee_write
+ |
+ |  Purpose: ee_write writes a byte to the data EEPROM, skipping the write if
+ |           the byte already holds that value
+ |
+ |  Parameters:
+ |      address (unsigned char) - Address of the byte, 0 - 255
+ |      data (unsigned char) - Value to be written
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: A write takes approximately 4 ms, during which this function
+ |            returns but the next access waits. Interrupts are disabled for
+ |            the required 0x55, 0xAA unlock sequence. Skipping unchanged bytes
+ |            saves both time and EEPROM wear. Low priority interrupts are
+ |            held off throughout, as the mission recorder writes from them.
++============================================================================*/
+
+void ee_write(unsigned char address, unsigned char data) {
+    if (ee_read(address) == data) {
+        return; // Already holds value
+    }
+    hal_irq_low_off(); // Hold off recorder, see rec_service()
+    while (hal_ee_busy()); // Wait for recorder write to complete
+    hal_ee_write(address, data); // Write in progress continues on return
+    hal_irq_low_on();
+}
+
+/*=============================================================================
+ |  Function crc8
+ |
+ |  Purpose: crc8 updates a CRC-8 (polynomial 0x07) with one byte
+ |
+ |  Parameters:
+ |      crc (unsigned char) - CRC of the preceding bytes, 0 for the first
+ |      data (unsigned char) - Next byte
+ |
+ |  Returns:
+ |      Unsigned char of the updated CRC
++============================================================================*/
+
+unsigned char crc8(unsigned char crc, unsigned char data) {
+    unsigned char i;
+    crc ^= data;
+    for (i = 0; i < 8; i++) {
+        if (crc & 0x80) {
+            crc = (crc << 1) ^ 0x07;
+        } else {
+            crc <<= 1;
+        }
+    }
+    return crc;
+}
+
+/*=============================================================================
+ |  Function params_default
+ |
+ |  Purpose: params_default sets G_params to the compiled defaults, with the
+ |           turn rates and IR sensors not calibrated
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void params_default(void) {
+    G_params.gain = PAR_GAIN;
+    G_params.bearing_thr = PAR_BEARING_THR;
+    G_params.ir_min = PAR_IR_MIN;
+    G_params.cruise_power = PAR_CRUISE_POWER;
+    G_params.turn_power = PAR_TURN_POWER;
+    G_params.veer_drop = PAR_VEER_DROP;
+    G_params.action_ms = PAR_ACTION_MS;
+    G_params.run_s = PAR_RUN_S;
+    init_rotation(&G_params.rot);
+    init_ir_cal(&G_params.cal);
+}
+
+/*=============================================================================
+ |  Function params_read_slot
+ |
+ |  Purpose: params_read_slot copies a slot into G_params, checking its CRC
+ |           in the same pass
+ |
+ |  Parameters:
+ |      slot (unsigned char) - Address of the slot, EE_SLOT_A or EE_SLOT_B
+ |
+ |  Returns:
+ |      Unsigned char of 1 if the slot is valid, 0 if not (G_params is then
+ |      partially overwritten)
++============================================================================*/
+
+unsigned char params_read_slot(unsigned char slot) {
+    unsigned char *p = (unsigned char *) &G_params;
+    unsigned char crc = 0;
+    unsigned char i;
+
+    if (ee_read(slot) != PAR_VERSION) {
+        return 0; // Written by other firmware, or blank (0xFF)
+    }
+    crc = crc8(crc, PAR_VERSION);
+    crc = crc8(crc, ee_read(slot + 1));
+    for (i = 0; i < sizeof (struct Params); i++) {
+        p[i] = ee_read(slot + 2 + i);
+        crc = crc8(crc, p[i]);
+    }
+    return crc == ee_read(slot + 2 + sizeof (struct Params));
+}
+
+/*=============================================================================
+ |  Function params_load
+ |
+ |  Purpose: params_load loads G_params from the newest valid slot of the data
+ |           EEPROM, or from the compiled defaults if neither slot is valid
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The slot with the newer sequence number is tried first, so that
+ |            normally only one slot is read. The sequence number wraps, so
+ |            the newer slot is the one ahead by less than 128.
++============================================================================*/
+
+void params_load(void) {
+    unsigned char seq_a = ee_read(EE_SLOT_A + 1);
+    unsigned char seq_b = ee_read(EE_SLOT_B + 1);
+    unsigned char first = EE_SLOT_A, second = EE_SLOT_B;
+
+    if ((signed char) (seq_b - seq_a) > 0) {
+        first = EE_SLOT_B;
+        second = EE_SLOT_A;
+    }
+    if (params_read_slot(first)) {
+        par_slot = first;
+    } else if (params_read_slot(second)) {
+        par_slot = second;
+    } else {
+        params_default();
+        par_slot = EE_SLOT_B; // First save goes to slot A
+        par_seq = 0;
+        return;
+    }
+    par_seq = ee_read(par_slot + 1);
+}
+
+/*=============================================================================
+ |  Function params_save
+ |
+ |  Purpose: params_save writes G_params to the slot not in use, with the next
+ |           sequence number, making it the slot in use
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The CRC is written last, so if power is lost part way through,
+ |            the new slot is invalid and the previous slot is loaded instead.
+ |            Alternating slots halves the writes to each byte, and ee_write
+ |            skips bytes which are unchanged. Blocks for up to ~120 ms, so
+ |            should only be called from standby.
++============================================================================*/
+
+void params_save(void) {
+    unsigned char *p = (unsigned char *) &G_params;
+    unsigned char slot = (par_slot == EE_SLOT_A) ? EE_SLOT_B : EE_SLOT_A;
+    unsigned char seq = par_seq + 1;
+    unsigned char crc = 0;
+    unsigned char i;
+
+    ee_write(slot, PAR_VERSION);
+    crc = crc8(crc, PAR_VERSION);
+    ee_write(slot + 1, seq);
+    crc = crc8(crc, seq);
+    for (i = 0; i < sizeof (struct Params); i++) {
+        ee_write(slot + 2 + i, p[i]);
+        crc = crc8(crc, p[i]);
+    }
+    ee_write(slot + 2 + sizeof (struct Params), crc);
+    while (hal_ee_busy()); // Wait for CRC to be written
+
+    par_slot = slot;
+    par_seq = seq;
+}
+
+/*=============================================================================
+ |  Function param_get
+ |
+ |  Purpose: param_get returns the value of an editable parameter
+ |
+ |  Parameters:
+ |      id (unsigned char) - Index of the parameter in par_info
+ |
+ |  Returns:
+ |      Unsigned integer of the parameter value
++============================================================================*/
+
+unsigned int param_get(unsigned char id) {
+    unsigned char *p = (unsigned char *) &G_params + par_info[id].offset;
+    if (par_info[id].wide) {
+        return *(uint16_t *) p;
+    }
+    return *p;
+}
+
+/*=============================================================================
+ |  Function param_set
+ |
+ |  Purpose: param_set sets the value of an editable parameter, limited to the
+ |           range given in par_info
+ |
+ |  Parameters:
+ |      id (unsigned char) - Index of the parameter in par_info
+ |      value (unsigned int) - New value of the parameter
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void param_set(unsigned char id, unsigned int value) {
+    unsigned char *p = (unsigned char *) &G_params + par_info[id].offset;
+    if (value < par_info[id].min) {
+        value = par_info[id].min;
+    } else if (value > par_info[id].max) {
+        value = par_info[id].max;
+    }
+    if (par_info[id].wide) {
+        *(uint16_t *) p = value;
+    } else {
+        *p = (unsigned char) value;
+    }
+}
+
+/*=============================================================================
+ |  Function edit_params
+ |
+ |  Purpose: edit_params steps through the parameters in par_info on the LCD,
+ |           showing each for 2 s. Holding the button increases the value on
+ |           display by its step every 300 ms, wrapping from the maximum to
+ |           the minimum, and restarts the 2 s. The parameters are saved to
+ |           the data EEPROM after the last one.
+ |
+ |  Parameters:
+ |      *buffer (unsigned char) - Buffer of at least IR_BUF_SIZE elements
+ |                                used to display values
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The button interrupt is disabled while editing, as for
+ |            select_mode().
++============================================================================*/
+
+void edit_params(unsigned char *buffer) {
+    unsigned char id;
+    unsigned int value;
+    unsigned int shown;
+
+    hal_button_irq(0); // Button used for editing only
+    for (id = 0; id < PAR_COUNT; id++) {
+        shown = time_ms();
+        while ((unsigned int) (time_ms() - shown) < 2000) {
+            value = param_get(id);
+            clear_lcd();
+            set_line(1);
+            lcd_string(par_info[id].label);
+            set_line(2);
+            fmt_dec(buffer, value, 5);
+            lcd_string(buffer);
+            if (hal_button() == 1) {
+                // Button held, step value
+                value += par_info[id].step;
+                if ((value > par_info[id].max) | (value < par_info[id].min)) {
+                    value = par_info[id].min;
+                }
+                param_set(id, value);
+                shown = time_ms();
+            }
+            __delay_ms(300);
+        }
+    }
+    params_save();
+    clear_lcd();
+    set_line(1);
+    lcd_string(TEXT("SAVED"));
+    hal_button_clear(); // Discard presses used for editing
+    hal_button_irq(1);
+    delay_s(1);
+}
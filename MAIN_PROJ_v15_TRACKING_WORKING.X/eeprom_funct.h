@@ -0,0 +1,158 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the data EEPROM and the
+ |               parameter store kept in it. The main interface is via the
+ |               structure Params, of which the global instance G_params holds
+ |               every tunable value. Detailed function descriptions can be
+ |               found in the eeprom_funct.c file.
+ |               Requires functions.h and rotate_funct.h to be included first.
+ +===========================================================================*/
+
+#ifndef EEPROM_FUNCT_H
+#define	EEPROM_FUNCT_H
+
+/* Data EEPROM layout (256 bytes)
+ * 0x00 - 0x1F: Parameter slot A
+ * 0x20 - 0x3F: Parameter slot B
+ * 0x40 - 0xFF: Mission recorder, see record_funct.h
+ * Each slot holds a version byte, a sequence byte, the Params structure and
+ * a CRC-8 of all preceding bytes of the slot. */
+#define EE_SLOT_A 0x00
+#define EE_SLOT_B 0x20
+#define EE_SLOT_SIZE 0x20
+
+// Increment whenever the Params structure changes, so that blocks stored by
+// older firmware are ignored rather than misread
+#define PAR_VERSION 2
+
+// Compiled defaults, used when no valid block is stored. Building with
+// PAR_TUNED defined takes them from params_tuned.h instead, as written by a
+// tuning campaign on the simulator (see sim/sweep.c)
+#ifdef PAR_TUNED
+#include "params_tuned.h"
+#endif
+#ifndef PAR_GAIN
+#define PAR_GAIN 40 // Higher gain, lower time to turn
+#endif
+#ifndef PAR_BEARING_THR
+#define PAR_BEARING_THR 27 // Lower threshold, more centred, in tenths of a degree
+#endif
+#ifndef PAR_IR_MIN
+#define PAR_IR_MIN 47000 // Ensures vehicle is not facing backwards
+#endif
+#ifndef PAR_CRUISE_POWER
+#define PAR_CRUISE_POWER 90 // Not max power to prevent slip
+#endif
+#ifndef PAR_TURN_POWER
+#define PAR_TURN_POWER 70
+#endif
+#ifndef PAR_VEER_DROP
+#define PAR_VEER_DROP 45 // Power dropped on the inside motor when veering
+#endif
+#ifndef PAR_ACTION_MS
+#define PAR_ACTION_MS 400 // Duration of each steering action
+#endif
+#ifndef PAR_RUN_S
+#define PAR_RUN_S 5 // Forward run after initial orientation
+#endif
+
+/*=============================================================================
+ |  Structure Params
+ |
+ |  Purpose: Every value which is tuned on the course, stored in the data
+ |           EEPROM so that it can be changed without recompiling
+ |
+ |  Parameters:
+ |      gain (unsigned char) - Proportional turning gain
+ |      bearing_thr (uint16_t) - Bearing in tenths of a degree within which
+ |                               vehicle can be considered to be centred
+ |                               (see ir_bearing())
+ |      ir_min (uint16_t) - Minimum value of IR intensity to be considered as
+ |                          a frontal source
+ |      cruise_power (unsigned char) - Power of full_speed() and veering
+ |      turn_power (unsigned char) - Power of turn_left() and turn_right()
+ |      veer_drop (unsigned char) - Power dropped on one motor when veering
+ |      action_ms (uint16_t) - Duration of each steering action in ms
+ |      run_s (unsigned char) - Duration of the forward run after initial
+ |                              orientation, and of the final reverse, in s
+ |      rot (struct Rotation) - Turn rates from calibrate_rotation()
+ |      cal (struct IRCal) - IR sensor calibration from calibrate_ir()
+ |
+ |  Comments: Fixed width types, so that the structure fits a slot on the
+ |            host build as well (see hal.h).
+ |
++============================================================================*/
+
+struct Params {
+    unsigned char gain;
+    uint16_t bearing_thr;
+    uint16_t ir_min;
+    unsigned char cruise_power;
+    unsigned char turn_power;
+    unsigned char veer_drop;
+    uint16_t action_ms;
+    unsigned char run_s;
+    struct Rotation rot;
+    struct IRCal cal;
+};
+
+/*=============================================================================
+ |  Structure ParamInfo
+ |
+ |  Purpose: Describes a Params member which can be edited from the standby
+ |           menu, stored in program memory as the table par_info
+ |
+ |  Parameters:
+ |      label (unsigned char) - Name displayed on the LCD
+ |      offset (unsigned char) - Offset of the member within Params
+ |      wide (unsigned char) - 1 if the member is a uint16_t, 0 if an
+ |                             unsigned char
+ |      step, min, max (unsigned int) - Increment and limits when editing
+ |
++============================================================================*/
+
+struct ParamInfo {
+    const unsigned char *label;
+    unsigned char offset;
+    unsigned char wide;
+    unsigned int step;
+    unsigned int min;
+    unsigned int max;
+};
+
+#define PAR_COUNT 8 // Number of entries in par_info
+
+extern struct Params G_params; // Defined in main.c
+extern const struct ParamInfo par_info[PAR_COUNT];
+
+unsigned char ee_read(unsigned char address);
+void ee_write(unsigned char address, unsigned char data);
+unsigned char crc8(unsigned char crc, unsigned char data);
+void params_default(void);
+void params_load(void);
+void params_save(void);
+unsigned int param_get(unsigned char id);
+void param_set(unsigned char id, unsigned int value);
+void edit_params(unsigned char *buffer);
+
+#endif
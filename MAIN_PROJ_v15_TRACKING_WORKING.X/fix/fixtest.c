@@ -0,0 +1,510 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make fixtest")
+ |  Microchip: PIC18F4331 (arithmetic only)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the main file of eod_fixtest, which checks the
+ |               fixed point arithmetic of fix_funct.c against references
+ |               computed in 64 bit integers or double precision:
+ |                   eod_fixtest
+ |               The products, fix_lerp and fix_mean must match exactly,
+ |               and the lookups must stay within the bounds documented by
+ |               fix_funct.c (FT_ constants below). Functions of one
+ |               argument are checked over every input, and functions of
+ |               two over every value of one argument against a grid of the
+ |               other (FT_STRIDE apart, plus the values either side of 0,
+ |               the byte boundaries and the ends of the range), in both
+ |               orders. Each function prints its worst error; the exit
+ |               status is 1 if any exceeds its bound, so "make fixtest"
+ |               fails.
+ +===========================================================================*/
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "fix_funct.h"
+
+#define FT_RECIP_MAX 8 // fix_recip(), counts of 2^31 / m
+#define FT_FRAC_MAX 4 // fix_frac(), counts of 32768
+#define FT_RATIO_MAX 5 // fix_ratio(), counts of 32768
+#define FT_ATAN2_MAX 0.03 // fix_atan2(), degrees
+#define FT_STRIDE 251 // Spacing of the grid of the second argument
+#define FT_GRID 600 // Values of the grid, at most
+#define FT_MEAN_RUNS 100000 // Random arrays averaged by fix_mean() per size
+
+#define FT_PI 3.14159265358979323846
+
+static uint16_t ft_grid[FT_GRID];
+static unsigned int ft_grid_n;
+static int ft_failed = 0;
+static unsigned long long ft_rng = 0x9E3779B97F4A7C15ULL;
+
+/*=============================================================================
+ |  Function ft_grid_init
+ |
+ |  Purpose: ft_grid_init fills ft_grid with the 16 bit values taken by the
+ |           second argument
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The values are unsigned; signed functions take them as int16_t,
+ |            such that 65535 is -1 and 32768 is -32768.
++============================================================================*/
+
+static void ft_grid_init(void) {
+    static const uint16_t edges[] = {
+        0, 1, 2, 3, 127, 128, 129, 255, 256, 257, 32767, 32768, 32769, 65279, 65280, 65281,
+        65533, 65534, 65535
+    };
+    unsigned long v;
+    unsigned int k;
+
+    ft_grid_n = 0;
+    for (k = 0; k < sizeof (edges) / sizeof (edges[0]); k++) {
+        ft_grid[ft_grid_n++] = edges[k];
+    }
+    for (v = 4; v < 65536UL; v += FT_STRIDE) {
+        ft_grid[ft_grid_n++] = (uint16_t) v;
+    }
+}
+
+/*=============================================================================
+ |  Function ft_random
+ |
+ |  Purpose: ft_random returns a random 16 bit value, from a fixed seed such
+ |           that runs repeat
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      uint16_t of the value
++============================================================================*/
+
+static uint16_t ft_random(void) {
+    ft_rng ^= ft_rng << 13;
+    ft_rng ^= ft_rng >> 7;
+    ft_rng ^= ft_rng << 17;
+    return (uint16_t) (ft_rng >> 32);
+}
+
+/*=============================================================================
+ |  Function ft_fail
+ |
+ |  Purpose: ft_fail counts a mismatch, printing the first of each function
+ |
+ |  Parameters:
+ |      *name (char) - Function checked
+ |      a, b, c (long) - Arguments
+ |      got, want (double) - Result and reference
+ |      *count (unsigned long) - Mismatches of the function so far
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void ft_fail(const char *name, long a, long b, long c, double got, double want,
+        unsigned long *count) {
+    if (*count == 0) {
+        printf("  %s(%ld, %ld, %ld) = %.6g, want %.6g\n", name, a, b, c, got, want);
+    }
+    (*count)++;
+}
+
+/*=============================================================================
+ |  Function ft_report
+ |
+ |  Purpose: ft_report prints the result of one function and records a
+ |           failure
+ |
+ |  Parameters:
+ |      *name (char) - Function checked
+ |      cases (unsigned long) - Inputs checked
+ |      count (unsigned long) - Mismatches, or errors over the bound
+ |      worst (double) - Largest error, 0 for an exact function
+ |      bound (double) - Largest error allowed, 0 for an exact function
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void ft_report(const char *name, unsigned long cases, unsigned long count, double worst,
+        double bound) {
+    if (bound == 0) {
+        printf("%-13s %10lu cases  exact", name, cases);
+    } else {
+        printf("%-13s %10lu cases  worst %.4f  limit %g", name, cases, worst, bound);
+    }
+    if (count != 0) {
+        printf("  FAILED %lu\n", count);
+        ft_failed = 1;
+    } else {
+        printf("\n");
+    }
+}
+
+/*=============================================================================
+ |  Function ft_signed
+ |
+ |  Purpose: ft_signed is the reference of a signed product scaled by 2^shift,
+ |           rounding the magnitude to nearest and limiting to int16_t
+ |
+ |  Parameters:
+ |      a, b (int16_t) - The numbers to be multiplied
+ |      shift (unsigned char) - 8 for Q8, 15 for Q15
+ |
+ |  Returns:
+ |      long of the product
++============================================================================*/
+
+static long ft_signed(int16_t a, int16_t b, unsigned char shift) {
+    long long p = (long long) a * b;
+    long long m = (((p < 0) ? -p : p) + (1LL << (shift - 1))) >> shift;
+
+    if (p < 0) {
+        return (m > 32768) ? -32768 : (long) -m;
+    }
+    return (m > 32767) ? 32767 : (long) m;
+}
+
+/*=============================================================================
+ |  Function ft_products
+ |
+ |  Purpose: ft_products checks fix_mul16, fix_mul_q8, fix_mul_q15 and the
+ |           saturating additions against 64 bit references
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void ft_products(void) {
+    unsigned long cases = 0;
+    unsigned long bad[6] = {0, 0, 0, 0, 0, 0};
+    unsigned long v;
+    unsigned int g;
+    unsigned char order;
+    uint16_t ua, ub;
+    int16_t a, b;
+    long want;
+
+    for (v = 0; v < 65536UL; v++) {
+        for (g = 0; g < ft_grid_n; g++) {
+            for (order = 0; order < 2; order++) {
+                ua = (order == 0) ? (uint16_t) v : ft_grid[g];
+                ub = (order == 0) ? ft_grid[g] : (uint16_t) v;
+                a = (int16_t) ua;
+                b = (int16_t) ub;
+                cases++;
+                if (fix_mul16(ua, ub) != (uint32_t) ua * ub) {
+                    ft_fail("fix_mul16", ua, ub, 0, fix_mul16(ua, ub), (double) ua * ub, &bad[0]);
+                }
+                want = ft_signed(a, b, 8);
+                if (fix_mul_q8(a, b) != want) {
+                    ft_fail("fix_mul_q8", a, b, 0, fix_mul_q8(a, b), want, &bad[1]);
+                }
+                want = ft_signed(a, b, 15);
+                if (fix_mul_q15(a, b) != want) {
+                    ft_fail("fix_mul_q15", a, b, 0, fix_mul_q15(a, b), want, &bad[2]);
+                }
+                want = (long) a + b;
+                want = (want > 32767) ? 32767 : ((want < -32768) ? -32768 : want);
+                if (fix_add_sat(a, b) != want) {
+                    ft_fail("fix_add_sat", a, b, 0, fix_add_sat(a, b), want, &bad[3]);
+                }
+                want = (long) a - b;
+                want = (want > 32767) ? 32767 : ((want < -32768) ? -32768 : want);
+                if (fix_sub_sat(a, b) != want) {
+                    ft_fail("fix_sub_sat", a, b, 0, fix_sub_sat(a, b), want, &bad[4]);
+                }
+                want = (long) ua + ub;
+                want = (want > 65535) ? 65535 : want;
+                if (fix_addu_sat(ua, ub) != want) {
+                    ft_fail("fix_addu_sat", ua, ub, 0, fix_addu_sat(ua, ub), want, &bad[5]);
+                }
+            }
+        }
+    }
+    ft_report("fix_mul16", cases, bad[0], 0, 0);
+    ft_report("fix_mul_q8", cases, bad[1], 0, 0);
+    ft_report("fix_mul_q15", cases, bad[2], 0, 0);
+    ft_report("fix_add_sat", cases, bad[3], 0, 0);
+    ft_report("fix_sub_sat", cases, bad[4], 0, 0);
+    ft_report("fix_addu_sat", cases, bad[5], 0, 0);
+}
+
+/*=============================================================================
+ |  Function ft_lerp
+ |
+ |  Purpose: ft_lerp checks fix_lerp at every position between each pair of
+ |           grid values, against a + (b - a) * t / 256 truncated towards a
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void ft_lerp(void) {
+    unsigned long cases = 0, bad = 0;
+    unsigned int i, j, t;
+    int16_t a, b;
+    long want;
+
+    for (i = 0; i < ft_grid_n; i++) {
+        for (j = 0; j < ft_grid_n; j++) {
+            a = (int16_t) ft_grid[i];
+            b = (int16_t) ft_grid[j];
+            for (t = 0; t < 256; t++) {
+                cases++;
+                want = a + ((long) b - a) * (long) t / 256; // C division truncates
+                if (fix_lerp(a, b, (uint8_t) t) != want) {
+                    ft_fail("fix_lerp", a, b, t, fix_lerp(a, b, (uint8_t) t), want, &bad);
+                }
+            }
+        }
+    }
+    ft_report("fix_lerp", cases, bad, 0, 0);
+}
+
+/*=============================================================================
+ |  Function ft_mean
+ |
+ |  Purpose: ft_mean checks fix_mean for 1 - 16 readings against the rounded
+ |           mean of their full sum, over random arrays and the extremes
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void ft_mean(void) {
+    unsigned long cases = 0, bad = 0;
+    uint16_t x[16];
+    unsigned long run, sum;
+    unsigned char log2_n, n, k;
+
+    for (log2_n = 0; log2_n <= 4; log2_n++) {
+        n = 1 << log2_n;
+        for (run = 0; run < FT_MEAN_RUNS + 3; run++) {
+            for (k = 0; k < n; k++) {
+                if (run == FT_MEAN_RUNS) {
+                    x[k] = 65535; // Largest sum and remainders
+                } else if (run == FT_MEAN_RUNS + 1) {
+                    x[k] = 0;
+                } else if (run == FT_MEAN_RUNS + 2) {
+                    x[k] = (k & 1) ? 65535 : 0;
+                } else {
+                    x[k] = ft_random();
+                }
+            }
+            sum = 0;
+            for (k = 0; k < n; k++) {
+                sum += x[k];
+            }
+            cases++;
+            if (fix_mean(x, log2_n) != ((sum + (n >> 1)) >> log2_n)) {
+                ft_fail("fix_mean", log2_n, x[0], x[n - 1], fix_mean(x, log2_n),
+                        (sum + (n >> 1)) >> log2_n, &bad);
+            }
+        }
+    }
+    ft_report("fix_mean", cases, bad, 0, 0);
+}
+
+/*=============================================================================
+ |  Function ft_recip
+ |
+ |  Purpose: ft_recip checks fix_recip over its whole range against 2^31 / m
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void ft_recip(void) {
+    unsigned long cases = 0, bad = 0;
+    unsigned long m;
+    double want, err, worst = 0;
+
+    for (m = 32768UL; m < 65536UL; m++) {
+        cases++;
+        want = 2147483648.0 / m;
+        err = fabs(fix_recip((uint16_t) m) - want);
+        if (err > worst) {
+            worst = err;
+        }
+        if (err > FT_RECIP_MAX) {
+            ft_fail("fix_recip", (long) m, 0, 0, fix_recip((uint16_t) m), want, &bad);
+        }
+    }
+    ft_report("fix_recip", cases, bad, worst, FT_RECIP_MAX);
+}
+
+/*=============================================================================
+ |  Function ft_frac
+ |
+ |  Purpose: ft_frac checks fix_frac for every denominator against n / d in
+ |           Q15, for the grid of numerators below it and the 256 just below
+ |           it, where the quotient is largest
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: A numerator of at least d gives 32767, or 0 if d is 0.
++============================================================================*/
+
+static void ft_frac(void) {
+    unsigned long cases = 0, bad = 0;
+    unsigned long d, n;
+    unsigned int g;
+    double want, err, worst = 0;
+    int16_t q;
+
+    for (d = 0; d < 65536UL; d++) {
+        for (g = 0; g < ft_grid_n + 256; g++) {
+            if (g < ft_grid_n) {
+                n = ft_grid[g];
+            } else if (d >= g - ft_grid_n + 1) {
+                n = d - (g - ft_grid_n + 1);
+            } else {
+                break;
+            }
+            cases++;
+            q = fix_frac((uint16_t) n, (uint16_t) d);
+            if (n >= d) {
+                if (q != ((d == 0) ? 0 : FIX_Q15_ONE)) {
+                    ft_fail("fix_frac", (long) n, (long) d, 0, q, (d == 0) ? 0 : FIX_Q15_ONE, &bad);
+                }
+                continue;
+            }
+            want = n * 32768.0 / d;
+            err = fabs(q - want);
+            if (err > worst) {
+                worst = err;
+            }
+            if (err > FT_FRAC_MAX) {
+                ft_fail("fix_frac", (long) n, (long) d, 0, q, want, &bad);
+            }
+        }
+    }
+    ft_report("fix_frac", cases, bad, worst, FT_FRAC_MAX);
+}
+
+/*=============================================================================
+ |  Function ft_ratio
+ |
+ |  Purpose: ft_ratio checks fix_ratio against (a - b) / (a + b) in Q15
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void ft_ratio(void) {
+    unsigned long cases = 0, bad = 0;
+    unsigned long v;
+    unsigned int g;
+    unsigned char order;
+    uint16_t a, b;
+    double want, err, worst = 0;
+
+    for (v = 0; v < 65536UL; v++) {
+        for (g = 0; g < ft_grid_n; g++) {
+            for (order = 0; order < 2; order++) {
+                a = (order == 0) ? (uint16_t) v : ft_grid[g];
+                b = (order == 0) ? ft_grid[g] : (uint16_t) v;
+                cases++;
+                want = ((a == 0) && (b == 0)) ? 0 : ((double) a - b) * 32768.0 / ((double) a + b);
+                err = fabs(fix_ratio(a, b) - want);
+                if (err > worst) {
+                    worst = err;
+                }
+                if (err > FT_RATIO_MAX) {
+                    ft_fail("fix_ratio", a, b, 0, fix_ratio(a, b), want, &bad);
+                }
+            }
+        }
+    }
+    ft_report("fix_ratio", cases, bad, worst, FT_RATIO_MAX);
+}
+
+/*=============================================================================
+ |  Function ft_atan2
+ |
+ |  Purpose: ft_atan2 checks fix_atan2 against atan2() in degrees
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: 180 and -180 degrees are the same angle, taken as either.
++============================================================================*/
+
+static void ft_atan2(void) {
+    unsigned long cases = 0, bad = 0;
+    unsigned long v;
+    unsigned int g;
+    unsigned char order;
+    int16_t y, x;
+    double want, err, worst = 0;
+
+    for (v = 0; v < 65536UL; v++) {
+        for (g = 0; g < ft_grid_n; g++) {
+            for (order = 0; order < 2; order++) {
+                y = (int16_t) ((order == 0) ? (uint16_t) v : ft_grid[g]);
+                x = (int16_t) ((order == 0) ? ft_grid[g] : (uint16_t) v);
+                cases++;
+                want = ((x == 0) && (y == 0)) ? 0 : atan2(y, x) * 180 / FT_PI;
+                err = fabs(fix_atan2(y, x) / 128.0 - want);
+                if (err > 180) {
+                    err = 360 - err;
+                }
+                if (err > worst) {
+                    worst = err;
+                }
+                if (err > FT_ATAN2_MAX) {
+                    ft_fail("fix_atan2", y, x, 0, fix_atan2(y, x) / 128.0, want, &bad);
+                }
+            }
+        }
+    }
+    ft_report("fix_atan2", cases, bad, worst, FT_ATAN2_MAX);
+}
+
+int main(void) {
+    ft_grid_init();
+    ft_products();
+    ft_lerp();
+    ft_mean();
+    ft_recip();
+    ft_frac();
+    ft_ratio();
+    ft_atan2();
+    if (ft_failed) {
+        printf("fixed point check failed\n");
+        return 1;
+    }
+    printf("fixed point check passed\n");
+    return 0;
+}
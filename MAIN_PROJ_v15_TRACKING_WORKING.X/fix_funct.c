@@ -0,0 +1,514 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the fixed point arithmetic.
+ |               The formats are described in the header file fix_funct.h.
+ |               Multiplications of 16 bits are made of four 8 x 8 bit
+ |               hardware products, in place of the shift and add loops of
+ |               the run time library (__wmul, __lmul), and divisions are
+ |               made a multiplication by a reciprocal from fix_recip_table,
+ |               in place of __lwdiv and friends.
+ +===========================================================================*/
+#include "fix_funct.h"
+
+#define FIX_RECIP_STEP 9 // log2 of the spacing of fix_recip_table
+#define FIX_ATAN_STEP 10 // log2 of the spacing of fix_atan_table (Q15)
+
+// 2^31 / m for m = 32768 + 512k, k = 0 - 64, rounded (65536 is held as
+// 65535), in program memory
+const uint16_t fix_recip_table[65] = {
+    65535, 64528, 63550, 62602, 61681, 60787, 59919, 59075,
+    58254, 57456, 56680, 55924, 55188, 54471, 53773, 53092,
+    52429, 51782, 51150, 50534, 49932, 49345, 48771, 48210,
+    47663, 47127, 46603, 46091, 45590, 45100, 44620, 44151,
+    43691, 43240, 42799, 42367, 41943, 41528, 41121, 40721,
+    40330, 39946, 39569, 39199, 38836, 38480, 38130, 37787,
+    37449, 37118, 36792, 36472, 36158, 35849, 35545, 35246,
+    34953, 34664, 34380, 34100, 33825, 33554, 33288, 33026,
+    32768
+};
+
+// atan(k / 32) in degrees Q7 for k = 0 - 32, rounded, in program memory
+const int16_t fix_atan_table[33] = {
+    0, 229, 458, 686, 912, 1137, 1359, 1579,
+    1797, 2011, 2221, 2428, 2631, 2830, 3025, 3215,
+    3400, 3581, 3758, 3930, 4097, 4259, 4417, 4570,
+    4719, 4864, 5004, 5140, 5272, 5400, 5524, 5644,
+    5760
+};
+
+/*=============================================================================
+ |  Function fix_addu_sat
+ |
+ |  Purpose: fix_addu_sat adds two unsigned numbers, limited to 65535
+ |
+ |  Parameters:
+ |      a, b (uint16_t) - The numbers to be added
+ |
+ |  Returns:
+ |      uint16_t of a + b, or 65535 if larger
++============================================================================*/
+
+uint16_t fix_addu_sat(uint16_t a, uint16_t b) {
+    uint16_t sum = a + b;
+    if (sum < a) {
+        return 0xFFFF; // Carry out
+    }
+    return sum;
+}
+
+/*=============================================================================
+ |  Function fix_subu_sat
+ |
+ |  Purpose: fix_subu_sat subtracts two unsigned numbers, limited to 0
+ |
+ |  Parameters:
+ |      a, b (uint16_t) - The numbers, b being subtracted from a
+ |
+ |  Returns:
+ |      uint16_t of a - b, or 0 if b is larger
++============================================================================*/
+
+uint16_t fix_subu_sat(uint16_t a, uint16_t b) {
+    if (b > a) {
+        return 0;
+    }
+    return a - b;
+}
+
+/*=============================================================================
+ |  Function fix_add_sat
+ |
+ |  Purpose: fix_add_sat adds two signed numbers of the same format, limited
+ |           to the range of int16_t
+ |
+ |  Parameters:
+ |      a, b (int16_t) - The numbers to be added
+ |
+ |  Returns:
+ |      int16_t of a + b, or -32768 or 32767 if out of range
+ |
+ |  Comments: The sum overflows if both numbers have the same sign and the
+ |            sum does not.
++============================================================================*/
+
+int16_t fix_add_sat(int16_t a, int16_t b) {
+    int16_t sum = (int16_t) ((uint16_t) a + (uint16_t) b);
+    if (((a ^ sum) & (b ^ sum)) < 0) {
+        return (a < 0) ? INT16_MIN : INT16_MAX;
+    }
+    return sum;
+}
+
+/*=============================================================================
+ |  Function fix_sub_sat
+ |
+ |  Purpose: fix_sub_sat subtracts two signed numbers of the same format,
+ |           limited to the range of int16_t
+ |
+ |  Parameters:
+ |      a, b (int16_t) - The numbers, b being subtracted from a
+ |
+ |  Returns:
+ |      int16_t of a - b, or -32768 or 32767 if out of range
+ |
+ |  Comments: The difference overflows if the numbers have different signs
+ |            and the difference does not have the sign of a.
++============================================================================*/
+
+int16_t fix_sub_sat(int16_t a, int16_t b) {
+    int16_t diff = (int16_t) ((uint16_t) a - (uint16_t) b);
+    if (((a ^ b) & (a ^ diff)) < 0) {
+        return (a < 0) ? INT16_MIN : INT16_MAX;
+    }
+    return diff;
+}
+
+/*=============================================================================
+ |  Function fix_clamp
+ |
+ |  Purpose: fix_clamp limits a number to a range
+ |
+ |  Parameters:
+ |      x (int16_t) - The number to be limited
+ |      lo, hi (int16_t) - Lowest and highest value of the range
+ |
+ |  Returns:
+ |      int16_t of x, lo if x is below the range or hi if above
++============================================================================*/
+
+int16_t fix_clamp(int16_t x, int16_t lo, int16_t hi) {
+    if (x < lo) {
+        return lo;
+    }
+    if (x > hi) {
+        return hi;
+    }
+    return x;
+}
+
+/*=============================================================================
+ |  Function fix_mul16
+ |
+ |  Purpose: fix_mul16 multiplies two unsigned 16 bit numbers, exactly
+ |
+ |  Parameters:
+ |      a, b (uint16_t) - The numbers to be multiplied
+ |
+ |  Returns:
+ |      uint32_t of a * b
+ |
+ |  Comments: The sum of four 8 x 8 bit hardware products of the bytes of a
+ |            and b, shifted by whole bytes.
++============================================================================*/
+
+uint32_t fix_mul16(uint16_t a, uint16_t b) {
+    uint8_t al = (uint8_t) a;
+    uint8_t ah = (uint8_t) (a >> 8);
+    uint8_t bl = (uint8_t) b;
+    uint8_t bh = (uint8_t) (b >> 8);
+    uint32_t product;
+
+    product = ((uint32_t) fix_mul8(ah, bh) << 16) | fix_mul8(al, bl);
+    product += (uint32_t) fix_mul8(ah, bl) << 8;
+    product += (uint32_t) fix_mul8(al, bh) << 8;
+    return product;
+}
+
+/*=============================================================================
+ |  Function fix_mul16_hi
+ |
+ |  Purpose: fix_mul16_hi multiplies an unsigned number by an unsigned
+ |           fraction of 16 bits (65536 being 1)
+ |
+ |  Parameters:
+ |      a (uint16_t) - The number to be multiplied
+ |      b (uint16_t) - The fraction, 0 - 65535/65536
+ |
+ |  Returns:
+ |      uint16_t of the high 16 bits of a * b, rounded down
++============================================================================*/
+
+uint16_t fix_mul16_hi(uint16_t a, uint16_t b) {
+    return (uint16_t) (fix_mul16(a, b) >> 16);
+}
+
+/*=============================================================================
+ |  Function fix_signed
+ |
+ |  Purpose: fix_signed gives the sign to the magnitude of a signed product,
+ |           limited to the range of int16_t
+ |
+ |  Parameters:
+ |      magnitude (uint32_t) - Magnitude of the product, already scaled
+ |      negative (unsigned char) - 1 if the product is negative
+ |
+ |  Returns:
+ |      int16_t of the product, or -32768 or 32767 if out of range
++============================================================================*/
+
+int16_t fix_signed(uint32_t magnitude, unsigned char negative) {
+    if (negative) {
+        if (magnitude >= 32768UL) {
+            return INT16_MIN;
+        }
+        return -(int16_t) magnitude;
+    }
+    if (magnitude > 32767UL) {
+        return INT16_MAX;
+    }
+    return (int16_t) magnitude;
+}
+
+/*=============================================================================
+ |  Function fix_mul_q8
+ |
+ |  Purpose: fix_mul_q8 multiplies two signed numbers of which one is in Q8,
+ |           such that the product has the format of the other
+ |
+ |  Parameters:
+ |      a, b (int16_t) - The numbers to be multiplied
+ |
+ |  Returns:
+ |      int16_t of (a * b) / 256, rounded to nearest, or -32768 or 32767 if
+ |      out of range
+ |
+ |  Comments: The magnitudes are multiplied, such that rounding is the same
+ |            either side of zero.
++============================================================================*/
+
+int16_t fix_mul_q8(int16_t a, int16_t b) {
+    uint16_t ua = (a < 0) ? -(uint16_t) a : (uint16_t) a;
+    uint16_t ub = (b < 0) ? -(uint16_t) b : (uint16_t) b;
+    return fix_signed((fix_mul16(ua, ub) + 128) >> 8, (a ^ b) < 0);
+}
+
+/*=============================================================================
+ |  Function fix_mul_q15
+ |
+ |  Purpose: fix_mul_q15 multiplies two signed numbers of which one is in
+ |           Q15, such that the product has the format of the other
+ |
+ |  Parameters:
+ |      a, b (int16_t) - The numbers to be multiplied
+ |
+ |  Returns:
+ |      int16_t of (a * b) / 32768, rounded to nearest, or 32767 for
+ |      -1 * -1
+ |
+ |  Comments: As fix_mul_q8().
++============================================================================*/
+
+int16_t fix_mul_q15(int16_t a, int16_t b) {
+    uint16_t ua = (a < 0) ? -(uint16_t) a : (uint16_t) a;
+    uint16_t ub = (b < 0) ? -(uint16_t) b : (uint16_t) b;
+    return fix_signed((fix_mul16(ua, ub) + 16384) >> 15, (a ^ b) < 0);
+}
+
+/*=============================================================================
+ |  Function fix_lerp
+ |
+ |  Purpose: fix_lerp interpolates linearly between two numbers, such as
+ |           neighbouring entries of a table
+ |
+ |  Parameters:
+ |      a, b (int16_t) - Values at either end
+ |      t (uint8_t) - Position between a and b in 256ths, 0 being a
+ |
+ |  Returns:
+ |      int16_t of a + (b - a) * t / 256, rounded towards a
+ |
+ |  Comments: The result lies between a and b, so cannot overflow, however
+ |            far apart they are.
++============================================================================*/
+
+int16_t fix_lerp(int16_t a, int16_t b, uint8_t t) {
+    uint16_t step;
+    if (b >= a) {
+        step = (uint16_t) (fix_mul16((uint16_t) b - (uint16_t) a, t) >> 8);
+        return (int16_t) ((uint16_t) a + step);
+    }
+    step = (uint16_t) (fix_mul16((uint16_t) a - (uint16_t) b, t) >> 8);
+    return (int16_t) ((uint16_t) a - step);
+}
+
+/*=============================================================================
+ |  Function fix_mean
+ |
+ |  Purpose: fix_mean averages a power of 2 of unsigned readings, without
+ |           their sum overflowing 16 bits
+ |
+ |  Parameters:
+ |      *x (uint16_t) - Array of 2^log2_n readings
+ |      log2_n (unsigned char) - 0 - 4, for 1 - 16 readings
+ |
+ |  Returns:
+ |      uint16_t of the mean, rounded to nearest
+ |
+ |  Comments: Each reading is split into its quotient and remainder by the
+ |            number of readings, and the remainders are averaged on their
+ |            own, such that the mean is as exact as that of the full sum.
++============================================================================*/
+
+uint16_t fix_mean(const uint16_t *x, unsigned char log2_n) {
+    unsigned char n = 1 << log2_n;
+    unsigned char mask = n - 1;
+    unsigned char remainder = n >> 1; // Rounding
+    uint16_t mean = 0;
+    unsigned char k;
+
+    for (k = 0; k < n; k++) {
+        mean += x[k] >> log2_n;
+        remainder += (unsigned char) x[k] & mask;
+    }
+    return mean + (remainder >> log2_n);
+}
+
+/*=============================================================================
+ |  Function fix_norm
+ |
+ |  Purpose: fix_norm shifts a number left until its top bit is set
+ |
+ |  Parameters:
+ |      *x (uint16_t) - Address of the number, 1 - 65535
+ |
+ |  Returns:
+ |      Unsigned char of the number of places shifted, 0 - 15 (0 for 0, which
+ |      is left as it is)
++============================================================================*/
+
+unsigned char fix_norm(uint16_t *x) {
+    unsigned char shift = 0;
+    uint16_t value = *x;
+
+    if (value == 0) {
+        return 0;
+    }
+    if (value < 0x0100) {
+        value <<= 8; // Whole byte at once
+        shift = 8;
+    }
+    while ((value & 0x8000) == 0) {
+        value <<= 1;
+        shift++;
+    }
+    *x = value;
+    return shift;
+}
+
+/*=============================================================================
+ |  Function fix_recip
+ |
+ |  Purpose: fix_recip looks up the reciprocal of a number normalised by
+ |           fix_norm(), interpolating between the entries of
+ |           fix_recip_table
+ |
+ |  Parameters:
+ |      m (uint16_t) - The number, 32768 - 65535
+ |
+ |  Returns:
+ |      uint16_t of 2^31 / m, 32768 - 65535, within 8 of the exact value
+ |
+ |  Comments: A number normalised by a shift of s has the reciprocal
+ |            fix_recip(m) / 2^(31 - s), such that x / d is
+ |            fix_mul16(x, fix_recip(m)) >> (31 - s).
++============================================================================*/
+
+uint16_t fix_recip(uint16_t m) {
+    unsigned char k = (unsigned char) (m >> FIX_RECIP_STEP) - 64;
+    uint8_t t = (uint8_t) (m >> (FIX_RECIP_STEP - 8));
+    uint16_t r0 = fix_recip_table[k];
+    uint16_t r1 = fix_recip_table[k + 1];
+
+    return r0 - (uint16_t) (fix_mul16(r0 - r1, t) >> 8);
+}
+
+/*=============================================================================
+ |  Function fix_frac
+ |
+ |  Purpose: fix_frac divides an unsigned number by a larger one
+ |
+ |  Parameters:
+ |      n (uint16_t) - Numerator
+ |      d (uint16_t) - Denominator, at least n
+ |
+ |  Returns:
+ |      int16_t of n / d in Q15, 0 - 32767, rounded down, 32767 if n is d
+ |      and 0 if both are 0
+ |
+ |  Comments: Both are shifted by the normalisation of d, which keeps n below
+ |            65536 as it is less than d, and the quotient is the product of
+ |            n and the reciprocal of d, within 4 of the exact quotient.
++============================================================================*/
+
+int16_t fix_frac(uint16_t n, uint16_t d) {
+    uint16_t q;
+
+    if (n >= d) {
+        return (d == 0) ? 0 : FIX_Q15_ONE;
+    }
+    n <<= fix_norm(&d);
+    q = fix_mul16_hi(n, fix_recip(d));
+    return (q > FIX_Q15_ONE) ? FIX_Q15_ONE : (int16_t) q;
+}
+
+/*=============================================================================
+ |  Function fix_ratio
+ |
+ |  Purpose: fix_ratio gives the normalised difference of two unsigned
+ |           readings, (a - b) / (a + b), which is independent of their scale
+ |
+ |  Parameters:
+ |      a, b (uint16_t) - The readings
+ |
+ |  Returns:
+ |      int16_t of (a - b) / (a + b) in Q15, -32767 - 32767, or 0 if both
+ |      are 0
+ |
+ |  Comments: Both readings are halved if their sum overflows 16 bits.
++============================================================================*/
+
+int16_t fix_ratio(uint16_t a, uint16_t b) {
+    uint16_t sum = a + b;
+
+    if (sum < a) {
+        a >>= 1;
+        b >>= 1;
+        sum = a + b;
+    }
+    if (a >= b) {
+        return fix_frac(a - b, sum);
+    }
+    return -fix_frac(b - a, sum);
+}
+
+/*=============================================================================
+ |  Function fix_atan
+ |
+ |  Purpose: fix_atan looks up the arctangent of a fraction, interpolating
+ |           between the entries of fix_atan_table
+ |
+ |  Parameters:
+ |      t (int16_t) - The fraction in Q15, 0 - 32767
+ |
+ |  Returns:
+ |      int16_t of atan(t) in degrees Q7, 0 - 45 degrees
++============================================================================*/
+
+int16_t fix_atan(int16_t t) {
+    unsigned char k = (unsigned char) (t >> FIX_ATAN_STEP);
+    return fix_lerp(fix_atan_table[k], fix_atan_table[k + 1],
+            (uint8_t) (t >> (FIX_ATAN_STEP - 8)));
+}
+
+/*=============================================================================
+ |  Function fix_atan2
+ |
+ |  Purpose: fix_atan2 gives the angle of a vector (x, y) from the x axis
+ |
+ |  Parameters:
+ |      y, x (int16_t) - Components of the vector, in any one format
+ |
+ |  Returns:
+ |      int16_t of the angle in degrees Q7, -180 to 180 degrees, positive
+ |      towards y, within 0.03 degrees. 0 if both are 0.
+ |
+ |  Comments: The angle is found in the first octant, from the ratio of the
+ |            smaller component to the larger, and then reflected into the
+ |            octant of the vector.
++============================================================================*/
+
+int16_t fix_atan2(int16_t y, int16_t x) {
+    uint16_t ux = (x < 0) ? -(uint16_t) x : (uint16_t) x;
+    uint16_t uy = (y < 0) ? -(uint16_t) y : (uint16_t) y;
+    int16_t angle;
+
+    if (ux >= uy) {
+        angle = fix_atan(fix_frac(uy, ux));
+    } else {
+        angle = FIX_DEG(90) - fix_atan(fix_frac(ux, uy));
+    }
+    if (x < 0) {
+        angle = FIX_DEG(180) - angle;
+    }
+    return (y < 0) ? -angle : angle;
+}
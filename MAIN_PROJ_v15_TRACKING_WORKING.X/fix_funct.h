@@ -0,0 +1,73 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the fixed point
+ |               arithmetic shared by the filters, the motor output and the
+ |               turn planning. Values are held in 16 bit integers, in one
+ |               of the formats below, named Qn for n fractional bits:
+ |                   Q8 (int16_t) - Gains and scale factors, 256 is 1, as
+ |                                  the IR sensor gains (see IRCal)
+ |                   Q15 (int16_t) - Fractions and ratios, -1 to 32767/32768
+ |                   Degrees Q7 (int16_t) - Angles, 128 is 1 degree, -180 to
+ |                                          180 degrees
+ |               Products are built from the 8 x 8 hardware multiplier of the
+ |               PIC18 (one MULWF instruction), and quotients from a table of
+ |               reciprocals, as there is no divide instruction. Results out
+ |               of range saturate rather than wrap. Detailed function
+ |               descriptions can be found in the fix_funct.c file.
+ +===========================================================================*/
+
+#ifndef FIX_FUNCT_H
+#define	FIX_FUNCT_H
+
+#include <stdint.h>
+
+// Constants in each format, rounded to nearest, for constant x only
+#define FIX_Q8(x) ((int16_t) ((x) * 256.0 + (((x) < 0) ? -0.5 : 0.5)))
+#define FIX_Q15(x) ((int16_t) ((x) * 32768.0 + (((x) < 0) ? -0.5 : 0.5)))
+#define FIX_DEG(x) ((int16_t) ((x) * 128.0 + (((x) < 0) ? -0.5 : 0.5)))
+
+#define FIX_Q8_ONE 256
+#define FIX_Q15_ONE 32767 // Largest Q15 value, taken as 1
+#define FIX_DEG_ONE 128
+
+// Unsigned 8 x 8 bit product, a single MULWF with XC8
+#define fix_mul8(a, b) ((uint16_t) ((uint8_t) (a) * (uint8_t) (b)))
+
+uint16_t fix_addu_sat(uint16_t a, uint16_t b);
+uint16_t fix_subu_sat(uint16_t a, uint16_t b);
+int16_t fix_add_sat(int16_t a, int16_t b);
+int16_t fix_sub_sat(int16_t a, int16_t b);
+int16_t fix_clamp(int16_t x, int16_t lo, int16_t hi);
+uint32_t fix_mul16(uint16_t a, uint16_t b);
+uint16_t fix_mul16_hi(uint16_t a, uint16_t b);
+int16_t fix_mul_q8(int16_t a, int16_t b);
+int16_t fix_mul_q15(int16_t a, int16_t b);
+int16_t fix_lerp(int16_t a, int16_t b, uint8_t t);
+uint16_t fix_mean(const uint16_t *x, unsigned char log2_n);
+unsigned char fix_norm(uint16_t *x);
+uint16_t fix_recip(uint16_t m);
+int16_t fix_frac(uint16_t n, uint16_t d);
+int16_t fix_ratio(uint16_t a, uint16_t b);
+int16_t fix_atan2(int16_t y, int16_t x);
+
+#endif
@@ -0,0 +1,127 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the fixed width number
+ |               formatting, which replaces itoa_5() and power(). A decimal
+ |               digit takes at most nine 16 bit subtractions of its place
+ |               value, in place of a power() loop, a division and a modulo
+ |               per digit. Function prototypes can be found in the header
+ |               file fmt_funct.h
+ +===========================================================================*/
+#include "fmt_funct.h"
+
+// Place value of each decimal digit, in program memory
+const unsigned int fmt_places[FMT_DEC_DIGITS] = {10000, 1000, 100, 10, 1};
+
+const unsigned char fmt_hex_digits[16] = "0123456789ABCDEF";
+
+/*=============================================================================
+ |  Function fmt_dec
+ |
+ |  Purpose: fmt_dec writes an unsigned number as a fixed number of decimal
+ |           digits, with leading zeros
+ |
+ |  Parameters: 
+ |      *buffer (unsigned char) - Buffer of at least width + 1 elements
+ |      value (unsigned int) - The number to be written
+ |      width (unsigned char) - Number of digits, 1 - 5, where 5 holds any
+ |                              value
+ |
+ |  Returns: 
+ |      Address of the null byte written after the digits
+ |
+ |  Comments: Digits above the width are left out, such that the number is
+ |            written modulo 10^width.
++============================================================================*/
+
+unsigned char *fmt_dec(unsigned char *buffer, unsigned int value, unsigned char width) {
+    unsigned char k;
+    unsigned char digit;
+    unsigned int place;
+
+    for (k = 0; k < FMT_DEC_DIGITS; k++) {
+        place = fmt_places[k];
+        digit = '0';
+        while (value >= place) {
+            value -= place;
+            digit++;
+        }
+        if ((FMT_DEC_DIGITS - k) <= width) {
+            *buffer = digit;
+            buffer++;
+        }
+    }
+    *buffer = 0;
+    return buffer;
+}
+
+/*=============================================================================
+ |  Function fmt_sdec
+ |
+ |  Purpose: fmt_sdec writes a signed number as a sign, + or -, and a fixed
+ |           number of decimal digits, with leading zeros
+ |
+ |  Parameters: 
+ |      *buffer (unsigned char) - Buffer of at least width + 2 elements
+ |      value (int) - The number to be written
+ |      width (unsigned char) - Number of digits, as for fmt_dec()
+ |
+ |  Returns: 
+ |      Address of the null byte written after the digits
++============================================================================*/
+
+unsigned char *fmt_sdec(unsigned char *buffer, int value, unsigned char width) {
+    if (value < 0) {
+        *buffer = '-';
+        // Negated as unsigned, which holds -32768
+        return fmt_dec(buffer + 1, -(unsigned int) value, width);
+    }
+    *buffer = '+';
+    return fmt_dec(buffer + 1, value, width);
+}
+
+/*=============================================================================
+ |  Function fmt_hex
+ |
+ |  Purpose: fmt_hex writes an unsigned number as a fixed number of 
+ |           hexadecimal digits, with leading zeros
+ |
+ |  Parameters: 
+ |      *buffer (unsigned char) - Buffer of at least width + 1 elements
+ |      value (unsigned int) - The number to be written
+ |      width (unsigned char) - Number of digits, 1 - 4
+ |
+ |  Returns: 
+ |      Address of the null byte written after the digits
++============================================================================*/
+
+unsigned char *fmt_hex(unsigned char *buffer, unsigned int value, unsigned char width) {
+    unsigned char *end = buffer + width;
+
+    *end = 0;
+    while (end > buffer) {
+        end--;
+        *end = fmt_hex_digits[value & 0x0F];
+        value >>= 4;
+    }
+    return buffer + width;
+}
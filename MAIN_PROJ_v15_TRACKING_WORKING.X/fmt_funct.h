@@ -0,0 +1,45 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the fixed width number
+ |               formatting, in decimal, signed decimal and hexadecimal, for
+ |               the LCD and serial output. Each function writes its digits
+ |               and a null byte straight into the buffer and returns the
+ |               address of the null byte, so that further text can be
+ |               appended in place. The decimal digits are found by
+ |               subtracting the place values, as the PIC18 has no divide
+ |               instruction. Detailed function descriptions can be found in
+ |               the fmt_funct.c file.
+ +===========================================================================*/
+
+#ifndef FMT_FUNCT_H
+#define	FMT_FUNCT_H
+
+#define FMT_DEC_DIGITS 5 // Digits of the largest unsigned int, 65535
+
+extern const unsigned char fmt_hex_digits[16];
+
+unsigned char *fmt_dec(unsigned char *buffer, unsigned int value, unsigned char width);
+unsigned char *fmt_sdec(unsigned char *buffer, int value, unsigned char width);
+unsigned char *fmt_hex(unsigned char *buffer, unsigned int value, unsigned char width);
+
+#endif
@@ -25,142 +25,135 @@
  |               on the header file functions.h
  +===========================================================================*/
 #include <stdio.h>
-#include <xc.h>
+#include "hal.h"
 #include "dc_motor_struct.h"
 #include "lcd_funct.h"
 #include "functions.h"
-#pragma config OSC = IRCIO // internal oscillator
-#define _XTAL_FREQ 8000000
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "replay_funct.h"
+#include "trace_funct.h"
+#include "log_funct.h"
+#include "fmt_funct.h"
+#include "fix_funct.h"
+#include "bearing_funct.h"
+#include "beacon_funct.h"
+#include "adc_funct.h"
+
+// Standby menu labels, indexed by the MODE_ definitions in functions.h
+const unsigned char * const mode_names[MODE_COUNT] = {
+    TEXT("S"), TEXT("CAL ROT"), TEXT("CAL IR"), TEXT("PARAMS"),
+#ifdef TUNE
+    TEXT("TUNE"),
+#endif
+#ifdef PROFILE
+    TEXT("PROF"),
+#endif
+};
 
 /*=============================================================================
- |  Function power
+ |  Function delay_s
  |
- |  Purpose: power computes the result of a number to a certain power
+ |  Purpose: delay_s implements a delay in multiples of seconds, using the 
+ |           internal __delay_ms function
  |
  |  Parameters: 
- |      number (int) - The number to be raised to a power
- |      power (int) - The power to which the number is raised
- |
- |  Returns: 
- |      Integer of number^power
+ |      seconds (char) - The number of seconds to be delayed
  |
- |  Comments: This is to avoid the use of the memory intensive math module,
- |            but can only return values of up to 32767.
+ |  Returns: Nothing (Void function)
  |
+ |  Comments: With the previous XC8 compiler function, __delay_ms() took in
+ |            a max argument of 179200 instruction cycles, i.e. 89.6ms max
+ |            delay, which prompted the need for this function to achieve 
+ |            higher accurate delays. 
+ |            However, the current XC8 compiler (v2)
+ |            takes in a max argument of 50463240 instruction cycles, which
+ |            is approximately a 25.2s max delay. The need for delay_s outside
+ |            of clarity of code is obviated, and subsequent revisions could
+ |            consider eliminating this function entirely.
 +============================================================================*/
 
-int power(int number, int power) {
-    unsigned char i = 1;
-    int temp = number;
-    while (i < power) {
-        number = number * temp;
-        i++;
-    }
-    if (power == 0) {
-        number = 1;
+void delay_s(char seconds) {
+    
+    unsigned int cycles = 20 * seconds; //0.5us
+    unsigned int i = 0; // 0.5 us
+    for (i = 0; i < cycles; i++) {
+        motor_refresh(); // Follow the battery as the motors run
+        __delay_ms(50);
     }
-    return number;
-}
+} 
 
 /*=============================================================================
- |  Function itoa_5
+ |  Function time_ms
  |
- |  Purpose: itoa_5 recieves an integer and returns an array containing the
- |           string representation of the integer as per ASCII standards
+ |  Purpose: time_ms returns the millisecond counter G_time_ms, which is
+ |           incremented by the low priority TIMER0 interrupt
  |
  |  Parameters: 
- |      number (unsigned int) - The number to be converted to a string
- |      *buffer (unsigned char buffer) - Array to which string is written
- |
- |  Returns: Nothing (Void function)
+ |      Nothing (No arguments)
  |
- |  Comments: Implemented to avoid the memory intensive sprintf function, but
- |            only converts integers of up to 5 digits (which should be 
- |            expected).
+ |  Returns: 
+ |      Unsigned integer of G_time_ms
  |
+ |  Comments: G_time_ms is 16 bits wide and is read one byte at a time, so the
+ |            low priority interrupt is held off while it is copied. Elapsed 
+ |            time should be computed as an unsigned difference, which stays
+ |            correct across the 65s overflow.
 +============================================================================*/
 
-void itoa_5(unsigned int number, unsigned char* buffer) {
-    unsigned char k = 0;
-    while (k < 16) {
-        buffer[k] = 0;
-        k++;
-    }
-    unsigned int remainder = 0;
-    unsigned int quotient = 0;
-    unsigned char i = 4;
-    unsigned char j = 0;
-    while (i > 0) {
-        quotient = number / power(10, i);
-        remainder = number % power(10, i);
-        buffer[j] = (quotient + 48); // Convert the numbers to ASCII chars
-        number = remainder;
-        i--;
-        j++;
-    }
-    buffer[j] = (number + 48); // Convert the last number to ASCII char
+unsigned int time_ms(void) {
+    unsigned int now;
+    hal_irq_low_off(); // Hold off TIMER0 interrupt
+    now = G_time_ms;
+    hal_irq_low_on();
+    return now;
 }
 
 /*=============================================================================
- |  Function init_serial
+ |  Function delay_ms
  |
- |  Purpose: init_serial initializes the serial communication register of the
- |           PIC18F4331 microcontroller, with a baud rate of 9600
+ |  Purpose: delay_ms implements a delay of a variable number of miliseconds,
+ |           using the G_time_ms counter
  |
  |  Parameters: 
- |      Nothing (No arguments)
+ |      ms (unsigned int) - The number of miliseconds to be delayed
  |
  |  Returns: Nothing (Void function)
  |
- |  Comments: Ports are set up according to the schematic in the ECM Lab notes
- |            chapter 7.
- |
+ |  Comments: __delay_ms() only accepts a constant argument, so delays which
+ |            are computed at run time must use this function instead. It 
+ |            cannot be used within the high priority interrupt, as G_time_ms
+ |            does not increment there. The motor duty follows the battery
+ |            meanwhile (see motor_refresh()).
 +============================================================================*/
 
-void init_serial(void) {
-    //set data direction registers for TX, RX
-    TRISCbits.RC7 = 1; //RX
-    TRISCbits.RC6 = 1; //TX
-    //both need to be 1 even though RC6 is an output
-    SPBRG = 207; //set baud rate to 9600
-    SPBRGH = 0;
-    BAUDCONbits.BRG16 = 1; //set baud rate scaling to 16 bit mode
-    TXSTAbits.BRGH = 1; //high baud rate select bit
-    RCSTAbits.CREN = 1; //continuous receive mode
-    RCSTAbits.SPEN = 1; //enable serial port, other settings default
-    TXSTAbits.TXEN = 1; //enable transmitter, other settings default
+void delay_ms(unsigned int ms) {
+    unsigned int start = time_ms();
+    while ((unsigned int) (time_ms() - start) < ms) {
+        motor_refresh();
+    }
 }
 
 /*=============================================================================
- |  Function delay_s
+ |  Function delay_ms_until
  |
- |  Purpose: delay_s implements a delay in multiples of seconds, using the 
- |           internal __delay_ms function
+ |  Purpose: delay_ms_until implements a delay of a variable number of
+ |           miliseconds as delay_ms does, ending early once a flag is set
  |
  |  Parameters: 
- |      seconds (char) - The number of seconds to be delayed
+ |      ms (unsigned int) - The number of miliseconds to be delayed
+ |      *flag (volatile unsigned char) - Flag set by an interrupt, e.g.
+ |                                       G_rfid_retrieved
  |
  |  Returns: Nothing (Void function)
- |
- |  Comments: With the previous XC8 compiler function, __delay_ms() took in
- |            a max argument of 179200 instruction cycles, i.e. 89.6ms max
- |            delay, which prompted the need for this function to achieve 
- |            higher accurate delays. 
- |            However, the current XC8 compiler (v2)
- |            takes in a max argument of 50463240 instruction cycles, which
- |            is approximately a 25.2s max delay. The need for delay_s outside
- |            of clarity of code is obviated, and subsequent revisions could
- |            consider eliminating this function entirely.
 +============================================================================*/
 
-void delay_s(char seconds) {
-    
-    unsigned int cycles = 20 * seconds; //0.5us
-    unsigned int i = 0; // 0.5 us
-    for (i = 0; i < cycles; i++) {
-        __delay_ms(50);
+void delay_ms_until(unsigned int ms, volatile unsigned char *flag) {
+    unsigned int start = time_ms();
+    while ((*flag == 0) & ((unsigned int) (time_ms() - start) < ms)) {
+        motor_refresh();
     }
-} 
+}
 
 /*=============================================================================
  |  Function get_char_serial
@@ -175,8 +168,8 @@ void delay_s(char seconds) {
 +============================================================================*/
 
 char get_char_serial(void) {
-    while (!PIR1bits.RCIF); //wait for the data to arrive
-    return RCREG; //return byte in RCREG
+    while (!hal_uart_rx_flag()); //wait for the data to arrive
+    return hal_uart_rx(); //return byte in RCREG
 }
 
 /*=============================================================================
@@ -188,13 +181,17 @@ char get_char_serial(void) {
  |           the packet array to zero (null)
  |
  |  Parameters: 
- |      *packet (char) - Array to which data string will be written to. Must be
- |                       of at least 16 elements
+ |      *packet (volatile unsigned char) - Array to which data string will be
+ |                                         written to. Must be of at least 16
+ |                                         elements
  |
  |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called from the high priority interrupt into G_rfid_buf, which
+ |            main copies out with the interrupts off (see main.c).
 +============================================================================*/
 
-void get_packet_serial(char *packet) {
+void get_packet_serial(volatile unsigned char *packet) {
     unsigned char i = 0;
     packet[i] = get_char_serial(); // from RX
     // check for start of statement
@@ -220,58 +217,94 @@ void get_packet_serial(char *packet) {
 }
 
 /*=============================================================================
- |  Function init_interrupt
+ |  Function rfid_valid
  |
- |  Purpose: init_interrupt enables global interupt for both high and low
- |           priorities, enabling the peripheral interrupt function
+ |  Purpose: rfid_valid checks a packet from get_packet_serial: ten data and
+ |           two checksum characters in hexadecimal, then CR and LF, where 
+ |           the checksum is the XOR of the five data bytes
  |
  |  Parameters: 
- |      Nothing (No arguments)
+ |      *packet (volatile unsigned char) - Packet of 16 elements
  |
- |  Returns: Nothing (Void function)
+ |  Returns: 
+ |      Unsigned char of 1 if valid, else 0
+ |
+ |  Comments: Called from the high priority interrupt as each packet is
+ |            received, for the emergency stop (see hp_rfid()). The XOR of
+ |            the data bytes and the checksum byte is 0 when valid.
 +============================================================================*/
 
-void init_interrupt() {
-    INTCONbits.GIEH = 1; // Global Interrupt Enable bit
-    PIE1bits.RCIE = 1; // Receive Flag Interrupt Enable
-    INTCONbits.PEIE = 1; // Peripheral Interrupt Enable
-    INTCONbits.GIEL = 1; // Global Low priority interrupt enable bit
-    RCONbits.IPEN = 1; //Enable priorities
+unsigned char rfid_valid(volatile unsigned char *packet) {
+    unsigned char i;
+    unsigned char c;
+    unsigned char byte = 0;
+    unsigned char sum = 0;
+
+    for (i = 0; i < 12; i++) {
+        c = packet[i];
+        if ((c >= '0') & (c <= '9')) {
+            c -= '0';
+        } else if ((c >= 'A') & (c <= 'F')) {
+            c -= 'A' - 10;
+        } else {
+            return 0; // Not hexadecimal
+        }
+        byte = (byte << 4) | c;
+        if (i & 1) {
+            sum ^= byte; // Every second character completes a byte
+        }
+    }
+    return (sum == 0) & (packet[12] == 13) & (packet[13] == 10);
+}
 
+/*=============================================================================
+ |  Function put_char_serial
+ |
+ |  Purpose: put_char_serial sends a byte from the TXREG serial register,
+ |           waiting until the previous byte has been sent
+ |
+ |  Parameters: 
+ |      c (char) - Byte to be sent
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void put_char_serial(char c) {
+    while (!hal_uart_tx_flag()); // wait for the previous byte to leave TXREG
+    hal_uart_tx(c);
 }
 
 /*=============================================================================
- |  Function init_ir
+ |  Function put_string_serial
  |
- |  Purpose: init_ir initializes the infared reciever connected to the MFM
- |           (Motion Feedback Module) module of the PIC18F4331. The PWM falling
- |           to rising mode is enabled for the CAP2 and CAP3 pins with a 
- |           prescaler of 1:2
+ |  Purpose: put_string_serial sends a null terminated string over serial
  |
  |  Parameters: 
- |      Nothing (No arguments)
+ |      *string (const unsigned char) - String to be sent
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void put_string_serial(const unsigned char *string) {
+    while (*string != 0) {
+        put_char_serial(*string++);
+    }
+}
+
+/*=============================================================================
+ |  Function put_hex
+ |
+ |  Purpose: put_hex sends a byte over serial as two hexadecimal characters
+ |
+ |  Parameters:
+ |      byte (unsigned char) - Byte to be sent
  |
  |  Returns: Nothing (Void function)
 +============================================================================*/
 
-void init_ir(void) {
-    ANSEL0 = 0; // Disable analogue input for 0 - 7
-    QEICON = 0; // Disable quadrature encoder 
-    DFLTCON = 0b00110110; // Enable noise filter for CAP2 and CAP3 with 1:128 clock divider ratio
-    TRISAbits.RA3 = 1; // Sets pins RA3/CAP2 and RA4/CAP3 as input
-    TRISAbits.RA4 = 1;
-    CAP2CONbits.CAP2M = 0b0110; // Enables PWM falling - rising for CAP2
-    CAP3CONbits.CAP3M = 0b0110; // Enables PWM falling - rising for CAP3
-
-
-    T5CONbits.TMR5ON = 1; // Enables the TMR5 module
-    T5CONbits.T5PS = 0b01; // Prescaler of 1:2
-    T5CONbits.RESEN = 0; // Enabled Special Event Trigger
-    T5CONbits.T5MOD = 0; // Continuous Count Mode Enabled
-    T5CONbits.T5SEN = 0; // Disable Timer during Sleep
-    T5CONbits.TMR5CS = 0; // No Clock Source, use Internal Clock
-    PR5H = 0xFF;
-    PR5L = 0xFF;
+void put_hex(unsigned char byte) {
+    put_char_serial(fmt_hex_digits[byte >> 4]);
+    put_char_serial(fmt_hex_digits[byte & 0x0F]);
 }
 
 /*=============================================================================
@@ -284,22 +317,23 @@ void init_ir(void) {
  |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
  |
  |  Returns: 
- |      Unsigned integer from the CAP2BUF or CAP3BUF, whichever is specified
+ |      Unsigned integer of the last pulse width of the target beacon (see
+ |      bcn_ir()), or from the CAP2BUF or CAP3BUF, whichever is specified,
+ |      in BEACON_RAW builds, or the amplitude of the analog sensor scaled
+ |      alike in IR_ANALOG builds (see adc_ir())
 +============================================================================*/
 
 unsigned int get_ir(unsigned char sensor) {
     // If sensor = 0, for ir3
     // If sensor = 1, for ir2
-    unsigned int ir_value = 0;
-    if (sensor == 0) {
-        ir_value = CAP2BUFL;
-        ir_value += ((unsigned int) CAP2BUFH << 8);
-        return ir_value;
-    } else if (sensor == 1) {
-        ir_value = CAP3BUFL;
-        ir_value += ((unsigned int) CAP3BUFH << 8);
-        return ir_value;
-    }
+#ifdef IR_ANALOG
+    unsigned int value = adc_ir(sensor); // Sampled by the ADC interrupt
+#else
+    unsigned int value = bcn_ir(sensor); // Other beacons ignored
+#endif
+    rpl_ir(sensor, value); // Sensor log, REPLAY_LOG builds only
+    TRACE_MAIN(TR_IR | sensor, value); // Event trace, TRACE builds only
+    return value;
 }
 
 /*=============================================================================
@@ -315,8 +349,9 @@ unsigned int get_ir(unsigned char sensor) {
  |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
  |
  |  Returns:
- |      Unsigned integer that is the average of four consecutive values, or 
- |      zero if every value is the same.
+ |      Unsigned integer that is the average of four consecutive values,
+ |      rounded to nearest (see fix_mean()), or zero if every value is the
+ |      same.
  |
  |  Comments: A delay of 250ms between readings is needed to match the 
  |            broadcasting frequency of the IR transmitter
@@ -324,8 +359,7 @@ unsigned int get_ir(unsigned char sensor) {
 
 unsigned int ir_filter(unsigned char sensor) {
     unsigned char i = 0;
-    unsigned int array[4];
-    unsigned int filtered_ir = 0;
+    uint16_t array[4];
     unsigned char same_values_flag = 1; // Assumption of same values de facto on
     while (i < 4) {
         array[i] = get_ir(sensor); // Acquire and store the eight values in a buffer        
@@ -345,71 +379,177 @@ unsigned int ir_filter(unsigned char sensor) {
         *sensor is probably not reading anything new 
         *and just using the same stored buffer value */
         
-        if (array[i] > 45000) {
-            return array[i];
+        // Saturated readings (strong signal) are kept
+        if (array[3] > 45000) {
+            return array[3];
         } else {
             return 0;
         }
-    } else {
-        // Gets the average of the 8 values and returns it
-        i = 0;
-        while (i < 4) {
-            filtered_ir += (array[i] / 4);
-            i++;
-        }
     }
-    return filtered_ir;
+    // Gets the average of the 4 values and returns it
+    return fix_mean(array, 2);
 
 }
 
 /*=============================================================================
- |  Function init_counter
+ |  Function init_ir_cal
  |
- |  Purpose: init_counter initializes a timer low priority interrupt with a
- |           prescaler value of 1:8 in 8 bit mode, to allow for the interrupt
- |           flag INTCONbits.TMR0IF to be triggered once per milisecond
+ |  Purpose: init_ir_cal sets the IR calibration to unity gain and zero offset
+ |           for both sensors, such that ir_normalise() returns raw readings
  |
  |  Parameters: 
- |      Nothing (No arguments)
+ |      *cal (struct IRCal) - Address of an instance of the IRCal structure
  |
  |  Returns: Nothing (Void function)
 +============================================================================*/
 
-void init_counter() {
-    INTCONbits.TMR0IE = 1; // enable TMR0 overflow interrupt
-    INTCON2bits.TMR0IP = 0; // TMR0 low priority
-    T0CONbits.T016BIT = 1; // 8 bit mode
-    T0CONbits.T0CS = 0; // use internal clock
-    T0CONbits.PSA = 0; // enable prescaler
-    T0CONbits.T0PS = 0b010; // set prescaler value of 1:8 
-    T0CONbits.TMR0ON = 1; //turn on timer0
-    TMR0L = 3; // Timer for 1 mili-second#
+void init_ir_cal(struct IRCal *cal) {
+    cal->gain[0] = 256;
+    cal->gain[1] = 256;
+    cal->offset[0] = 0;
+    cal->offset[1] = 0;
 }
 
 /*=============================================================================
- |  Function init_button
+ |  Function ir_normalise
  |
- |  Purpose: init_button initializes the button on pin C3 of the 
- |           microcontroller, enabling external interrupt on button press
+ |  Purpose: ir_normalise applies the calibration of a sensor to a reading,
+ |           such that both sensors give the same reading for the same signal
  |
  |  Parameters: 
- |      Nothing (No arguments)
+ |      *cal (struct IRCal) - Address of an instance of the IRCal structure
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |      raw (unsigned int) - Reading from get_ir() or ir_filter()
+ |
+ |  Returns:
+ |      Unsigned integer of the normalised reading, limited to 0 - 65535.
+ |      A reading of zero (no signal) is returned as zero.
++============================================================================*/
+
+unsigned int ir_normalise(struct IRCal *cal, unsigned char sensor, unsigned int raw) {
+    long value;
+    if (raw == 0) {
+        return 0;
+    }
+    value = (long) (fix_mul16(raw, cal->gain[sensor]) >> 8);
+    value += cal->offset[sensor];
+    if (value < 1) {
+        value = 1; // Keep a signal distinct from no signal
+    } else if (value > 65535) {
+        value = 65535;
+    }
+    return (unsigned int) value;
+}
+
+/*=============================================================================
+ |  Function fit_ir_cal
+ |
+ |  Purpose: fit_ir_cal fits the gain and offset of one sensor by least 
+ |           squares, such that its normalised readings best match a set of
+ |           target readings
+ |
+ |  Parameters: 
+ |      *raw (unsigned int) - Array of IR_CAL_POINTS readings of the sensor
+ |      *target (unsigned int) - Array of IR_CAL_POINTS target readings
+ |      *gain (unsigned int) - Address to which the gain is written
+ |      *offset (int) - Address to which the offset is written
  |
  |  Returns: Nothing (Void function)
+ |
+ |  Comments: Deviations from the mean are divided by 16 to keep the sums of
+ |            products within a long. The gain is limited to 0.5 - 2, and 
+ |            readings which barely vary give unity gain.
++============================================================================*/
+
+void fit_ir_cal(unsigned int *raw, unsigned int *target, uint16_t *gain, int16_t *offset) {
+    unsigned long sum_x = 0, sum_y = 0;
+    unsigned int mean_x, mean_y;
+    long dx, dy, sxx = 0, sxy = 0, b;
+    unsigned char k;
+
+    for (k = 0; k < IR_CAL_POINTS; k++) {
+        sum_x += raw[k];
+        sum_y += target[k];
+    }
+    mean_x = sum_x / IR_CAL_POINTS;
+    mean_y = sum_y / IR_CAL_POINTS;
+    for (k = 0; k < IR_CAL_POINTS; k++) {
+        dx = ((long) raw[k] - mean_x) / 16;
+        dy = ((long) target[k] - mean_y) / 16;
+        sxx += dx * dx;
+        sxy += dx * dy;
+    }
+
+    if (sxx < 64) {
+        *gain = 256; // Readings barely vary, assume unity gain
+    } else {
+        b = (sxy * 64) / (sxx / 4); // Gain scaled by 256
+        if (b < 128) {
+            b = 128;
+        } else if (b > 512) {
+            b = 512;
+        }
+        *gain = (unsigned int) b;
+    }
+
+    b = (long) mean_y - (long) (((unsigned long) mean_x * *gain) >> 8);
+    if (b < -32767) {
+        b = -32767;
+    } else if (b > 32767) {
+        b = 32767;
+    }
+    *offset = (int) b;
+}
+
+/*=============================================================================
+ |  Function select_mode
+ |
+ |  Purpose: select_mode implements the standby menu. If the button is held
+ |           down when standby is entered, the available modes are cycled on
+ |           the LCD once per second, and releasing the button selects the 
+ |           mode on display
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: 
+ |      Unsigned char of the selected mode (see functions.h), or MODE_STANDBY
+ |      if the button is not held down
+ |
+ |  Comments: The button interrupt is disabled while the menu is open, so that
+ |            holding the button does not toggle between STANDBY and RUN.
 +============================================================================*/
 
-void init_button() {
-    LATC = 0; // Set the output data latch levels to 0 on all pins
-    TRISCbits.RC3 = 1; // Sets pin C3 to input
-    INTCONbits.INT0IE = 1; //INT0 External Interrupt Enable bit 
+unsigned char select_mode(void) {
+    unsigned char mode = MODE_STANDBY;
+    if (hal_button() == 0) {
+        // Button not held, remain in standby
+        return MODE_STANDBY;
+    }
+    hal_button_irq(0); // Button used for menu only
+    while (hal_button() == 1) {
+        // Cycle to next mode, skipping standby
+        mode++;
+        if (mode >= MODE_COUNT) {
+            mode = 1;
+        }
+        clear_lcd();
+        set_line(1);
+        lcd_string(mode_names[mode]);
+        delay_s(1);
+    }
+    hal_button_clear(); // Discard the press used for the menu
+    hal_button_irq(1);
+    return mode;
 }
 
 /*=============================================================================
  |  Function ir_difference
  |
- |  Purpose: ir_difference computes the absolute difference between the two IR
- |           sensors, and sets the direction on the Control structure based
- |           on which IR sensor is larger
+ |  Purpose: ir_difference normalises the two IR readings with the sensor
+ |           calibration, then computes the absolute difference between them
+ |           and the bearing of the beacon, and sets the direction on the
+ |           Control structure based on which IR sensor is larger
  |
  |  Parameters: 
  |      *cont (struct Control) - Address of the instance of the structure
@@ -423,6 +563,12 @@ void init_button() {
 +============================================================================*/
 
 void ir_difference(struct Control *cont, struct DC_motor *motorL, struct DC_motor *motorR) {
+    int bearing;
+
+    // Normalise readings so that both sensors share the same scale
+    cont->ir_left = ir_normalise(&G_params.cal, cont->left_sensor, cont->ir_left);
+    cont->ir_right = ir_normalise(&G_params.cal, !cont->left_sensor, cont->ir_right);
+
     // Get absolute difference between IR sensors
     if (cont->ir_left > cont->ir_right) {
         // IR on left, turn left
@@ -433,6 +579,10 @@ void ir_difference(struct Control *cont, struct DC_motor *motorL, struct DC_moto
         cont->ir_diff = cont->ir_right - cont->ir_left;
         cont->turn_direction = 1;
     }
+
+    // Bearing independent of distance, for the centring decisions
+    bearing = ir_bearing(cont->ir_left, cont->ir_right);
+    cont->bearing = (bearing < 0) ? -bearing : bearing;
 }
 
 /*=============================================================================
@@ -451,18 +601,148 @@ void ir_difference(struct Control *cont, struct DC_motor *motorL, struct DC_moto
 void ir_display(struct Control *cont) {
     // LCD: Line 1
     // LCD: Left IR
-    lcd_string("L");
-    itoa_5(cont->ir_left, cont ->ir_buf);
+    lcd_string(TEXT("L"));
+    fmt_dec(cont->ir_buf, cont->ir_left, 5);
     lcd_string(cont->ir_buf);
     // LCD: Separator
-    lcd_string("|");
+    lcd_string(TEXT("|"));
 
     // LCD: Right IR
-    lcd_string("R");
-    itoa_5(cont->ir_right, cont->ir_buf);
+    lcd_string(TEXT("R"));
+    fmt_dec(cont->ir_buf, cont->ir_right, 5);
     lcd_string(cont->ir_buf);
 }
 
+/*=============================================================================
+ |  Function set_steer_action
+ |
+ |  Purpose: set_steer_action stores a steering action of the RUN, 2 bits
+ |           each, 4 to a byte
+ |
+ |  Parameters: 
+ |      *cont (struct Control) - Address of an instance of the Control 
+ |                               structure
+ |      i (unsigned char) - Index of the action
+ |      action (unsigned char) - 0 (none), 1 (veer left), 2 (veer right) or
+ |                               3 (maintain course), see steer()
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void set_steer_action(struct Control *cont, unsigned char i, unsigned char action) {
+    unsigned char shift = (i & 3) << 1;
+    unsigned char *byte = &cont->phase.steer_action[i >> 2];
+
+    *byte = (*byte & ~(3 << shift)) | (action << shift);
+}
+
+/*=============================================================================
+ |  Function get_steer_action
+ |
+ |  Purpose: get_steer_action returns a steering action stored by 
+ |           set_steer_action()
+ |
+ |  Parameters: 
+ |      *cont (struct Control) - Address of an instance of the Control 
+ |                               structure
+ |      i (unsigned char) - Index of the action
+ |
+ |  Returns:
+ |      Unsigned char of the action, 0 - 3
++============================================================================*/
+
+unsigned char get_steer_action(struct Control *cont, unsigned char i) {
+    return (cont->phase.steer_action[i >> 2] >> ((i & 3) << 1)) & 3;
+}
+
+/*=============================================================================
+ |  Function calibrate_ir
+ |
+ |  Purpose: calibrate_ir samples both IR sensors with the vehicle pointed at
+ |           IR_CAL_POINTS headings either side of the beacon, and fits the
+ |           gain and offset of each sensor such that the two sensors read the
+ |           same at mirrored headings
+ |
+ |  Parameters: 
+ |      *cont (struct Control) - Address of an instance of the Control 
+ |                               structure, for its display buffer and to
+ |                               hold the samples
+ |      *cal (struct IRCal) - Address of the IRCal structure to be fitted
+ |      *rot (struct Rotation) - Address of an instance of the Rotation
+ |                               structure
+ |      *motorL (struct DC_motor) - Address of an instance of the DC_motor 
+ |                                  structure
+ |      *motorR (struct DC_motor) - Address of an instance of the DC_motor 
+ |                                  structure
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The vehicle must start facing the beacon. Sensor 0 at heading
+ |            +x should read the same as sensor 1 at heading -x, so the target
+ |            for each pair is the mean of the two. The calibration is only
+ |            updated if the beacon is seen by both sensors at every heading.
+ |            If the turn rates have not been calibrated, rotate_by() does not
+ |            turn, every sample is taken facing the beacon and only the
+ |            offsets are corrected.
++============================================================================*/
+
+void calibrate_ir(struct Control *cont, struct IRCal *cal, struct Rotation *rot, struct DC_motor *motorL, struct DC_motor *motorR) {
+    // Samples held in place of the steering actions, unused in standby
+    unsigned int *ir0 = cont->phase.cal.ir0, *ir1 = cont->phase.cal.ir1;
+    unsigned int *target = cont->phase.cal.target, *mirror = cont->phase.cal.mirror;
+    unsigned char k;
+    unsigned char valid = 1;
+
+    clear_lcd();
+    set_line(1);
+    lcd_string(TEXT("CAL IR"));
+
+    // Start at one end of the sweep, then step across the beacon
+    rotate_by(rot, motorL, motorR, -IR_CAL_STEP * (IR_CAL_POINTS / 2));
+    for (k = 0; (k < IR_CAL_POINTS) & (G_run == 0); k++) {
+        if (k > 0) {
+            rotate_by(rot, motorL, motorR, IR_CAL_STEP);
+        }
+        __delay_ms(500); // Let the vehicle settle
+        ir0[k] = ir_filter(0);
+        ir1[k] = ir_filter(1);
+        if ((ir0[k] == 0) | (ir1[k] == 0)) {
+            valid = 0; // Beacon lost by a sensor
+        }
+        set_line(2);
+        fmt_dec(cont->ir_buf, k + 1, 5);
+        lcd_string(cont->ir_buf);
+    }
+    // Return to facing the beacon
+    rotate_by(rot, motorL, motorR, -IR_CAL_STEP * (IR_CAL_POINTS / 2));
+
+    clear_lcd();
+    set_line(1);
+    if ((valid == 0) | (G_run == 1)) {
+        lcd_string(TEXT("CAL IR FAIL"));
+        delay_s(2);
+        return;
+    }
+
+    // Fit sensor 0 against the mean of itself and mirrored sensor 1
+    for (k = 0; k < IR_CAL_POINTS; k++) {
+        mirror[k] = ir1[IR_CAL_POINTS - 1 - k];
+        target[k] = (ir0[k] >> 1) + (mirror[k] >> 1);
+    }
+    fit_ir_cal(ir0, target, &cal->gain[0], &cal->offset[0]);
+    fit_ir_cal(mirror, target, &cal->gain[1], &cal->offset[1]);
+
+    // Display gains (256 = 1)
+    lcd_string(TEXT("G0:"));
+    fmt_dec(cont->ir_buf, cal->gain[0], 5);
+    lcd_string(cont->ir_buf);
+    set_line(2);
+    lcd_string(TEXT("G1:"));
+    fmt_dec(cont->ir_buf, cal->gain[1], 5);
+    lcd_string(cont->ir_buf);
+    delay_s(2);
+}
+
 /*=============================================================================
  |  Function orientate
  |
@@ -474,7 +754,7 @@ void ir_display(struct Control *cont) {
  |           1IR = 0 (no readings on one side), turn to side with stronger 
  |           signal for 100ms
  |           3. Target in FOV of both sensors, and centred within threshold
- |           IR difference less than threshold and individual IRs more than 
+ |           Bearing less than threshold and individual IRs more than 
  |           min IR when facing front (centred), finding_direction = 0,
  |           move forward for 5s
  |           4. Target in FOV of both sensors, but not centred within threshold
@@ -501,6 +781,8 @@ void ir_display(struct Control *cont) {
  |            Scenario 1 suffers from having to turn a complete round if the 
  |            target is on the right side of the vehicle. Subsequent revisions
  |            could consider revising scenario 1, to address this issue.
+ |            The forward run ends early once the RFID is retrieved, and its
+ |            duration is stored in run_ms for the return sequence to replay.
  | 
 +============================================================================*/
 
@@ -509,12 +791,12 @@ void orientate(struct Control *cont, struct DC_motor *motorL, struct DC_motor *m
     // Compare individual readings with minimum
     if ((cont ->ir_right == 0) & (cont ->ir_left == 0)) {
         // Both sensors = 0, turn left to check for values
-        lcd_string("2 IRs=0");
+        log_debug("2 IRs=0");
         turn_left(motorL, motorR);
         delay_s(1); // turn left for 1 s
         stop_all(motorL, motorR);
     } else if ((cont->ir_left == 0) | (cont->ir_right == 0)) {
-        lcd_string("1 IR=0");
+        log_debug("1 IR=0");
         // Only one sensor = 0, turn in direction of stronger signal
         if ((cont->turn_direction) == 0) {
             turn_left(motorL, motorR);
@@ -525,29 +807,42 @@ void orientate(struct Control *cont, struct DC_motor *motorL, struct DC_motor *m
             __delay_ms(60); // turn for 60 ms
             stop_all(motorL, motorR);
         }
-    } else if (((cont->ir_diff) < (cont->ir_threshold)) & ((cont->ir_left) > (cont->ir_min)) & ((cont->ir_right) > (cont->ir_min))) {
+    } else if (((cont->bearing) < (G_params.bearing_thr)) & ((cont->ir_left) > (G_params.ir_min)) & ((cont->ir_right) > (G_params.ir_min))) {
         // Robot centred, stop finding direction and start moving
         // Display centred readings for calibration
+#if LOG_LEVEL >= LOG_DEBUG
         set_line(1);
         ir_display(cont);
+#endif
         full_speed(motorL, motorR, 0);
+#if LOG_LEVEL >= LOG_DEBUG
         set_line(2);
-        lcd_string("CTR");
-        delay_s(5); // Move vehicle forward for 5s
+        lcd_string(TEXT("CTR"));
+#endif
+        // Move vehicle forward, 5s by default, unless RFID retrieved
+        cont->run_ms = time_ms();
+        delay_ms_until(G_params.run_s * 1000U, &G_rfid_retrieved);
+        cont->run_ms = time_ms() - cont->run_ms;
+        if (G_estop == 1) {
+            // Cut without the stop_all() ramp, less that of the return
+            // (see the steering actions in main.c)
+            cont->run_ms = (cont->run_ms > G_params.cruise_power) ?
+                    cont->run_ms - G_params.cruise_power : 0;
+        }
         stop_all(motorL, motorR);
         cont->finding_direction = 0; // Leave finding direction loop
     } else {
         // Robot not centred, but close to target
         // Turn by small increments
         if (cont->turn_direction == 0) {
-            lcd_string("L");
+            log_debug("L");
             // Turn left
             turn_left(motorL, motorR);
             __delay_ms(25);
             stop_all(motorL, motorR);
         }
         if (cont->turn_direction == 1) {
-            lcd_string("R");
+            log_debug("R");
             // Turn right
             turn_right(motorL, motorR);
             __delay_ms(25);
@@ -581,25 +876,25 @@ void orientate(struct Control *cont, struct DC_motor *motorL, struct DC_motor *m
 +============================================================================*/
 
 void steer(struct Control *cont, struct DC_motor *motorL, struct DC_motor *motorR) {
-    if ((cont->turn_direction == 1) & (cont->ir_diff > (cont->ir_threshold))) {
+    if ((cont->turn_direction == 1) & (cont->bearing > (G_params.bearing_thr))) {
         // Scenario 1
         // Veer left
-        cont->steer_action[cont->i] = 1;
-        lcd_string(":VL");
+        set_steer_action(cont, cont->i, 1);
+        log_debug(":VL");
         veer_left(motorL, motorR, 0);
 
-    } else if ((cont->turn_direction == 0) & (cont->ir_diff > (cont->ir_threshold))) {
+    } else if ((cont->turn_direction == 0) & (cont->bearing > (G_params.bearing_thr))) {
         // Scenario 2
         // Veer right
-        cont->steer_action[cont->i] = 2;
-        lcd_string(":VR");
+        set_steer_action(cont, cont->i, 2);
+        log_debug(":VR");
         veer_right(motorL, motorR, 0);
 
     } else {
         // Scenario 0
         // Robot centred, maintain course
-        cont->steer_action[cont->i] = 3;
-        lcd_string(":MC");
+        set_steer_action(cont, cont->i, 3);
+        log_debug(":MC");
         full_speed(motorL, motorR, 0);
 
     }
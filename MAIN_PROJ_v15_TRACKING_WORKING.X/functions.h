@@ -28,6 +28,68 @@
 #ifndef FUNCTIONS_H
 #define	FUNCTIONS_H
 
+#include <stdint.h>
+
+struct Rotation; // See rotate_funct.h
+
+// Global variables defined in main.c
+extern volatile unsigned int G_time_ms;
+extern volatile unsigned char G_run;
+extern volatile unsigned char G_rfid_retrieved;
+extern volatile unsigned char G_rfid_valid;
+extern volatile unsigned char G_estop;
+
+// Standby menu modes, selected by select_mode()
+#define MODE_STANDBY 0 // No mode selected, display IR values
+#define MODE_CAL_ROT 1 // Calibrate turn rates (see rotate_funct.c)
+#define MODE_CAL_IR 2 // Calibrate IR sensor gains (see calibrate_ir())
+#define MODE_PARAMS 3 // Edit parameters (see edit_params())
+// Modes of optional subsystems follow, numbered as built
+#ifdef TUNE
+#define MODE_TUNE 4 // Serial tuning protocol (see tune_funct.c)
+#define MODE_OPTIONS 5
+#else
+#define MODE_OPTIONS 4
+#endif
+#ifdef PROFILE
+#define MODE_PROFILE MODE_OPTIONS // Show loop profile (see profile_funct.c)
+#define MODE_COUNT (MODE_OPTIONS + 1)
+#else
+#define MODE_COUNT MODE_OPTIONS
+#endif
+
+#define IR_CAL_POINTS 5 // Number of headings sampled by calibrate_ir()
+#define IR_CAL_STEP 10 // Degrees between headings sampled by calibrate_ir()
+
+#define IR_BUF_SIZE 6 // Five digits and the null byte, see fmt_dec()
+#define STEER_ACTIONS 256 // Slots, 4 per byte. The counter i stores 255 at most
+
+// String literal as the bytes taken by lcd_string() and put_string_serial().
+// Plain char is unsigned with XC8, but still a distinct type from unsigned
+// char
+#define TEXT(s) ((const unsigned char *) (s))
+
+/*=============================================================================
+ |  Structure IRCal
+ |
+ |  Purpose: Per-sensor calibration of the IR sensors, obtained by 
+ |           calibrate_ir() and applied by ir_normalise(). A reading is 
+ |           normalised as (raw * gain / 256) + offset
+ |
+ |  Parameters: 
+ |      gain[2] (uint16_t) - Gain of sensor 0 (IR3) and 1 (IR2), where 256
+ |                           is a gain of 1
+ |      offset[2] (int16_t) - Offset of sensor 0 (IR3) and 1 (IR2)
+ |
+ |  Comments: Fixed width types, as it is stored in the data EEPROM (see
+ |            hal.h).
++============================================================================*/
+
+struct IRCal {
+    uint16_t gain[2];
+    int16_t offset[2];
+};
+
 /*=============================================================================
  |  Structure Control
  |
@@ -39,49 +101,77 @@
  |      ir_right (unsigned int) - Value of right IR intensity
  |      ir_diff (unsigned int) - Value of absolute difference between
  |                               left and right IRs
- |      turn_direction (unsigned char) - 0 (left), 1 (right)
- |      ir_threshold (unsigned int) - Value of IR difference within which
- |                                    vehicle can be considered to be centred.
- |                                    To be calibrated via experiments
- |      ir_min (unsigned int) - Minimum value of IR intensity to be considered 
- |                              as a frontal source. To be calibrated via 
- |                              experiments
- |      ir_buf[16] - Buffer used to display IR readings
+ |      bearing (unsigned int) - Absolute bearing of the beacon in tenths
+ |                               of a degree (see ir_bearing()), to the side
+ |                               given by turn_direction
+ |      turn_direction (1 bit) - 0 (left), 1 (right)
+ |      left_sensor (1 bit) - Sensor (0 or 1) read into ir_left, the other
+ |                            sensor being read into ir_right
+ |      finding_direction (1 bit) - Flag for control within while RFID not
+ |                                  found loop
+ |      ir_buf[IR_BUF_SIZE] - Buffer used to display IR readings
  |      i (unsigned char) - Arbitrary counter for use in control 
- |      finding_direction (unsigned char) - Flag for control within while 
- |                                          RFID not found loop
- |      steer_action[220] (unsigned char) - Buffer to store steering actions
+ |      run_ms (unsigned int) - Time driven by the forward run of orientate(),
+ |                              in ms, for the return sequence
+ |      phase (union) - State of one phase only:
+ |          steer_action[] (unsigned char) - Steering actions of a RUN, 2
+ |                                           bits each (see set_steer_action())
+ |          cal - Samples of calibrate_ir(), in standby
+ |
+ |  Comments: Values which are tuned via experiments (gain, bearing_thr, 
+ |            ir_min and the IR sensor calibration) are held in G_params, see
+ |            eeprom_funct.h. The steering actions are cleared at the start of
+ |            each RUN, as the standby menu writes over them.
 +============================================================================*/
 
 struct Control { 
     unsigned int ir_left;
     unsigned int ir_right;
     unsigned int ir_diff;
-    unsigned char turn_direction;
-    unsigned int ir_threshold;
-    unsigned char gain;
-    unsigned int time_to_turn;
-    unsigned int ir_min;
-    unsigned char ir_buf[16];
+    unsigned int bearing;
+    unsigned turn_direction : 1;
+    unsigned left_sensor : 1;
+    unsigned finding_direction : 1;
+    unsigned char ir_buf[IR_BUF_SIZE];
     unsigned char i;
-    unsigned char finding_direction;
-    unsigned char steer_action[220];
+    unsigned int run_ms;
+
+    union {
+        unsigned char steer_action[STEER_ACTIONS / 4];
+
+        struct {
+            unsigned int ir0[IR_CAL_POINTS], ir1[IR_CAL_POINTS];
+            unsigned int target[IR_CAL_POINTS], mirror[IR_CAL_POINTS];
+        } cal;
+    } phase;
 };
 
 void init_serial(void);
 void delay_s(char seconds);
+unsigned int time_ms(void);
+void delay_ms(unsigned int ms);
+void delay_ms_until(unsigned int ms, volatile unsigned char *flag);
 char get_char_serial(void);
-void get_packet_serial(char *packet);
+void get_packet_serial(volatile unsigned char *packet);
+unsigned char rfid_valid(volatile unsigned char *packet);
+void put_char_serial(char c);
+void put_string_serial(const unsigned char *string);
+void put_hex(unsigned char byte);
 void init_interrupt(void);
 void init_ir(void);
+void init_adc(void);
 unsigned int get_ir(unsigned char sensor);
 unsigned int ir_filter(unsigned char sensor);
-void itoa_5(unsigned int number, unsigned char* buffer);
-int power(int number, int power);
+void init_ir_cal(struct IRCal *cal);
+unsigned int ir_normalise(struct IRCal *cal, unsigned char sensor, unsigned int raw);
 void init_counter(void);
 void init_button(void);
+unsigned char select_mode(void);
 void ir_difference(struct Control *cont, struct DC_motor *motorL, struct DC_motor *motorR);
 void ir_display(struct Control *cont);
+void set_steer_action(struct Control *cont, unsigned char i, unsigned char action);
+unsigned char get_steer_action(struct Control *cont, unsigned char i);
+void calibrate_ir(struct Control *cont, struct IRCal *cal, struct Rotation *rot, struct DC_motor *motorL, struct DC_motor *motorR);
 void orientate(struct Control *cont, struct DC_motor *motorL, struct DC_motor *motorR);
 void steer(struct Control *cont, struct DC_motor *motorL, struct DC_motor *motorR);
 
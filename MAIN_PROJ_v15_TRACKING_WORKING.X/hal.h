@@ -0,0 +1,251 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the hardware abstraction layer, through which every
+ |               other file accesses the special function registers. It
+ |               covers the capture inputs, ADC, PWM, GPIO, UART, timers, delays,
+ |               data EEPROM and interrupts.
+ |
+ |               With XC8 every access is a macro on the register itself, so
+ |               the firmware compiles to the same code as before. The init_
+ |               functions which configure the peripherals are in hal_pic.c.
+ |
+ |               With any other compiler (gcc or clang on Linux), the same
+ |               names are implemented by hal_host.c on a simulated vehicle,
+ |               such that main.c and the control code compile unchanged and
+ |               run at host speed (see "make host" in the Makefile). Note
+ |               that unsigned int is 32 bits on the host, so values stored in
+ |               the data EEPROM use the fixed width types of stdint.h.
+ +===========================================================================*/
+
+#ifndef HAL_H
+#define	HAL_H
+
+#include <stdint.h>
+
+#ifdef __XC8
+#include <xc.h>
+
+#define _XTAL_FREQ 8000000 // For an 8MHz clock frequency, used by __delay_ms
+
+// Interrupts
+#define HAL_ISR_HIGH __interrupt(high_priority)
+#define HAL_ISR_LOW __interrupt(low_priority)
+#define hal_irq_off() (INTCONbits.GIEH = 0) // All interrupts
+#define hal_irq_on() (INTCONbits.GIEH = 1)
+#define hal_irq_low_off() (INTCONbits.GIEL = 0) // Low priority interrupts
+#define hal_irq_low_on() (INTCONbits.GIEL = 1)
+#define hal_reset_cause() RCON
+
+// Watchdog, enabled by software as WDTEN is off in the configuration bits.
+// Times out after 2 s (WDPS = 512, see main.c)
+#define hal_wdt_enable(on) (WDTCONbits.SWDTEN = (on))
+#define hal_wdt_clear() CLRWDT()
+#define HAL_PERSISTENT __persistent // Not cleared at start up
+
+// TIMER0, 1 ms tick on the low priority interrupt (see init_counter())
+#define hal_tick_flag() INTCONbits.TMR0IF
+#define hal_tick_clear() (TMR0L = 3, INTCONbits.TMR0IF = 0) // Count 3 - 255
+#define HAL_TICK_US 1012 // 253 counts of 4 us
+
+// TIMER5, free running at 1 us per count (see init_ir()). TMR5H is latched
+// when TMR5L is read, so hal_timer_us() (see hal_pic.c) reads TMR5L first.
+// Its overflow flag extends it to 32 bits (see capture_funct.c)
+uint16_t hal_timer_us(void);
+#define hal_timer_wrap_flag() PIR3bits.TMR5IF
+#define hal_timer_wrap_clear() (PIR3bits.TMR5IF = 0)
+
+// Capture, sensor 0 (CAP2, IR3) or 1 (CAP3, IR2) (see init_ir()), in the
+// mode HAL_CAP_MODE. The input is low while a pulse is received.
+// hal_capture() (see hal_pic.c) reads the low byte of the buffer first
+unsigned int hal_capture(unsigned char sensor);
+#define hal_capture_pin(sensor) ((sensor) == 0 ? PORTAbits.RA3 : \
+        PORTAbits.RA4)
+#define hal_capture_flag(sensor) ((sensor) == 0 ? PIR3bits.IC2QEIF : \
+        PIR3bits.IC3DRIF) // Set on every capture
+#define hal_capture_clear(sensor) do { \
+        if ((sensor) == 0) PIR3bits.IC2QEIF = 0; \
+        else PIR3bits.IC3DRIF = 0; \
+    } while (0)
+
+// ADC (see init_adc()), the supply on AN2, and sensor 0 on AN0 and 1 on
+// AN1 of IR_ANALOG builds. Each hal_adc_read() (see hal_pic.c) pops a word
+// of the FIFO, in the order of the channels converted
+#define hal_adc_flag() PIR1bits.ADIF // Set as the FIFO fills
+#define hal_adc_clear() (PIR1bits.ADIF = 0)
+uint16_t hal_adc_read(void);
+#define hal_adc_empty() ADCON1bits.BFEMT
+#define hal_adc_overflow() ADCON1bits.BFOVFL // A word was lost
+#define hal_adc_overflow_clear() (ADCON1bits.BFOVFL = 0)
+#define hal_adc_start() (ADCON0bits.ADON = 1, ADCON0bits.GO = 1)
+#define hal_adc_stop() (ADCON0bits.ADON = 0) // Aborts the conversion
+
+// PWM duty registers of channel 0 or 1, for struct DC_motor (see init_pwm())
+#define hal_pwm_duty_low(channel) ((unsigned char *) &PDC##channel##L)
+#define hal_pwm_duty_high(channel) ((unsigned char *) &PDC##channel##H)
+
+// GPIO
+#define hal_motor_dir(pin, level) ((level) ? \
+        (LATB = LATB | (1 << (pin))) : (LATB = LATB & (~(1 << (pin)))))
+#define hal_motor_dir_get(pin) ((LATB >> (pin)) & 1)
+#define hal_button() PORTCbits.RC3 // 1 while held
+#define hal_button_flag() INTCONbits.INT0IF
+#define hal_button_clear() (INTCONbits.INT0IF = 0)
+#define hal_button_irq(enable) (INTCONbits.INT0IE = (enable))
+#define hal_lcd_e(level) (LATCbits.LATC0 = (level))
+#define hal_lcd_rs(level) (LATAbits.LATA6 = (level))
+#define hal_lcd_data(nibble) (LATCbits.LATC1 = (nibble) & 1, \
+        LATCbits.LATC2 = ((nibble) & 2) >> 1, \
+        LATDbits.LATD0 = ((nibble) & 4) >> 2, \
+        LATDbits.LATD1 = ((nibble) & 8) >> 3)
+
+// UART (see init_serial())
+#define hal_uart_rx_flag() PIR1bits.RCIF
+#define hal_uart_rx() RCREG
+#define hal_uart_tx_flag() PIR1bits.TXIF
+#define hal_uart_tx(byte) (TXREG = (byte))
+#define hal_uart_tx_irq(enable) (PIE1bits.TXIE = (enable))
+#define hal_uart_tx_irq_enabled() PIE1bits.TXIE
+#define hal_uart_tx_irq_low() (IPR1bits.TXIP = 0)
+
+// Data EEPROM. A write takes approximately 4 ms, while hal_ee_busy() is 1
+#define hal_ee_busy() EECON1bits.WR
+#define hal_ee_read(address) (EEADR = (address), EECON1bits.EEPGD = 0, \
+        EECON1bits.CFGS = 0, EECON1bits.RD = 1, EEDATA)
+#define hal_ee_write(address, data) do { \
+        EEADR = (address); \
+        EEDATA = (data); \
+        EECON1bits.EEPGD = 0; \
+        EECON1bits.CFGS = 0; \
+        EECON1bits.WREN = 1; \
+        INTCONbits.GIEH = 0; /* Disable interrupts for unlock sequence */ \
+        EECON2 = 0x55; \
+        EECON2 = 0xAA; \
+        EECON1bits.WR = 1; \
+        INTCONbits.GIEH = 1; \
+        EECON1bits.WREN = 0; \
+    } while (0)
+
+// Nothing to do while waiting (see hal_host.c)
+#define hal_idle() ((void) 0)
+
+#else
+// Host implementation, see hal_host.c for the simulated vehicle
+
+#define HAL_ISR_HIGH
+#define HAL_ISR_LOW
+#define __delay_ms(ms) hal_delay_us(1000UL * (ms))
+#define __delay_us(us) hal_delay_us(us)
+
+void hal_delay_us(unsigned long us);
+void hal_irq_off(void);
+void hal_irq_on(void);
+void hal_irq_low_off(void);
+void hal_irq_low_on(void);
+unsigned char hal_reset_cause(void);
+void hal_wdt_enable(unsigned char on);
+void hal_wdt_clear(void);
+#define HAL_PERSISTENT
+unsigned char hal_tick_flag(void);
+void hal_tick_clear(void);
+#define HAL_TICK_US 1000 // Simulated tick (see host_advance())
+uint16_t hal_timer_us(void);
+unsigned char hal_timer_wrap_flag(void);
+void hal_timer_wrap_clear(void);
+unsigned int hal_capture(unsigned char sensor);
+unsigned char hal_capture_pin(unsigned char sensor);
+unsigned char hal_capture_flag(unsigned char sensor);
+void hal_capture_clear(unsigned char sensor);
+unsigned char hal_adc_flag(void);
+void hal_adc_clear(void);
+uint16_t hal_adc_read(void);
+unsigned char hal_adc_empty(void);
+unsigned char hal_adc_overflow(void);
+void hal_adc_overflow_clear(void);
+void hal_adc_start(void);
+void hal_adc_stop(void);
+extern unsigned char hal_pwm_duty[2][2]; // Low and high byte per channel
+#define hal_pwm_duty_low(channel) (&hal_pwm_duty[channel][0])
+#define hal_pwm_duty_high(channel) (&hal_pwm_duty[channel][1])
+void hal_motor_dir(unsigned char pin, unsigned char level);
+unsigned char hal_motor_dir_get(unsigned char pin);
+unsigned char hal_button(void);
+unsigned char hal_button_flag(void);
+void hal_button_clear(void);
+void hal_button_irq(unsigned char enable);
+void hal_lcd_e(unsigned char level);
+void hal_lcd_rs(unsigned char level);
+void hal_lcd_data(unsigned char nibble);
+unsigned char hal_uart_rx_flag(void);
+unsigned char hal_uart_rx(void);
+unsigned char hal_uart_tx_flag(void);
+void hal_uart_tx(unsigned char byte);
+void hal_uart_tx_irq(unsigned char enable);
+unsigned char hal_uart_tx_irq_enabled(void);
+void hal_uart_tx_irq_low(void);
+unsigned char hal_ee_busy(void);
+unsigned char hal_ee_read(unsigned char address);
+void hal_ee_write(unsigned char address, unsigned char data);
+void hal_idle(void);
+
+// Simulated vehicle, for simulators built on the host implementation
+extern unsigned long hal_host_us; // Simulated time since power up, in us
+extern unsigned int (*hal_host_capture_fn)(unsigned char sensor); // CAPxBUF
+extern uint16_t (*hal_host_adc_fn)(unsigned char channel); // ANx, 0 - 1023
+extern void (*hal_host_ms_fn)(void); // Called every simulated ms
+extern void (*hal_host_lcd_fn)(void); // Called on every LCD command or char
+extern void (*hal_host_uart_tx_fn)(unsigned char byte); // Else to stdout
+extern unsigned char hal_host_eeprom[256];
+extern unsigned char hal_host_lcd[2][41]; // Text on each line (40 columns)
+extern unsigned char hal_host_latb; // Motor direction pins
+extern unsigned char hal_host_cap_mode; // CAPxM set by init_ir(), else 0
+extern unsigned char hal_host_cap_pin[2]; // RA3 and RA4, 1 unless a pulse
+void hal_host_button(unsigned char level);
+void hal_host_captured(unsigned char sensor); // Sets the capture flag
+void hal_host_uart_feed(unsigned char byte);
+
+#endif
+
+// Bit of hal_reset_cause() (RCON TO) cleared by a watchdog time out
+#define HAL_RESET_TO 0x08
+
+// Capture mode (CAPxM) of both IR sensors: TMR5 on every edge, taken by
+// capture_funct.c, or with BEACON_RAW the pulse width, TMR5 from the
+// falling to the rising edge, as read by get_ir() directly. The edges are
+// only taken with the beacon tracker built in (BEACON_TRACK), which
+// IR_ANALOG builds are not, as they sample analog sensors instead (see
+// adc_funct.h), with no edges to track
+#if (!defined(BEACON_TRACK) || defined(IR_ANALOG)) && !defined(BEACON_RAW)
+#define BEACON_RAW
+#endif
+#define HAL_CAP_EDGES 0x01
+#define HAL_CAP_WIDTH 0x06
+#ifdef BEACON_RAW
+#define HAL_CAP_MODE HAL_CAP_WIDTH
+#else
+#define HAL_CAP_MODE HAL_CAP_EDGES
+#endif
+
+void hal_init_clock(void);
+void hal_init_lcd(void);
+
+#endif
@@ -0,0 +1,753 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make host")
+ |  Microchip: PIC18F4331 (simulated)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the host side of the hardware
+ |               abstraction layer, which runs the firmware on Linux against a
+ |               simulated PIC18F4331. Time is simulated rather than real: it
+ |               advances by the requested amount in every delay, and by
+ |               HAL_HOST_ACCESS_US on every register access, so busy waits
+ |               terminate. The interrupt functions hp_rfid() and lp_timer()
+ |               of main.c are called whenever their flags are set and the
+ |               interrupt is enabled, with the priorities of the PIC.
+ |
+ |               The vehicle is modelled through the hal_host_ hooks declared
+ |               in hal.h, as done by the simulator in sim/sim.c. Left alone,
+ |               no beacon is seen and the button is not pressed. The following environment variables allow the
+ |               program to be run on its own:
+ |               EOD_HOST_MS - Exit after this many simulated ms
+ |               EOD_HOST_BUTTON - Press the button at these simulated ms,
+ |                                 separated by commas
+ |               EOD_HOST_LCD - If set, print every change of the LCD
+ |               EOD_HOST_EEPROM - File holding the data EEPROM
+ +===========================================================================*/
+#include "hal.h"
+#ifndef __XC8
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dc_motor_struct.h"
+#include "functions.h"
+
+#define HAL_HOST_ACCESS_US 10 // Simulated time taken by each register access,
+                              // approximately one poll loop at 2 MIPS
+#define HAL_HOST_UART_US 1042 // One byte at 9600 baud
+#define HAL_HOST_RX_SIZE 256 // Received bytes waiting for hp_rfid()
+#define HAL_HOST_PRESSES 16
+#define HAL_HOST_PRESS_MS 100 // Duration of each button press
+#define HAL_HOST_WDT_MS 2048 // Watchdog period, 4 ms with WDPS = 512
+#define HAL_HOST_ADC_WORDS 4 // ADC FIFO, interrupting when full
+
+void hp_rfid(void); // Interrupt functions, see main.c
+void lp_timer(void);
+void main(void); // Called again on a watchdog reset
+unsigned char host_rx_ready(void);
+
+// Simulated time and vehicle, see hal.h
+unsigned long hal_host_us = 0;
+unsigned int (*hal_host_capture_fn)(unsigned char sensor) = 0;
+uint16_t (*hal_host_adc_fn)(unsigned char channel) = 0;
+void (*hal_host_ms_fn)(void) = 0;
+void (*hal_host_lcd_fn)(void) = 0;
+void (*hal_host_uart_tx_fn)(unsigned char byte) = 0;
+unsigned char hal_host_eeprom[256];
+unsigned char hal_host_lcd[2][41];
+unsigned char hal_host_latb = 0;
+unsigned char hal_host_cap_mode = 0;
+unsigned char hal_host_cap_pin[2] = {1, 1};
+unsigned char hal_pwm_duty[2][2];
+
+// Interrupt state
+unsigned char host_gieh = 0;
+unsigned char host_giel = 0;
+unsigned char host_level = 0; // 0 main program, 1 low, 2 high priority
+unsigned char host_tick_on = 0;
+unsigned char host_tick_flag = 0;
+unsigned long host_next_tick = 1000;
+unsigned char host_button = 0;
+unsigned char host_int0_ie = 0;
+unsigned char host_int0_flag = 0;
+unsigned char host_cap_flag[2] = {0, 0};
+unsigned char host_cap_ie = 0; // Capture and TMR5 overflow interrupts
+unsigned long host_t5_seen = 0; // TMR5 overflows when its flag was cleared
+unsigned char host_adc_on = 0; // Converting
+unsigned char host_adc_loop = 0; // Continuous loop, else single shot
+unsigned char host_adc_first = 0; // Channels converted, in order
+unsigned char host_adc_last = 0;
+unsigned long host_adc_us = 0; // Time taken by the channels
+unsigned char host_adc_ie = 0;
+unsigned char host_adc_flag = 0;
+unsigned char host_adc_lost = 0; // BFOVFL
+unsigned long host_adc_next = 0; // Time at which the channels are done
+uint16_t host_adc_fifo[HAL_HOST_ADC_WORDS];
+unsigned char host_adc_out = 0; // Next word read
+unsigned char host_adc_count = 0; // Words held
+unsigned char host_rc_ie = 0;
+unsigned char host_tx_ie = 0;
+unsigned long host_tx_free = 0; // Time at which TXREG is empty again
+unsigned char host_rcon = 0x1C; // RCON after power on reset
+unsigned char host_wdt_on = 0;
+unsigned long host_wdt_ms = 0; // Time of the last hal_wdt_clear()
+
+// Received bytes, each available from its time in host_rx_us
+unsigned char host_rx[HAL_HOST_RX_SIZE];
+unsigned long host_rx_us[HAL_HOST_RX_SIZE];
+unsigned int host_rx_in = 0;
+unsigned int host_rx_out = 0;
+
+// LCD controller, decoded from the pins
+unsigned char host_lcd_e = 0;
+unsigned char host_lcd_rs = 0;
+unsigned char host_lcd_nibble = 0;
+unsigned char host_lcd_4bit = 0;
+unsigned char host_lcd_high = 0;
+unsigned char host_lcd_half = 0; // 1 when high nibble received
+unsigned char host_lcd_row = 0;
+unsigned char host_lcd_col = 0;
+unsigned char host_lcd_shown[2][41]; // Text last printed for EOD_HOST_LCD
+
+// Environment
+unsigned long host_limit_ms = 0;
+unsigned long host_presses[HAL_HOST_PRESSES];
+unsigned char host_press_count = 0;
+unsigned char host_lcd_print = 0;
+const char *host_eeprom_file = 0;
+unsigned char host_started = 0;
+
+/*=============================================================================
+ |  Function host_start
+ |
+ |  Purpose: host_start reads the environment variables and the data EEPROM
+ |           file, once at power up
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void host_start(void) {
+    const char *env;
+    FILE *file;
+
+    host_started = 1;
+    host_int0_flag = 0; // Power on reset, a button held from power up is no edge
+    memset(hal_host_eeprom, 0xFF, sizeof (hal_host_eeprom)); // Erased
+    memset(hal_host_lcd, ' ', sizeof (hal_host_lcd));
+    memset(host_lcd_shown, ' ', sizeof (host_lcd_shown));
+    hal_host_lcd[0][40] = 0;
+    hal_host_lcd[1][40] = 0;
+
+    env = getenv("EOD_HOST_MS");
+    if (env != 0) {
+        host_limit_ms = strtoul(env, 0, 10);
+    }
+    env = getenv("EOD_HOST_BUTTON");
+    while ((env != 0) && (*env != 0) && (host_press_count < HAL_HOST_PRESSES)) {
+        char *end;
+        host_presses[host_press_count++] = strtoul(env, &end, 10);
+        env = (*end == ',') ? end + 1 : 0;
+    }
+    host_lcd_print = getenv("EOD_HOST_LCD") != 0;
+    host_eeprom_file = getenv("EOD_HOST_EEPROM");
+    if (host_eeprom_file != 0) {
+        file = fopen(host_eeprom_file, "rb");
+        if (file != 0) {
+            fread(hal_host_eeprom, 1, sizeof (hal_host_eeprom), file);
+            fclose(file);
+        }
+    }
+}
+
+/*=============================================================================
+ |  Function host_exit
+ |
+ |  Purpose: host_exit prints the LCD and ends the program, once the time
+ |           given by EOD_HOST_MS has been simulated
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void host_exit(void) {
+    printf("[%lu ms] LCD |%.16s|\n", hal_host_us / 1000, hal_host_lcd[0]);
+    printf("[%lu ms] LCD |%.16s|\n", hal_host_us / 1000, hal_host_lcd[1]);
+    exit(0);
+}
+
+/*=============================================================================
+ |  Function host_reset
+ |
+ |  Purpose: host_reset resets the PIC on a watchdog time out, restarting
+ |           the program from main() with the peripherals off
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Program restarted)
+ |
+ |  Comments: The stack of the program which stalled is left as it is, since
+ |            main() never returns. Global variables keep their values, as
+ |            HAL_PERSISTENT ones would on the PIC.
++============================================================================*/
+
+void host_reset(void) {
+    fprintf(stderr, "[%lu ms] watchdog reset\n", hal_host_us / 1000);
+    host_rcon = 0x1C & ~HAL_RESET_TO;
+    host_gieh = 0;
+    host_giel = 0;
+    host_level = 0;
+    host_tick_on = 0;
+    host_int0_ie = 0;
+    host_cap_flag[0] = 0;
+    host_cap_flag[1] = 0;
+    host_cap_ie = 0;
+    hal_host_cap_mode = 0;
+    host_adc_on = 0;
+    host_adc_ie = 0;
+    host_adc_flag = 0;
+    host_adc_lost = 0;
+    host_adc_count = 0;
+    host_rc_ie = 0;
+    host_tx_ie = 0;
+    host_wdt_on = 0;
+    memset(hal_pwm_duty, 0, sizeof (hal_pwm_duty));
+    hal_host_latb = 0;
+    main();
+}
+
+/*=============================================================================
+ |  Function host_dispatch
+ |
+ |  Purpose: host_dispatch calls the interrupt functions whose flags are set
+ |           and which are enabled, as the PIC would
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The high priority interrupt may interrupt the low priority one,
+ |            but neither interrupts itself.
++============================================================================*/
+
+void host_dispatch(void) {
+    unsigned char level = host_level;
+
+    if (host_gieh == 0) {
+        return;
+    }
+    if ((host_level < 2) &&
+            ((host_rc_ie && host_rx_ready()) | (host_int0_ie & host_int0_flag))) {
+        host_level = 2;
+        hp_rfid();
+        host_level = level;
+    }
+    if ((host_level == 0) & host_giel &&
+            ((host_tick_on & host_tick_flag) | (host_tx_ie && (hal_host_us >= host_tx_free)) |
+            (host_cap_ie & (host_cap_flag[0] | host_cap_flag[1] | hal_timer_wrap_flag())) |
+            (host_adc_ie & host_adc_flag))) {
+        host_level = 1;
+        lp_timer();
+        host_level = 0;
+    }
+}
+
+/*=============================================================================
+ |  Function host_adc
+ |
+ |  Purpose: host_adc samples the channels converted by now into the FIFO,
+ |           through hal_host_adc_fn, once or in a loop as set by init_adc()
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The interrupt flag is set as the FIFO fills. A word sampled
+ |            while it is full is lost, and sets the overflow flag, as on
+ |            the PIC.
++============================================================================*/
+
+void host_adc(void) {
+    unsigned char channel;
+    uint16_t sample;
+
+    while (host_adc_on && (host_adc_next <= hal_host_us)) {
+        host_adc_next += host_adc_us;
+        host_adc_on = host_adc_loop;
+        for (channel = host_adc_first; channel <= host_adc_last; channel++) {
+            sample = (hal_host_adc_fn != 0) ? hal_host_adc_fn(channel) : 0;
+            if (host_adc_count == HAL_HOST_ADC_WORDS) {
+                host_adc_lost = 1;
+                continue;
+            }
+            host_adc_fifo[(host_adc_out + host_adc_count) % HAL_HOST_ADC_WORDS] = sample;
+            if (++host_adc_count == HAL_HOST_ADC_WORDS) {
+                host_adc_flag = 1;
+            }
+        }
+    }
+}
+
+/*=============================================================================
+ |  Function host_advance
+ |
+ |  Purpose: host_advance advances simulated time, raising the TIMER0 tick,
+ |           pressing the button as given by EOD_HOST_BUTTON, resetting on a
+ |           watchdog time out and calling the interrupt functions on the way
+ |
+ |  Parameters:
+ |      us (unsigned long) - Simulated time to advance by, in us
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void host_advance(unsigned long us) {
+    unsigned long end;
+    unsigned long ms;
+    unsigned char k;
+
+    if (host_started == 0) {
+        host_start();
+    }
+    end = hal_host_us + us;
+    while (host_next_tick <= end) {
+        hal_host_us = host_next_tick;
+        host_next_tick += 1000;
+        ms = hal_host_us / 1000;
+        host_tick_flag = 1;
+        for (k = 0; k < host_press_count; k++) {
+            if (ms == host_presses[k]) {
+                hal_host_button(1);
+            } else if (ms == host_presses[k] + HAL_HOST_PRESS_MS) {
+                hal_host_button(0);
+            }
+        }
+        if (hal_host_ms_fn != 0) {
+            hal_host_ms_fn();
+        }
+        host_adc();
+        if ((host_limit_ms != 0) && (ms >= host_limit_ms)) {
+            host_exit();
+        }
+        if (host_wdt_on && (ms - host_wdt_ms >= HAL_HOST_WDT_MS)) {
+            host_reset();
+        }
+        host_dispatch();
+    }
+    hal_host_us = end;
+    host_adc();
+    host_dispatch();
+}
+
+/*=============================================================================
+ |  Function host_lcd_byte
+ |
+ |  Purpose: host_lcd_byte applies a command or character sent to the LCD to
+ |           the text held in hal_host_lcd
+ |
+ |  Parameters:
+ |      byte (unsigned char) - Command or character
+ |      rs (unsigned char) - Command (0) or Data/Char (1)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Only the commands used by lcd_funct.c are decoded, after which
+ |            hal_host_lcd_fn is called. With EOD_HOST_LCD set, lines which
+ |            have changed are printed on every command, i.e. once the text
+ |            before it is complete.
++============================================================================*/
+
+void host_lcd_byte(unsigned char byte, unsigned char rs) {
+    unsigned char row;
+
+    if ((rs == 0) & host_lcd_print) {
+        for (row = 0; row < 2; row++) {
+            if (memcmp(host_lcd_shown[row], hal_host_lcd[row], 16) != 0) {
+                memcpy(host_lcd_shown[row], hal_host_lcd[row], 16);
+                printf("[%lu ms] LCD%u |%.16s|\n", hal_host_us / 1000,
+                        row + 1, hal_host_lcd[row]);
+            }
+        }
+    }
+    if (rs == 1) {
+        if (host_lcd_col < 40) {
+            hal_host_lcd[host_lcd_row][host_lcd_col++] = byte;
+        }
+    } else if (byte == 1) {
+        // Display clear
+        memset(hal_host_lcd[0], ' ', 40);
+        memset(hal_host_lcd[1], ' ', 40);
+        host_lcd_row = 0;
+        host_lcd_col = 0;
+    } else if (byte & 0x80) {
+        // Set DDRAM address
+        host_lcd_row = (byte & 0x40) ? 1 : 0;
+        host_lcd_col = byte & 0x3F;
+    }
+    if (hal_host_lcd_fn != 0) {
+        hal_host_lcd_fn();
+    }
+}
+
+/*=============================================================================
+ |  Function host_rx_ready
+ |
+ |  Purpose: host_rx_ready returns 1 if a received byte is waiting, i.e. the
+ |           RCIF flag
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      Unsigned char, 1 if a byte is waiting
++============================================================================*/
+
+unsigned char host_rx_ready(void) {
+    return (host_rx_in != host_rx_out) && (host_rx_us[host_rx_out] <= hal_host_us);
+}
+
+// Simulated vehicle, see hal.h
+
+void hal_host_button(unsigned char level) {
+    if ((level == 1) & (host_button == 0)) {
+        host_int0_flag = 1; // INT0 on rising edge
+    }
+    host_button = level;
+}
+
+void hal_host_captured(unsigned char sensor) {
+    host_cap_flag[sensor & 1] = 1;
+}
+
+void hal_host_uart_feed(unsigned char byte) {
+    unsigned int prev = (host_rx_in - 1) % HAL_HOST_RX_SIZE;
+    unsigned long at = hal_host_us + HAL_HOST_UART_US;
+
+    if ((host_rx_in + 1) % HAL_HOST_RX_SIZE == host_rx_out) {
+        return; // Overrun
+    }
+    if ((host_rx_in != host_rx_out) && (host_rx_us[prev] + HAL_HOST_UART_US > at)) {
+        at = host_rx_us[prev] + HAL_HOST_UART_US; // After previous byte
+    }
+    host_rx[host_rx_in] = byte;
+    host_rx_us[host_rx_in] = at;
+    host_rx_in = (host_rx_in + 1) % HAL_HOST_RX_SIZE;
+}
+
+// Hardware abstraction layer, see hal.h
+
+void hal_delay_us(unsigned long us) {
+    host_advance(us);
+}
+
+void hal_irq_off(void) {
+    host_gieh = 0;
+}
+
+void hal_irq_on(void) {
+    host_gieh = 1;
+    host_advance(HAL_HOST_ACCESS_US);
+}
+
+void hal_irq_low_off(void) {
+    host_giel = 0;
+}
+
+void hal_irq_low_on(void) {
+    host_giel = 1;
+    host_advance(HAL_HOST_ACCESS_US);
+}
+
+unsigned char hal_reset_cause(void) {
+    return host_rcon;
+}
+
+void hal_wdt_enable(unsigned char on) {
+    host_wdt_on = on;
+}
+
+void hal_wdt_clear(void) {
+    host_wdt_ms = hal_host_us / 1000;
+    host_rcon |= HAL_RESET_TO;
+}
+
+unsigned char hal_tick_flag(void) {
+    return host_tick_flag;
+}
+
+void hal_tick_clear(void) {
+    host_tick_flag = 0;
+}
+
+uint16_t hal_timer_us(void) {
+    host_advance(HAL_HOST_ACCESS_US);
+    return (uint16_t) hal_host_us;
+}
+
+unsigned char hal_timer_wrap_flag(void) {
+    return (hal_host_us >> 16) != host_t5_seen; // Set as TMR5 wraps
+}
+
+void hal_timer_wrap_clear(void) {
+    host_t5_seen = hal_host_us >> 16;
+}
+
+unsigned int hal_capture(unsigned char sensor) {
+    host_advance(HAL_HOST_ACCESS_US);
+    if (hal_host_capture_fn != 0) {
+        return hal_host_capture_fn(sensor);
+    }
+    return 0; // No beacon
+}
+
+unsigned char hal_capture_pin(unsigned char sensor) {
+    return hal_host_cap_pin[sensor & 1];
+}
+
+unsigned char hal_capture_flag(unsigned char sensor) {
+    return host_cap_flag[sensor & 1];
+}
+
+void hal_capture_clear(unsigned char sensor) {
+    host_cap_flag[sensor & 1] = 0;
+}
+
+unsigned char hal_adc_flag(void) {
+    return host_adc_flag;
+}
+
+void hal_adc_clear(void) {
+    host_adc_flag = 0;
+}
+
+uint16_t hal_adc_read(void) {
+    uint16_t sample = 0;
+
+    host_advance(HAL_HOST_ACCESS_US);
+    if (host_adc_count > 0) {
+        sample = host_adc_fifo[host_adc_out];
+        host_adc_out = (host_adc_out + 1) % HAL_HOST_ADC_WORDS;
+        host_adc_count--;
+    }
+    return sample;
+}
+
+unsigned char hal_adc_empty(void) {
+    return host_adc_count == 0;
+}
+
+unsigned char hal_adc_overflow(void) {
+    return host_adc_lost;
+}
+
+void hal_adc_overflow_clear(void) {
+    host_adc_lost = 0;
+}
+
+void hal_adc_start(void) {
+    host_adc_on = 1;
+    host_adc_next = hal_host_us + host_adc_us;
+}
+
+void hal_adc_stop(void) {
+    host_adc_on = 0;
+}
+
+void hal_motor_dir(unsigned char pin, unsigned char level) {
+    if (level) {
+        hal_host_latb |= 1 << pin;
+    } else {
+        hal_host_latb &= ~(1 << pin);
+    }
+}
+
+unsigned char hal_motor_dir_get(unsigned char pin) {
+    return (hal_host_latb >> pin) & 1;
+}
+
+unsigned char hal_button(void) {
+    host_advance(HAL_HOST_ACCESS_US);
+    return host_button;
+}
+
+unsigned char hal_button_flag(void) {
+    return host_int0_flag;
+}
+
+void hal_button_clear(void) {
+    host_int0_flag = 0;
+}
+
+void hal_button_irq(unsigned char enable) {
+    host_int0_ie = enable;
+}
+
+void hal_lcd_e(unsigned char level) {
+    if ((level == 0) & (host_lcd_e == 1)) {
+        // Falling edge of E, nibble latched
+        if (host_lcd_4bit == 0) {
+            host_lcd_4bit = host_lcd_nibble == 2; // Function set, 4 bit
+        } else if (host_lcd_half == 0) {
+            host_lcd_high = host_lcd_nibble;
+            host_lcd_half = 1;
+        } else {
+            host_lcd_byte((host_lcd_high << 4) | host_lcd_nibble, host_lcd_rs);
+            host_lcd_half = 0;
+        }
+    }
+    host_lcd_e = level;
+}
+
+void hal_lcd_rs(unsigned char level) {
+    host_lcd_rs = level;
+}
+
+void hal_lcd_data(unsigned char nibble) {
+    host_lcd_nibble = nibble & 0x0F;
+}
+
+unsigned char hal_uart_rx_flag(void) {
+    host_advance(HAL_HOST_ACCESS_US);
+    return host_rx_ready();
+}
+
+unsigned char hal_uart_rx(void) {
+    unsigned char byte = 0;
+    if (host_rx_ready()) {
+        byte = host_rx[host_rx_out];
+        host_rx_out = (host_rx_out + 1) % HAL_HOST_RX_SIZE;
+    }
+    return byte;
+}
+
+unsigned char hal_uart_tx_flag(void) {
+    host_advance(HAL_HOST_ACCESS_US);
+    return hal_host_us >= host_tx_free;
+}
+
+void hal_uart_tx(unsigned char byte) {
+    host_tx_free = hal_host_us + HAL_HOST_UART_US;
+    if (hal_host_uart_tx_fn != 0) {
+        hal_host_uart_tx_fn(byte);
+    } else {
+        putchar(byte);
+    }
+}
+
+void hal_uart_tx_irq(unsigned char enable) {
+    host_tx_ie = enable;
+}
+
+unsigned char hal_uart_tx_irq_enabled(void) {
+    return host_tx_ie;
+}
+
+void hal_uart_tx_irq_low(void) {
+}
+
+unsigned char hal_ee_busy(void) {
+    host_advance(HAL_HOST_ACCESS_US);
+    return 0; // Writes complete immediately
+}
+
+unsigned char hal_ee_read(unsigned char address) {
+    if (host_started == 0) {
+        host_start();
+    }
+    return hal_host_eeprom[address];
+}
+
+void hal_ee_write(unsigned char address, unsigned char data) {
+    FILE *file;
+
+    if (host_started == 0) {
+        host_start();
+    }
+    hal_host_eeprom[address] = data;
+    if (host_eeprom_file != 0) {
+        file = fopen(host_eeprom_file, "wb");
+        if (file != 0) {
+            fwrite(hal_host_eeprom, 1, sizeof (hal_host_eeprom), file);
+            fclose(file);
+        }
+    }
+}
+
+void hal_idle(void) {
+    host_advance(100);
+}
+
+void hal_init_clock(void) {
+    if (host_started == 0) {
+        host_start();
+    }
+}
+
+void hal_init_lcd(void) {
+}
+
+// Peripheral set up, see hal_pic.c for the PIC18F4331
+
+void init_serial(void) {
+}
+
+void init_interrupt(void) {
+    host_rc_ie = 1;
+    host_gieh = 1;
+    host_giel = 1;
+}
+
+void init_ir(void) {
+#ifndef IR_ANALOG
+    hal_host_cap_mode = HAL_CAP_MODE;
+    host_cap_ie = HAL_CAP_MODE == HAL_CAP_EDGES;
+#endif
+}
+
+void init_adc(void) {
+#ifdef IR_ANALOG
+    host_adc_loop = 1; // AN0 - AN3, 2 x 32 + 4 x 12 TAD of 8 us
+    host_adc_first = 0;
+    host_adc_last = 3;
+    host_adc_us = 896;
+    host_adc_ie = 1;
+    hal_adc_start();
+#else
+    host_adc_loop = 0; // AN2, 32 + 12 TAD of 8 us
+    host_adc_first = 2;
+    host_adc_last = 2;
+    host_adc_us = 352;
+#endif
+}
+
+void init_counter(void) {
+    host_tick_on = 1;
+}
+
+void init_button(void) {
+    host_int0_ie = 1;
+}
+
+void init_pwm(int PWMperiod) {
+    hal_host_latb = 0;
+}
+
+#endif
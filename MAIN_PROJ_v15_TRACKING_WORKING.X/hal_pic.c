@@ -0,0 +1,380 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the PIC18F4331 side of the
+ |               hardware abstraction layer, holding the init_ functions which
+ |               configure each peripheral. The register accesses made while
+ |               running are macros in the header file hal.h
+ +===========================================================================*/
+#include "hal.h"
+#ifdef __XC8
+#include "dc_motor_struct.h"
+#include "functions.h"
+#pragma config OSC = IRCIO // internal oscillator
+
+/*=============================================================================
+ |  Function hal_init_clock
+ |
+ |  Purpose: hal_init_clock selects the 8MHz internal oscillator and waits
+ |           for it to become stable
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void hal_init_clock(void) {
+    OSCCON = 0b11110010; // internal oscillator, 8MHz
+    while (!OSCCONbits.IOFS); //Wait for OSC to become stable
+}
+
+/*=============================================================================
+ |  Function init_serial
+ |
+ |  Purpose: init_serial initializes the serial communication register of the
+ |           PIC18F4331 microcontroller, with a baud rate of 9600
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Ports are set up according to the schematic in the ECM Lab notes
+ |            chapter 7.
+ |
++============================================================================*/
+
+void init_serial(void) {
+    //set data direction registers for TX, RX
+    TRISCbits.RC7 = 1; //RX
+    TRISCbits.RC6 = 1; //TX
+    //both need to be 1 even though RC6 is an output
+    SPBRG = 207; //set baud rate to 9600
+    SPBRGH = 0;
+    BAUDCONbits.BRG16 = 1; //set baud rate scaling to 16 bit mode
+    TXSTAbits.BRGH = 1; //high baud rate select bit
+    RCSTAbits.CREN = 1; //continuous receive mode
+    RCSTAbits.SPEN = 1; //enable serial port, other settings default
+    TXSTAbits.TXEN = 1; //enable transmitter, other settings default
+}
+
+/*=============================================================================
+ |  Function init_interrupt
+ |
+ |  Purpose: init_interrupt enables global interupt for both high and low
+ |           priorities, enabling the peripheral interrupt function
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void init_interrupt() {
+    INTCONbits.GIEH = 1; // Global Interrupt Enable bit
+    PIE1bits.RCIE = 1; // Receive Flag Interrupt Enable
+    INTCONbits.PEIE = 1; // Peripheral Interrupt Enable
+    INTCONbits.GIEL = 1; // Global Low priority interrupt enable bit
+    RCONbits.IPEN = 1; //Enable priorities
+
+}
+
+/*=============================================================================
+ |  Function init_ir
+ |
+ |  Purpose: init_ir initializes the infared reciever connected to the MFM
+ |           (Motion Feedback Module) module of the PIC18F4331. The CAP2 and
+ |           CAP3 pins capture TMR5 on every edge, on the low priority
+ |           interrupt along its overflow, or with BEACON_RAW the PWM
+ |           falling to rising mode is enabled, with a prescaler of 1:2.
+ |           With IR_ANALOG, the sensors are sampled by the ADC instead (see
+ |           init_adc()), and TMR5 runs for the time stamps only
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void init_ir(void) {
+    ANSEL0 = 0; // Disable analogue input for 0 - 7, until init_adc()
+#ifndef IR_ANALOG
+    QEICON = 0; // Disable quadrature encoder 
+    DFLTCON = 0b00110110; // Enable noise filter for CAP2 and CAP3 with 1:128 clock divider ratio
+    TRISAbits.RA3 = 1; // Sets pins RA3/CAP2 and RA4/CAP3 as input
+    TRISAbits.RA4 = 1;
+    CAP2CONbits.CAP2M = HAL_CAP_MODE; // Every edge, or PWM falling - rising for CAP2
+    CAP3CONbits.CAP3M = HAL_CAP_MODE; // Every edge, or PWM falling - rising for CAP3
+#if HAL_CAP_MODE == HAL_CAP_EDGES
+    CAP2CONbits.CAP2REN = 0; // TMR5 not reset on capture, free running
+    CAP3CONbits.CAP3REN = 0;
+    IPR3bits.IC2QEIP = 0; // Captures and TMR5 overflow on low priority
+    IPR3bits.IC3DRIP = 0;
+    IPR3bits.TMR5IP = 0;
+    PIE3bits.IC2QEIE = 1;
+    PIE3bits.IC3DRIE = 1;
+    PIE3bits.TMR5IE = 1;
+#endif
+#endif
+
+    T5CONbits.TMR5ON = 1; // Enables the TMR5 module
+    T5CONbits.T5PS = 0b01; // Prescaler of 1:2
+    T5CONbits.RESEN = 0; // Enabled Special Event Trigger
+    T5CONbits.T5MOD = 0; // Continuous Count Mode Enabled
+    T5CONbits.T5SEN = 0; // Disable Timer during Sleep
+    T5CONbits.TMR5CS = 0; // No Clock Source, use Internal Clock
+    PR5H = 0xFF;
+    PR5L = 0xFF;
+}
+
+/*=============================================================================
+ |  Function hal_timer_us
+ |
+ |  Purpose: hal_timer_us reads the 16 bits of TMR5 (see init_ir())
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      uint16_t of TMR5, 1 us per count
+ |
+ |  Comments: TMR5L is read in a statement of its own, as reading it latches
+ |            TMR5H, and C leaves the order of the operands of | to the
+ |            compiler. Called from main and both interrupts, for which XC8
+ |            duplicates the function.
++============================================================================*/
+
+uint16_t hal_timer_us(void) {
+    uint16_t count = TMR5L; // Latches TMR5H
+
+    return count | ((uint16_t) TMR5H << 8);
+}
+
+/*=============================================================================
+ |  Function hal_capture
+ |
+ |  Purpose: hal_capture reads the capture buffer of a sensor (see init_ir())
+ |
+ |  Parameters: 
+ |      sensor (unsigned char) - 0 for CAP2 (IR3), 1 for CAP3 (IR2)
+ |
+ |  Returns:
+ |      Unsigned int of the TMR5 count captured
+ |
+ |  Comments: As hal_timer_us(), CAPxBUFL is read in a statement of its own,
+ |            before CAPxBUFH, rather than leaving the order of the two
+ |            reads to the compiler.
++============================================================================*/
+
+unsigned int hal_capture(unsigned char sensor) {
+    unsigned int count;
+
+    if (sensor == 0) {
+        count = CAP2BUFL;
+        return count | ((unsigned int) CAP2BUFH << 8);
+    }
+    count = CAP3BUFL;
+    return count | ((unsigned int) CAP3BUFH << 8);
+}
+
+/*=============================================================================
+ |  Function init_adc
+ |
+ |  Purpose: init_adc initializes the high speed ADC, with TAD = Fosc/64 =
+ |           8 us and the results right justified into its 4 word FIFO. The
+ |           supply is on AN2 (group C), converted on its own when started
+ |           by bat_service(), after an acquisition of 32 TAD. With
+ |           IR_ANALOG, AN0 and AN1 (groups A and B), then AN2 and AN3
+ |           (groups C and D) are sampled simultaneously in a continuous
+ |           loop instead, 2 x 32 TAD of acquisition and 4 x 12 TAD of
+ |           conversion, 896 us, on the low priority interrupt as the FIFO
+ |           fills
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called after init_ir(), which disables every analogue input.
++============================================================================*/
+
+void init_adc(void) {
+    TRISAbits.RA2 = 1; // AN2, battery through the divider (see battery_funct.h)
+    ANSEL0bits.ANS2 = 1;
+    ADCHS = 0; // AN0 in group A, AN1 in group B, AN2 in group C, AN3 in group D
+    ADCON1 = 0b00010000; // AVDD and AVSS references, FIFO enabled
+    ADCON2 = 0b11011110; // Right justified, 32 TAD acquisition, TAD = Fosc/64 = 8 us
+#ifdef IR_ANALOG
+    TRISAbits.RA0 = 1; // AN0 (IR3) and AN1 (IR2)
+    TRISAbits.RA1 = 1;
+    ANSEL0bits.ANS0 = 1;
+    ANSEL0bits.ANS1 = 1;
+    ADCON3 = 0b10000000; // Interrupt every 4th word, no trigger
+    IPR1bits.ADIP = 0; // ADC on low priority
+    PIE1bits.ADIE = 1;
+    ADCON0 = 0b00111100; // Continuous loop, groups A and B then C and D simultaneously
+    hal_adc_start();
+#else
+    ADCON3 = 0; // No trigger, interrupt not enabled
+    ADCON0 = 0b00001001; // Single shot of group C, ADC on
+#endif
+}
+
+/*=============================================================================
+ |  Function hal_adc_read
+ |
+ |  Purpose: hal_adc_read takes the oldest word of the ADC FIFO (see
+ |           init_adc())
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      uint16_t of the sample, 0 - 1023
+ |
+ |  Comments: Reading ADRESH moves the FIFO on to the next word, so ADRESL
+ |            is read first, in a statement of its own, as C leaves the
+ |            order of the operands of | to the compiler. Both bytes are
+ |            then of the same sample.
++============================================================================*/
+
+uint16_t hal_adc_read(void) {
+    uint16_t sample = ADRESL;
+
+    return sample | ((uint16_t) ADRESH << 8); // Pops the word
+}
+
+/*=============================================================================
+ |  Function init_counter
+ |
+ |  Purpose: init_counter initializes a timer low priority interrupt with a
+ |           prescaler value of 1:8 in 8 bit mode, to allow for the interrupt
+ |           flag INTCONbits.TMR0IF to be triggered once per milisecond
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void init_counter() {
+    INTCONbits.TMR0IE = 1; // enable TMR0 overflow interrupt
+    INTCON2bits.TMR0IP = 0; // TMR0 low priority
+    T0CONbits.T016BIT = 1; // 8 bit mode
+    T0CONbits.T0CS = 0; // use internal clock
+    T0CONbits.PSA = 0; // enable prescaler
+    T0CONbits.T0PS = 0b010; // set prescaler value of 1:8 
+    T0CONbits.TMR0ON = 1; //turn on timer0
+    TMR0L = 3; // Timer for 1 mili-second#
+}
+
+/*=============================================================================
+ |  Function init_button
+ |
+ |  Purpose: init_button initializes the button on pin C3 of the 
+ |           microcontroller, enabling external interrupt on button press
+ |
+ |  Parameters: 
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void init_button() {
+    LATC = 0; // Set the output data latch levels to 0 on all pins
+    TRISCbits.RC3 = 1; // Sets pin C3 to input
+    INTCONbits.INT0IE = 1; //INT0 External Interrupt Enable bit 
+}
+
+/*=============================================================================
+ |  Function init_pwm
+ |
+ |  Purpose: init_pwm initializes the PIC18F4331's PWM module, on the 
+ |           assumption that pins B0 and B2 are being used as output for a 
+ |           PWM duty cycle   
+ |
+ |  Parameters: 
+ |      PWMperiod (int) - An integer value ranging from 0 - 100
+ |
+ |  Returns: Nothing (Void function)
+ |
++============================================================================*/
+
+void init_pwm(int PWMperiod) {
+    // Motor PWM frequency 10kHz = 0.1ms period
+    // Set direction pins to output
+    TRISBbits.RB0 = 0;
+    TRISBbits.RB2 = 0;
+    // Set direction pins to low for PWMon control (25% = 25%)
+    LATBbits.LATB0 = 0;
+    LATBbits.LATB2 = 0;
+
+    // PWM settings
+    PTCON0 = 0b00000000; // free running mode, 1:1 prescaler = 0.5 us
+    PTCON1 = 0b10000000; // enable PWM timer
+    PWMCON0 = 0b01101111; // PWM 1 and 3 enabled
+    PWMCON1 = 0x00; // special features, all 0 (default)
+
+    /* PTPER max = 199 (12-bit res), set PS so that PTPER is as large 
+     * as possible for max resolution
+     * Set PWM period to 199 for Tpwm = 0.1 ms */
+
+    PTPERL = 0b11000111; // base PWM period low byte
+    PTPERH = 0b0; // base PWM period high byte
+}
+
+/*=============================================================================
+ |  Function hal_init_lcd
+ |
+ |  Purpose: hal_init_lcd sets the LCD pins as outputs, driven low
+ |
+ |  Parameters: 
+ |     Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
++============================================================================*/
+
+void hal_init_lcd(void) {
+    // set initial LAT output values (they start up in a random state)
+    //set the output data latch levels to 0 on all pins
+    LATCbits.LATC0 = 0;
+    LATCbits.LATC1 = 0;
+    LATCbits.LATC2 = 0;
+    LATDbits.LATD0 = 0;
+    LATDbits.LATD1 = 0;
+    LATAbits.LATA6 = 0;
+    // set LCD pins as output (TRIS registers)
+    //set the data direction registers to output on all pins
+    TRISC = 0; 
+    TRISD = 0;
+    TRISA = 0;
+    TRISCbits.RC0 = 0;
+    TRISCbits.RC1 = 0;
+    TRISCbits.RC2 = 0;
+    TRISDbits.RD0 = 0;
+    TRISDbits.RD1 = 0;
+    TRISAbits.RA6 = 0;
+}
+
+#endif
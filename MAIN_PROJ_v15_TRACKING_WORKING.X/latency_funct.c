@@ -0,0 +1,185 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the RFID reaction time. The
+ |               steps are time stamped by LAT_MARK_HIGH() in hp_rfid() and
+ |               LAT_MARK() in the main program, and added to the statistics
+ |               by lat_end() once the motors are stopped. The steps can be
+ |               found on the header file latency_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "record_funct.h"
+#include "latency_funct.h"
+
+#ifdef LATENCY
+
+const unsigned char * const lat_names[LAT_EVENTS] = {
+    TEXT("BYTE"), TEXT("FRAME"), TEXT("CUT"), TEXT("SEEN"), TEXT("STOP")
+};
+
+// Time stamps of this RUN
+uint16_t lat_us[LAT_EVENTS];
+unsigned int lat_ms[LAT_EVENTS];
+volatile unsigned char lat_marked = 0;
+
+struct LatEvent lat_events[LAT_EVENTS]; // LAT_BYTE unused
+
+/*=============================================================================
+ |  Function lat_reset
+ |
+ |  Purpose: lat_reset clears the time stamps, at the start of each RUN
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void lat_reset(void) {
+    lat_marked = 0;
+}
+
+/*=============================================================================
+ |  Function lat_after
+ |
+ |  Purpose: lat_after returns the time of a step after the first byte
+ |
+ |  Parameters:
+ |      event (unsigned char) - Step (LAT_FRAME - LAT_STOP)
+ |
+ |  Returns:
+ |      Unsigned long of the time in us
+ |
+ |  Comments: The time is first taken from G_time_ms, then corrected to the us
+ |            by TIMER5, which wraps every 65 ms. This holds while the ticks
+ |            are off by less than 32 ms, i.e. while the tick was held off
+ |            for less than that, as it is for a packet in hp_rfid().
++============================================================================*/
+
+unsigned long lat_after(unsigned char event) {
+    unsigned long coarse = (unsigned long) (unsigned int) (lat_ms[event] - lat_ms[LAT_BYTE]) * HAL_TICK_US;
+    int16_t fine = (int16_t) ((uint16_t) (lat_us[event] - lat_us[LAT_BYTE]) - (uint16_t) coarse);
+    long dt = (long) coarse + fine;
+
+    return (dt < 0) ? 0 : dt;
+}
+
+/*=============================================================================
+ |  Function lat_end
+ |
+ |  Purpose: lat_end adds the reaction of this RUN to the statistics, and
+ |           records the time from the first byte to the motors being stopped
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called once the main program has stopped the motors. Steps
+ |            not stamped this RUN, such as LAT_CUT for an invalid packet,
+ |            are left out. Nothing is added if the packet arrived before
+ |            this RUN (see lat_reset()).
++============================================================================*/
+
+void lat_end(void) {
+    struct LatEvent *e;
+    unsigned long dt;
+    unsigned long stopped = 0;
+    unsigned char i;
+
+    if ((lat_marked & (1 << LAT_BYTE)) == 0) {
+        return;
+    }
+    for (i = LAT_FRAME; i < LAT_EVENTS; i++) {
+        if ((lat_marked & (1 << i)) == 0) {
+            continue;
+        }
+        e = &lat_events[i];
+        dt = lat_after(i);
+        if ((i == LAT_CUT) | ((i == LAT_STOP) & (stopped == 0))) {
+            stopped = dt; // Motors stopped, by whichever came first
+        }
+        if (e->n == 255) {
+            continue; // Full, keep the mean consistent
+        }
+        if ((e->n == 0) | (dt < e->min)) {
+            e->min = dt;
+        }
+        if (dt > e->max) {
+            e->max = dt;
+        }
+        e->sum += dt;
+        e->last = dt;
+        e->n++;
+    }
+    stopped /= 1000;
+    rec_log(REC_REACT, (((lat_marked >> LAT_CUT) & 1) << 15) |
+            ((stopped > 0x7FFF) ? 0x7FFF : stopped));
+}
+
+/*=============================================================================
+ |  Function lat_dump
+ |
+ |  Purpose: lat_dump sends the statistics of every step over serial, one
+ |           step per line: name, count, minimum, mean, maximum and last
+ |           time after the first byte in us, as hexadecimal
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void lat_dump(void) {
+    struct LatEvent *e;
+    unsigned long value;
+    unsigned char i, k, v;
+
+    put_string_serial(TEXT("LAT\r\n"));
+    for (i = LAT_FRAME; i < LAT_EVENTS; i++) {
+        e = &lat_events[i];
+        put_string_serial(lat_names[i]);
+        put_char_serial(' ');
+        put_hex(e->n);
+        for (v = 0; v < 4; v++) {
+            if (v == 0) {
+                value = e->min;
+            } else if (v == 1) {
+                value = (e->n == 0) ? 0 : e->sum / e->n;
+            } else if (v == 2) {
+                value = e->max;
+            } else {
+                value = e->last;
+            }
+            put_char_serial(' ');
+            for (k = 4; k > 0; k--) {
+                put_hex(value >> (8 * (k - 1)));
+            }
+        }
+        put_string_serial(TEXT("\r\n"));
+    }
+    put_string_serial(TEXT("END\r\n"));
+}
+
+#endif
@@ -0,0 +1,90 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the RFID reaction
+ |               time, from the first byte of the RFID packet to the motors
+ |               being stopped. Each step of the reaction is time stamped
+ |               against TIMER5 and G_time_ms once per RUN, and the time of
+ |               each step after the first byte is kept as the count,
+ |               minimum, mean, maximum and last value since power up. Each
+ |               RUN also records its reaction time (see record_funct.h). The
+ |               statistics are sent over serial when 'L' is received in
+ |               standby. Only built with LATENCY defined; otherwise
+ |               LAT_MARK() and LAT_MARK_HIGH() compile to nothing.
+ |               Detailed function descriptions can be found in the
+ |               latency_funct.c file.
+ |               Requires functions.h to be included first.
+ +===========================================================================*/
+
+#ifndef LATENCY_FUNCT_H
+#define	LATENCY_FUNCT_H
+
+// Steps of the reaction, time stamped once per RUN
+#define LAT_BYTE 0 // First byte of the packet, on entering hp_rfid()
+#define LAT_FRAME 1 // Packet received by get_packet_serial()
+#define LAT_CUT 2 // Motors cut by the emergency stop, valid packets only
+#define LAT_SEEN 3 // G_rfid_retrieved seen by the main program
+#define LAT_STOP 4 // stop_all() done by the main program
+#define LAT_EVENTS 5
+
+/*=============================================================================
+ |  Structure LatEvent
+ |
+ |  Purpose: Statistics of one step of the reaction since power up
+ |
+ |  Parameters:
+ |      min, max, sum, last (unsigned long) - Times after the first byte in us
+ |      n (unsigned char) - Number of RUNs timed, which stops at 255
++============================================================================*/
+
+struct LatEvent {
+    unsigned long min, max, sum, last;
+    unsigned char n;
+};
+
+#ifdef LATENCY
+extern uint16_t lat_us[LAT_EVENTS];
+extern unsigned int lat_ms[LAT_EVENTS];
+extern volatile unsigned char lat_marked; // Bit per step stamped this RUN
+
+// Time stamp from the main program, with the tick held off so G_time_ms is
+// not read halfway through an increment
+#define LAT_MARK(event) (hal_irq_low_off(), lat_us[event] = hal_timer_us(), \
+        lat_ms[event] = G_time_ms, lat_marked |= 1 << (event), hal_irq_low_on())
+
+// Time stamp from the high priority interrupt. G_time_ms is only read
+// halfway through an increment if the interrupt lands between its two
+// instructions once every 256 ticks, which is ignored
+#define LAT_MARK_HIGH(event) (lat_us[event] = hal_timer_us(), \
+        lat_ms[event] = G_time_ms, lat_marked |= 1 << (event))
+
+void lat_reset(void);
+void lat_end(void);
+void lat_dump(void);
+#else
+#define LAT_MARK(event) ((void) 0)
+#define LAT_MARK_HIGH(event) ((void) 0)
+#define lat_reset() ((void) 0)
+#define lat_end() ((void) 0)
+#endif
+
+#endif
@@ -26,13 +26,12 @@
  |               described here).
  |               Most functions make use of the __delay_us() function, which 
  |               requires #define _XTAL_FREQ clk to be defined, with clk being
- |               the clock frequency
+ |               the clock frequency (see hal.h)
  +===========================================================================*/
 #include <stdio.h>
-#include <xc.h>
+#include "hal.h"
 #include <string.h> 
 #include "lcd_funct.h"
-#define _XTAL_FREQ 8000000 //i.e. for an 8MHz clock frequency
 
 /*=============================================================================
  |  Function e_tog
@@ -48,9 +47,9 @@
 +============================================================================*/
 
 void e_tog(void) {
-    LATCbits.LATC0 = 1; // Sends high to E
+    hal_lcd_e(1); // Sends high to E
     __delay_us(5); //
-    LATCbits.LATC0 = 0; // Sends low to E
+    hal_lcd_e(0); // Sends low to E
 }
 
 /*=============================================================================
@@ -69,10 +68,7 @@ void e_tog(void) {
 void lcd_out(unsigned char number) {
     //set data pins using the four bits from number
     //toggle the enable bit to send data
-    LATCbits.LATC1 = number & 1; // DB4
-    LATCbits.LATC2 = (number & 2) >> 1; // DB5
-    LATDbits.LATD0 = (number & 4) >> 2; // DB6
-    LATDbits.LATD1 = (number & 8) >> 3; // DB7
+    hal_lcd_data(number); // DB4 - DB7
     e_tog(); // Toggle enable pin
     __delay_us(5); 
 
@@ -97,7 +93,7 @@ void lcd_out(unsigned char number) {
 void send_lcd(unsigned char Byte, char type) {
     // set RS pin whether it is a Command (0) or Data/Char (1)
     // using type as the argument
-    LATAbits.LATA6 = type;
+    hal_lcd_rs(type);
     // send high bits of Byte using LCDout function
     lcd_out(Byte >> 4);
     __delay_us(10); // 10us delay
@@ -137,25 +133,7 @@ void clear_lcd(void) {
 +============================================================================*/
 
 void init_lcd(void) {
-    // set initial LAT output values (they start up in a random state)
-    //set the output data latch levels to 0 on all pins
-    LATCbits.LATC0 = 0;
-    LATCbits.LATC1 = 0;
-    LATCbits.LATC2 = 0;
-    LATDbits.LATD0 = 0;
-    LATDbits.LATD1 = 0;
-    LATAbits.LATA6 = 0;
-    // set LCD pins as output (TRIS registers)
-    //set the data direction registers to output on all pins
-    TRISC = 0; 
-    TRISD = 0;
-    TRISA = 0;
-    TRISCbits.RC0 = 0;
-    TRISCbits.RC1 = 0;
-    TRISCbits.RC2 = 0;
-    TRISDbits.RD0 = 0;
-    TRISDbits.RD1 = 0;
-    TRISAbits.RA6 = 0;
+    hal_init_lcd(); // LCD pins as outputs, driven low
     // Initialisation sequence code - see the data sheet
 
     __delay_us(15); //delay 15mS
@@ -215,13 +193,14 @@ void set_line(char line) {
  |           on the LCD screen
  |
  |  Parameters: 
- |     *string (unsigned char) - Address of an unsigned character, or an array
+ |     *string (const unsigned char) - Address of an unsigned character, or an
+ |                                     array, null terminated
  |
  |  Returns: Nothing (Void function)
  |
 +============================================================================*/
 
-void lcd_string(unsigned char *string) {
+void lcd_string(const unsigned char *string) {
     //While the data pointed to isn?t a 0x00 (null) do below
     while (*string != 0) {
         //Send out the current byte pointed to
@@ -34,7 +34,7 @@ void send_lcd(unsigned char Byte, char type);
 void clear_lcd(void);
 void init_lcd(void);
 void set_line(char line);
-void lcd_string(unsigned char *string);
+void lcd_string(const unsigned char *string);
 
 #endif	
 
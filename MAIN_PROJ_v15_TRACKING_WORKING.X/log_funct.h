@@ -0,0 +1,62 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the header file for the LCD output levels. States
+ |               and diagnostics are written through the macros below, or
+ |               within #if LOG_LEVEL, and compile to nothing above the
+ |               LOG_LEVEL of the build: LOG_DEBUG by default, as displayed
+ |               so far, or LOG_MISSION for the headless production image
+ |               (MPLAB configuration "headless", see the Makefile), which
+ |               spends no time on the LCD within the control loops. Mission
+ |               output (the standby menu, calibration results, the RFID and
+ |               its checksum) is always written directly.
+ |               Requires lcd_funct.h and functions.h to be included first.
+ +===========================================================================*/
+
+#ifndef LOG_FUNCT_H
+#define	LOG_FUNCT_H
+
+// Levels
+#define LOG_MISSION 0 // Standby menu, calibration, RFID and checksum
+#define LOG_STATE 1 // Each state on entering it (S, R, 1, 1c, 2, 2b)
+#define LOG_DEBUG 2 // IR readings and steering actions within the loops
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_DEBUG
+#endif
+
+// New state on line 1 of a cleared LCD
+#if LOG_LEVEL >= LOG_STATE
+#define log_state(text) (clear_lcd(), set_line(1), lcd_string(TEXT(text)))
+#else
+#define log_state(text) ((void) 0)
+#endif
+
+// Diagnostics at the cursor. Longer ones are written within
+// #if LOG_LEVEL >= LOG_DEBUG instead
+#if LOG_LEVEL >= LOG_DEBUG
+#define log_debug(text) lcd_string(TEXT(text))
+#else
+#define log_debug(text) ((void) 0)
+#endif
+
+#endif
@@ -41,7 +41,13 @@
  |  Output: RFID information on LCD screen
  | 
  |  Main File: main.c
- |  Source Files: functions.c, dc_motor_funct.c, lcd_funct.c
+ |  Source Files: functions.c, dc_motor_funct.c, lcd_funct.c, rotate_funct.c,
+ |                eeprom_funct.c, record_funct.c, tune_funct.c,
+ |                replay_funct.c, profile_funct.c, supervise_funct.c,
+ |                trace_funct.c, latency_funct.c, fmt_funct.c, fix_funct.c,
+ |                bearing_funct.c, beacon_funct.c, capture_funct.c,
+ |                adc_funct.c, battery_funct.c, hal_pic.c
+ |                (hal_host.c in place of hal_pic.c for the host build)
  |  
  | 
  | 
@@ -52,99 +58,147 @@
  |     - Attempted solutions: Using stop_all() in standby loop
  | 
  |  Improvements for future work:
- |  1. When RFID is retrieved, steering may not stop immediately as it depends
- |     on when the interrupt stops the main program (i.e., if interrupt 
- |     triggers within __delay_ms(), delay continues running before exiting 
- |     loop. 
- |     - Solution: Write new function delay_ms() which incorporates a 
- |                 conditional while loop to delay only when RFID is not 
- |                 not retrieved. For example:
- |      delay_ms(&G_rfid_retrieved, &G_time_ms, 400);
- |      void delay_ms(unsigned char *flag, unsigned int *time_ms, 
- |                    unsigned int delay) 
- |      {
- |          *time_ms = 0; // reset timer
- |          while ((*flag == 0) | (*time_ms < delay));
- |      }
+ |  1. When RFID is retrieved, steering used not to stop until the steering
+ |     action or motor ramp running at the time had finished.
+ |     - Solved: A valid packet now cuts the motors from the interrupt (see
+ |               hp_rfid()), and the steering delay ends early once RFID is
+ |               retrieved (see delay_ms_until()). The reaction time is
+ |               measured per RUN (see latency_funct.c).
  +===========================================================================*/
 
 // LIBRARIES AND HEADER FILES
-#include <xc.h>
+#include "hal.h"
 #include <stdio.h>
 #include "dc_motor_struct.h"
 #include "functions.h"
 #include "lcd_funct.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "record_funct.h"
+#include "tune_funct.h"
+#include "replay_funct.h"
+#include "profile_funct.h"
+#include "supervise_funct.h"
+#include "trace_funct.h"
+#include "latency_funct.h"
+#include "log_funct.h"
+#include "fmt_funct.h"
+#include "beacon_funct.h"
+#include "capture_funct.h"
+#include "adc_funct.h"
+#include "battery_funct.h"
 
 // PIC18F4331 CONFIGURATIONS
 #pragma config OSC = IRCIO, WDTEN = OFF // internal oscillator 
-#define _XTAL_FREQ 8000000 //i.e. for an 8MHz clock frequency
-// near the top of your main.c file so the functions can calculate how
+#pragma config WDPS = 512 // 2 s watchdog, enabled by software (see sup_init())
+// _XTAL_FREQ is defined in hal.h so the functions can calculate how
 // long to make the delay for different clock frequencies.
 
 // -------------------- GLOBAL VARIABLES --------------------
 // General
 volatile unsigned char G_rfid_buf[16]; // for storing and displaying RFID
 volatile unsigned int G_time_ms; // counting time using T0CON (up to 65s)
+struct Params G_params; // tunable values, stored in data EEPROM
 // Flags
 volatile unsigned char G_rfid_retrieved; // flag: 1 = RFID retrieved
+volatile unsigned char G_rfid_valid; // flag: 1 = checksum of RFID valid
+volatile unsigned char G_estop; // flag: 1 = motors cut by valid RFID
 volatile unsigned char G_run; // flag: 1 = run program, 0 = standby program
+volatile unsigned char G_cmd; // serial command received in standby, 0 = none
 
 // -------------------- INTERRUPTS --------------------
 // HIGH PRIORITY INTERRUPT
 
-void __interrupt(high_priority) hp_rfid(void) {
+void HAL_ISR_HIGH hp_rfid(void) {
     // Trigger: First full receive register received (0x02)
     // Runs get_packet_serial() until 0x03 received
     // Sets flag to indicate that RFID has been retrieved
-    if (PIR1bits.RCIF) {
-        get_packet_serial(G_rfid_buf); // stores serial bytes in packet form
-        G_rfid_retrieved = 1;
+    // Cuts the motors at once on the first valid packet of the RUN
+    // In STANDBY, single bytes are commands instead (see standby program)
+    // In TUNE mode, bytes are tuning requests instead (see tune_funct.c)
+    TRACE_HIGH(TR_HIGH_IN, hal_uart_rx_flag() | (hal_button_flag() << 1));
+    if (hal_uart_rx_flag()) {
+        if (tune_on == 1) {
+            tune_rx(hal_uart_rx());
+        } else if (G_run == 1) {
+            if (G_rfid_retrieved == 0) {
+                LAT_MARK_HIGH(LAT_BYTE); // reaction time from first byte
+            }
+            rpl_rfid(); // Sensor log, REPLAY_LOG builds only
+            get_packet_serial(G_rfid_buf); // stores serial bytes in packet form
+            G_rfid_valid = rfid_valid(G_rfid_buf);
+            if (G_rfid_retrieved == 0) {
+                LAT_MARK_HIGH(LAT_FRAME);
+                if (G_rfid_valid) {
+                    // Emergency stop, latched until main has stopped the
+                    // motors itself (see set_motor_pwm())
+                    G_estop = 1;
+                    MOTOR_CUT();
+                    LAT_MARK_HIGH(LAT_CUT);
+                }
+            }
+            G_rfid_retrieved = 1;
+        } else {
+            G_cmd = hal_uart_rx();
+        }
     }
 
     // Trigger: Button RC3 pressed 
     // Toggles between STANDBY (S) and RUN (R) mode
     // Three if statements for debouncing mechanical switch
-    if (INTCONbits.INT0IF) {
-        if (INTCONbits.INT0IF) {
-            if (INTCONbits.INT0IF) {
+    if (hal_button_flag()) {
+        if (hal_button_flag()) {
+            if (hal_button_flag()) {
                 if (G_run == 1) {
                     // Was in RUN before, enter STANDBY
                     G_run = 0;
                     clear_lcd();
                     set_line(1);
-                    lcd_string(">S");
+                    lcd_string(TEXT(">S"));
                     __delay_ms(700);
                 } else if (G_run == 0) {
                     // Was in STANDBY before, enter RUN
                     G_run = 1;
                     clear_lcd();
                     set_line(1);
-                    lcd_string(">R");
+                    lcd_string(TEXT(">R"));
                     __delay_ms(700);
                 }
                 // toggles G_run
-                INTCONbits.INT0IF = 0; //clear interrupt flag to exit
+                rpl_button(); // Sensor log, REPLAY_LOG builds only
+                hal_button_clear(); //clear interrupt flag to exit
             }
         }
     }
+    TRACE_HIGH(TR_HIGH_OUT, 0);
 }
 
 // LOW PRIORITY INTERRUPT
 
-void __interrupt(low_priority) lp_timer(void) {
-    if (INTCONbits.TMR0IF) {
+void HAL_ISR_LOW lp_timer(void) {
+    TRACE_LOW(TR_LOW_IN, hal_tick_flag() | ((hal_uart_tx_irq_enabled() & hal_uart_tx_flag()) << 1) |
+            ((hal_capture_flag(0) | hal_capture_flag(1) | adc_flag()) << 2));
+    if (hal_tick_flag()) {
         G_time_ms++; // increments when TIMER0 overflows
-        TMR0L = 3; // TIMER0 counts from 3 to 255 for 1 ms duration
-        INTCONbits.TMR0IF = 0; // clears TIMER0 interrupt flag
+        tr_tick(); // event trace clock, TRACE builds only
+        hal_tick_clear(); // TIMER0 counts from 3 to 255 for 1 ms duration
+        rec_service(); // writes queued records to data EEPROM
+        sup_service(); // clears watchdog unless the control loop stalled
+        bat_service(); // samples the battery, unless IR_ANALOG
+    }
+    cap_service(); // time stamps IR capture edges, tracks each beacon
+    adc_service(); // takes analog IR samples, IR_ANALOG builds only
+    if (hal_uart_tx_irq_enabled() & hal_uart_tx_flag()) {
+        tune_tx(); // sends next byte of queued tuning replies
     }
+    TRACE_LOW(TR_LOW_OUT, 0);
 }
 
 // -------------------- MAIN PROGRAM --------------------
 
 void main(void) {
     // Initialise PIC18F4331 oscillator
-    OSCCON = 0b11110010; // internal oscillator, 8MHz
-    while (!OSCCONbits.IOFS); //Wait for OSC to become stable
+    hal_init_clock(); // internal oscillator, 8MHz
 
     // Initisalise functions
     // See function comments for more details 
@@ -153,12 +207,19 @@ void main(void) {
     init_serial();
     init_interrupt();
     init_ir();
+    init_adc();
+    cap_init(); // no IR edge seen, no beacon tracked yet
     init_pwm(100);
     init_counter();
     clear_lcd();
 
     // Assigning global variables
     G_run = 0; // enter standby
+    G_cmd = 0; // no serial command
+    params_load(); // Tunable values from data EEPROM, else defaults
+    rec_init(); // Continue mission record from data EEPROM
+    rpl_init(); // Start sensor log, REPLAY_LOG builds only
+    unsigned char stalled = sup_init(); // Start watchdog, SUP_NONE unless reset by it
 
     // Assigning local variables (NIL)
 
@@ -169,42 +230,43 @@ void main(void) {
 
     motorL.power = 0; // Zero power to start
     motorL.direction = 0; // Set default motor direction (0: forward)
-    // Store address of PWM duty low byte
-    motorL.dutyLowByte = (unsigned char *) (&PDC0L);
-    motorL.dutyHighByte = (unsigned char *) (&PDC0H);
-    motorL.dir_pin = 0; // Pin RB0/PWM0 controls direction
-    motorL.PWMperiod = 199; //store PWMperiod for motor
+    // PWM channel 0, pin RB0/PWM0 controls direction (see motor_ports)
+    motorL.channel = 0;
 
     motorR.power = 0;
     motorR.direction = 0;
-    motorR.dutyLowByte = (unsigned char *) (&PDC1L);
-    motorR.dutyHighByte = (unsigned char *) (&PDC1H);
-    motorR.dir_pin = 2;
-    motorR.PWMperiod = 199;
+    motorR.channel = 1; // Pin RB2/PWM2
 
     cont.ir_left = 0;
     cont.ir_right = 0;
     cont.ir_diff = 0;
+    cont.bearing = 0;
     cont.turn_direction = 0; // 0: left, 1: right
 
-    // Constants for calibration
-    cont.gain = 40; // higher gain, lower time to turn
-    cont.time_to_turn = 0; // how much vehicle turns
-    cont.ir_threshold = 350; // Lower threshold, more centred 
-    cont.ir_min = 47000; // Ensures vehicle is not facing backwards
-    cont.ir_buf[6];
+    // Constants for calibration are held in G_params (see eeprom_funct.h)
+    cont.left_sensor = 1; // Sensor read into ir_left
     cont.i = 0;
     cont.finding_direction = 0;
-    cont.steer_action[220]; // Stores up to 219 actions, last element for exit
+    // Steering actions are cleared at the start of each RUN
 
-    // Initialise checksum buffer
-    unsigned char chksm[5]; // Stores 2 8 bit characters for comparison
-    unsigned char j = 0; // Counter for checksum
+    // Steering action cut short by the RFID, replayed for the time driven
+    unsigned char cut_i = 255; // 255 = none
+    unsigned int cut_ms = 0;
+
+    unsigned char mode = MODE_STANDBY; // Standby menu selection
+    unsigned char rfid[16]; // G_rfid_buf as displayed, copied out of it
 
     // Inform user that main has been initialised
     clear_lcd();
     set_line(1);
-    lcd_string("INIT");
+    lcd_string(TEXT("INIT"));
+    if (stalled != SUP_NONE) {
+        // Reset by the watchdog, show which loop stalled
+        set_line(2);
+        lcd_string(TEXT("WDT "));
+        lcd_string(sup_names[stalled]);
+        delay_s(2);
+    }
     __delay_ms(500);
 
     /* ------------------------------------------------------------------------
@@ -212,9 +274,17 @@ void main(void) {
      * 
      * Purpose: 
      * - Clear RFID buffer
-     * - Clear steer action buffer
      * - Stop all motors (buggy after first run, power cycling required)
      * - Display instantaneous/filtered IR values for mechanical calibration
+     * - Run calibration routines selected from the standby menu, and
+     *   edit parameters, saving them to data EEPROM
+     * - Send the control loop overruns over serial when 'W' is received,
+     *   and in builds with the subsystem, the mission record when 'D' is
+     *   received, the RFID reaction times when 'L' is received, the beacon
+     *   tracks when 'B' is received, and the battery supply and sag when
+     *   'V' is received
+     * - Answer tuning requests over serial, once enabled from the menu, in
+     *   TUNE builds
      * Set flags: 
      * - No RFID
      * - Finding direction
@@ -223,6 +293,8 @@ void main(void) {
      * ------------------------------------------------------------------------
      */
     while (G_run == 0) {
+        sup_stop(); // No control loop to supervise
+        tr_stop(); // Keep event trace of the last RUN, TRACE builds only
 
         G_rfid_retrieved = 0; // No RFID
         cont.finding_direction = 1; // Robot not centred, finding direction
@@ -237,20 +309,44 @@ void main(void) {
         stop_all(&motorL, &motorR); // Stop all motors
 
         // Inform user that program is in STANDBY mode
-        clear_lcd();
-        set_line(1);
-        lcd_string("S");
+        log_state("S");
+        rec_log(REC_STATE, 'S');
         __delay_ms(500);
 
-        // Clear steer action buffer
-        for (cont.i = 0; cont.i < 220; cont.i++) {
-            cont.steer_action[cont.i] = 0;
-            cont.i++;
+        // Hold button on entering standby to open menu (see select_mode()),
+        // unless a calibration was requested over serial (see tune_poll())
+        if (mode == MODE_STANDBY) {
+            mode = select_mode();
+        }
+        if (mode == MODE_CAL_ROT) {
+            // Measure turn rates against the beacon
+            calibrate_rotation(&G_params.rot, &cont, &motorL, &motorR);
+            params_save();
+        } else if (mode == MODE_CAL_IR) {
+            // Match IR sensor gains, requires calibrated turn rates
+            calibrate_ir(&cont, &G_params.cal, &G_params.rot, &motorL, &motorR);
+            params_save();
+        } else if (mode == MODE_PARAMS) {
+            // Edit tunable values with the button
+            edit_params(cont.ir_buf);
+        }
+#ifdef TUNE
+        else if (mode == MODE_TUNE) {
+            // Serial port used for tuning instead of RFID until power cycle
+            tune_enable();
         }
+#endif
+#ifdef PROFILE
+        else if (mode == MODE_PROFILE) {
+            // Stage timings of the last RUN (see profile_funct.c)
+            prof_show();
+        }
+#endif
+        mode = MODE_STANDBY;
 
         // Display IR values for calibration
         // Exit condition prevents continuous looping of entire standby program
-        while (G_run == 0) {
+        while ((G_run == 0) & (mode == MODE_STANDBY)) {
             cont.ir_left = 0;
             cont.ir_right = 0;
 
@@ -262,13 +358,70 @@ void main(void) {
             // cont.ir_left = ir_filter(1);
             // cont.ir_right = ir_filter(0);
 
+#if LOG_LEVEL >= LOG_DEBUG
             set_line(2);
             ir_display(&cont);
+#endif
+
+#ifdef RECORD
+            // Serial command: dump mission record
+            if (G_cmd == 'D') {
+                G_cmd = 0;
+                rec_dump();
+            }
+#endif
+#ifdef PROFILE
+            // Serial command: dump stage timings of the last RUN
+            if (G_cmd == 'P') {
+                G_cmd = 0;
+                prof_dump();
+            }
+#endif
+            // Serial command: dump control loop overruns
+            if (G_cmd == 'W') {
+                G_cmd = 0;
+                sup_dump();
+            }
+#ifdef LATENCY
+            // Serial command: dump RFID reaction times
+            if (G_cmd == 'L') {
+                G_cmd = 0;
+                lat_dump();
+            }
+#endif
+#ifndef BEACON_RAW
+            // Serial command: dump beacon tracks
+            if (G_cmd == 'B') {
+                G_cmd = 0;
+                bcn_dump();
+            }
+#endif
+#ifdef BAT_REPORT
+            // Serial command: dump battery supply and sag
+            if (G_cmd == 'V') {
+                G_cmd = 0;
+                bat_dump();
+            }
+#endif
+#ifdef TRACE
+            // Serial command: dump event trace of the last RUN
+            if (G_cmd == 'T') {
+                G_cmd = 0;
+                tr_dump();
+            }
+#endif
+
+#ifdef TUNE
+            // Tuning request, leaves loop to run a requested calibration
+            mode = tune_poll(&cont, &motorL, &motorR);
+#endif
             __delay_ms(200);
         }
 
         // Exit condition prevents continuous looping of entire standby program
-        while (G_run == 0);
+        while ((G_run == 0) & (mode == MODE_STANDBY)) {
+            hal_idle();
+        }
     } // end STANDBY
 
 
@@ -285,31 +438,44 @@ void main(void) {
      * a) Initial orientation (WHILE: finding_direction = 1)
      * - Moves forward for 5s when centred
      * b) Steering (WHILE: finding_direction = 0)
-     * - Up to 219 steering actions, 400ms each
+     * - Up to 255 steering actions (STEER_ACTIONS - 1), 400ms each
+     *   (G_params.action_ms), stored 4 to a byte (see set_steer_action())
+     * c) Steering record full (IF: 255 actions and RFID not retrieved)
+     * - Stops and waits for the button, as the way back cannot be stored
      * 
      * 2. IF: RFID retrieved
      * a) Return sequence
      * - Performs steering actions in reverse
-     * - Moves in reverse for 5s
+     * - Moves in reverse for 5s, or as far as the forward run drove
      * b) Display RFID
      * - Remove LF and CR, validate checksum
      * ------------------------------------------------------------------------
      */
     while (G_run == 1) {
         // Inform user that program is in RUN mode
-        clear_lcd();
-        set_line(1);
-        lcd_string("R");
+        log_state("R");
+        rec_log(REC_STATE, 'R');
         __delay_ms(500);
 
         // Resetting global variables
+        G_estop = 0; // Motors free to drive
         G_rfid_retrieved = 0; // RFID not retrieved
+        cut_i = 255; // No steering action cut short
+        cont.run_ms = 0; // No forward run driven
         cont.finding_direction = 1; // Robot not oriented, finding direction
         G_time_ms = 0; // time reset
+        prof_reset(); // Stage timings of this RUN only
+        tr_start(); // Event trace of this RUN only
+        lat_reset(); // RFID reaction time of this RUN only
+        bat_reset(); // Battery sag of this RUN only
 
         // Resetting local variables (NIL)
 
         // Resetting structure objects 
+        // Clear steer action buffer, written over by the standby menu
+        for (cont.i = 0; cont.i < (STEER_ACTIONS / 4); cont.i++) {
+            cont.phase.steer_action[cont.i] = 0;
+        }
         cont.i = 0;
         /*---------------------------------------------------------------------
          * 1. WHILE: NO RFID
@@ -318,9 +484,8 @@ void main(void) {
 
         while ((G_rfid_retrieved == 0) & (G_run == 1)) {
             // Inform user that program is in NO RFID mode
-            clear_lcd();
-            set_line(1);
-            lcd_string("1");
+            log_state("1");
+            rec_log(REC_STATE, '1');
             delay_s(1);
 
             /*
@@ -333,26 +498,46 @@ void main(void) {
              * - Reducing time delays in orientate() increases response accuracy 
              *   but decreases response time
              */
+            sup_start(SUP_ORIENT);
             while ((cont.finding_direction == 1) & (G_run == 1)) {
+                sup_checkin(SUP_ORIENT);
+                PROF_START(PROF_LOOP);
                 // Retrieve filtered IR values
+                PROF_START(PROF_SENSE);
                 cont.ir_left = ir_filter(1);
                 cont.ir_right = ir_filter(0);
+                PROF_END(PROF_SENSE);
+                cont.left_sensor = 1;
                 // Display IR values
+                PROF_START(PROF_LCD);
+#if LOG_LEVEL >= LOG_DEBUG
                 clear_lcd();
                 set_line(1);
                 ir_display(&cont);
 
                 // Inform user that program is in INITIAL ORIENTATION mode
                 set_line(2);
-                lcd_string("1a|");
+                lcd_string(TEXT("1a|"));
+#endif
+                PROF_END(PROF_LCD);
 
                 // Process IR values (see function for more details)
+                PROF_START(PROF_DECIDE);
                 ir_difference(&cont, &motorL, &motorR);
+                rec_sample(cont.ir_left, cont.ir_right, &motorL, &motorR);
+                PROF_END(PROF_DECIDE);
 
                 // Orientate or move vehicle (see function for more details)
+                PROF_START(PROF_ACT);
                 orientate(&cont, &motorL, &motorR);
+                PROF_END(PROF_ACT);
+                tune_poll(&cont, &motorL, &motorR); // Tuning request, if any
+                PROF_START(PROF_WAIT);
                 __delay_ms(100);
+                PROF_END(PROF_WAIT);
+                PROF_END(PROF_LOOP);
             } // end finding direction
+            rec_log(REC_STATE, ('1' << 8) | 'b');
 
             /*
              * STEERING TOWARDS TARGET
@@ -364,141 +549,201 @@ void main(void) {
              * - Decreasing time of each steering action increases response
              *   speed but increase data memory usage
              */
-            while ((cont.finding_direction == 0) & (G_rfid_retrieved == 0) & (G_run == 1)) {
+            sup_start(SUP_STEER);
+            while ((cont.finding_direction == 0) & (G_rfid_retrieved == 0) & (G_run == 1) & (cont.i < STEER_ACTIONS - 1)) {
+                sup_checkin(SUP_STEER);
+                PROF_START(PROF_LOOP);
                 // Retrieve instantaneous IR values
                 // IR values will not go to 0 anymore if no signal detected;
+                PROF_START(PROF_SENSE);
                 cont.ir_left = get_ir(0);
                 cont.ir_right = get_ir(1);
+                PROF_END(PROF_SENSE);
+                cont.left_sensor = 0;
                 // Display IR values
+                PROF_START(PROF_LCD);
+#if LOG_LEVEL >= LOG_DEBUG
                 clear_lcd();
                 set_line(1);
                 ir_display(&cont);
 
                 // Inform user that program is in STEERING mode
                 set_line(2);
-                lcd_string("1b|");
+                lcd_string(TEXT("1b|"));
+#endif
+                PROF_END(PROF_LCD);
 
                 // Process IR values (see function for more details)
+                PROF_START(PROF_DECIDE);
                 ir_difference(&cont, &motorL, &motorR);
+                rec_sample(cont.ir_left, cont.ir_right, &motorL, &motorR);
+                PROF_END(PROF_DECIDE);
 
                 // Display current steering action
-                itoa_5(cont.i, cont.ir_buf);
+                PROF_START(PROF_LCD);
+#if LOG_LEVEL >= LOG_DEBUG
+                fmt_dec(cont.ir_buf, cont.i, 5);
                 lcd_string(cont.ir_buf);
+#endif
+                PROF_END(PROF_LCD);
 
                 // Steer vehicle towards target (see function for more details)
+                PROF_START(PROF_ACT);
+                cut_ms = time_ms(); // Start of this steering action
                 steer(&cont, &motorL, &motorR);
-                __delay_ms(400); // Keep each steering action at 400 ms
+                PROF_END(PROF_ACT);
+                tune_poll(&cont, &motorL, &motorR); // Tuning request, if any
+                PROF_START(PROF_WAIT);
+                // Keep each steering action at 400 ms, unless RFID retrieved
+                delay_ms_until(G_params.action_ms, &G_rfid_retrieved);
+                PROF_END(PROF_WAIT);
+                if (G_rfid_retrieved == 1) {
+                    // Cut short, the return sequence replays the time driven.
+                    // Less the stop_all() ramp at the end of the return if
+                    // the motors were cut without one: 2 ms per unit of
+                    // power, as far as half that time at full power
+                    cut_i = cont.i;
+                    cut_ms = time_ms() - cut_ms;
+                    if (G_estop == 1) {
+                        cut_ms = (cut_ms > G_params.cruise_power) ? cut_ms - G_params.cruise_power : 0;
+                    }
+                }
 
                 cont.i++; // Increase counter for storing next steering action
+                PROF_END(PROF_LOOP);
             } // end steering
+
+            if ((cont.i == STEER_ACTIONS - 1) & (G_rfid_retrieved == 0) & (G_run == 1)) {
+                // No slot left to store the way back: stop, until the
+                // button ends the RUN
+                sup_stop(); // Steering left
+                stop_all(&motorL, &motorR);
+                log_state("1c");
+                rec_log(REC_STATE, ('1' << 8) | 'c');
+                while (G_run == 1) {
+                    hal_idle();
+                }
+            }
         } // end RFID not retrieved
 
         /*
          * IF: RFID COLLECTED
          * Purpose:
-         * - Stop the vehicle
+         * - Stop the vehicle, unless already stopped by the interrupt
          * - Perform return sequence based on recorded steering actions
          * - Perform full speed reverse in response to full speed ahead after
          *   initial orientation
-         * - Remove line feed, carriage return and validate checksum
+         * - Remove line feed, carriage return and display checksum result
          * - Display RFID
          */
         if ((G_rfid_retrieved == 1) & (G_run == 1)) {
-            // Stop vehicle
+            LAT_MARK(LAT_SEEN);
+            sup_stop(); // Steering left
+            rpl_flush(); // Sensor log of the RFID, REPLAY_LOG builds only
+
+            // Stop vehicle, at once if cut by the emergency stop
             stop_all(&motorL, &motorR);
+            LAT_MARK(LAT_STOP);
+            G_estop = 0; // Stopped by main, free to return
+            lat_end(); // Reaction time of this RUN
             __delay_ms(500); // prevent abrupt return
 
             // Inform user that program is in RFID RETRIEVED mode
-            clear_lcd();
-            set_line(1);
-            lcd_string("2");
-
-            // Initiate return sequence in opposite direction
-            while ((cont.i >= 0) & (G_run == 1) & (cont.i < 255)) {
+            log_state("2");
+            rec_log(REC_STATE, '2');
+
+            // Initiate return sequence in opposite direction, from the last
+            // steering action stored (cont.i - 1) down to the first
+            sup_start(SUP_RETURN);
+            while ((cont.i > 0) & (G_run == 1)) {
+                sup_checkin(SUP_RETURN);
+                cont.i--;
+#if LOG_LEVEL >= LOG_DEBUG
                 // Inform user that program is in RETURNING mode
                 clear_lcd();
                 set_line(1);
-                lcd_string("2a");
+                lcd_string(TEXT("2a"));
 
                 // Display current steering action
                 set_line(2);
-                itoa_5(cont.i, cont.ir_buf);
+                fmt_dec(cont.ir_buf, cont.i, 5);
                 lcd_string(cont.ir_buf);
+#endif
 
                 // Steer based on action stored in steer action buffer
-                if (cont.steer_action[cont.i] == 1) {
+                if (get_steer_action(&cont, cont.i) == 1) {
                     // Veer left in opposite direction (left side still slower)
-                    lcd_string(":VL");
+                    log_debug(":VL");
                     veer_left(&motorL, &motorR, 1);
-                } else if (cont.steer_action[cont.i] == 2) {
+                } else if (get_steer_action(&cont, cont.i) == 2) {
                     // Veer right in opposite direction (right side still slower)
-                    lcd_string(":VR");
+                    log_debug(":VR");
                     veer_right(&motorL, &motorR, 1);
-                } else if (cont.steer_action[cont.i] == 3) {
+                } else if (get_steer_action(&cont, cont.i) == 3) {
                     // go back
-                    lcd_string(":MC");
+                    log_debug(":MC");
                     full_speed(&motorL, &motorR, 1);
                 }
-                __delay_ms(400); // Keep each steering action at 400 ms
-                cont.i--;
+                // Keep each steering action at 400 ms, or as driven if cut short
+                delay_ms((cont.i == cut_i) ? cut_ms : G_params.action_ms);
             }
+            sup_stop();
 
-            // Initial full speed reverse for 5s
+            // Initial full speed reverse for 5s, or as driven if cut short
             stop_all(&motorL, &motorR);
             clear_lcd();
             full_speed(&motorL, &motorR, 1);
-            delay_s(5);
+            delay_ms(cont.run_ms);
             stop_all(&motorL, &motorR);
 
             // Display RFID
-            clear_lcd();
-            set_line(1);
-            lcd_string("2b");
+            log_state("2b");
+            rec_log(REC_STATE, ('2' << 8) | 'b');
             delay_s(1);
 
+            // Copy the RFID out, as the interrupt writes G_rfid_buf again on
+            // every packet received
+            hal_irq_off();
+            for (cont.i = 0; cont.i < 16; cont.i++) {
+                rfid[cont.i] = G_rfid_buf[cont.i];
+            }
+            hal_irq_on();
+
             // Remove line feed and carriage return from RFID
             for (cont.i = 0; cont.i < 14; cont.i++) {
-                if (G_rfid_buf[cont.i] == 10 | G_rfid_buf[cont.i] == 13) {
+                if ((rfid[cont.i] == 10) | (rfid[cont.i] == 13)) {
                     // ASCII Dec Value: LF (10), CR (13)
-                    G_rfid_buf[cont.i] = 0; // set to null byte
+                    rfid[cont.i] = 0; // set to null byte
                 }
             }
 
-            // OR the even and odd bits of the 10 DATA bytes together
-            chksm[0] = (G_rfid_buf[0]<<4) | G_rfid_buf[1];
-            chksm[1] = (G_rfid_buf[2]<<4) | G_rfid_buf[3];
-            chksm[2] = (G_rfid_buf[4] <<4) | G_rfid_buf[5];
-            chksm[3] = (G_rfid_buf[6]<<4) | G_rfid_buf[7];
-            chksm[4] = (G_rfid_buf[8]<<4) | G_rfid_buf[9];
-            
-            // Checking the checksum by XORing the valus in chksm array together
-            j = 1;
-            while (j < 5) {
-                chksm[0] = chksm[0] ^ chksm[j];
-                j++;
-            }
-            
-            
-            // If the XORed result is equal to checksum, display valid
+            // Checksum checked as the packet was received (see rfid_valid())
+            // Record first tag character and whether checksum is valid
+            rec_log(REC_RFID, (G_rfid_valid << 8) | rfid[0]);
+
+            // If the XORed data bytes equal the checksum, display valid
             // Else display invalid
-            if (chksm[0] == (G_rfid_buf[10] | G_rfid_buf[11])) {
+            if (G_rfid_valid) {
                 // Display Checksum
                 set_line(1);
-                lcd_string("CHECKSUM VALID");
+                lcd_string(TEXT("CHECKSUM VALID"));
 
                 // Remove checksum
-                G_rfid_buf[10] = 0;
-                G_rfid_buf[11] = 0;
+                rfid[10] = 0;
+                rfid[11] = 0;
 
                 // Display RFID
                 set_line(2);
-                lcd_string(G_rfid_buf);
+                lcd_string(rfid);
 
-                while (G_run == 1); // Pauses the program until the button is pressed
+                // Pauses the program until the button is pressed
+                while (G_run == 1) {
+                    hal_idle();
+                }
             } else {
                 // Checksum Invalid
                 set_line(1);
-                lcd_string("CHECKSUM INVALID");
+                lcd_string(TEXT("CHECKSUM INVALID"));
             }
 
 
@@ -11,3 +11,10 @@ CND_ARTIFACT_PATH_default=dist/default/production/MAIN_PROJ_v15_TRACKING_WORKING
 CND_PACKAGE_DIR_default=${CND_DISTDIR}/default/package
 CND_PACKAGE_NAME_default=mainprojv15trackingworking.x.tar
 CND_PACKAGE_PATH_default=${CND_DISTDIR}/default/package/mainprojv15trackingworking.x.tar
+# headless configuration
+CND_ARTIFACT_DIR_headless=dist/headless/production
+CND_ARTIFACT_NAME_headless=MAIN_PROJ_v15_TRACKING_WORKING.X.production.hex
+CND_ARTIFACT_PATH_headless=dist/headless/production/MAIN_PROJ_v15_TRACKING_WORKING.X.production.hex
+CND_PACKAGE_DIR_headless=${CND_DISTDIR}/headless/package
+CND_PACKAGE_NAME_headless=mainprojv15trackingworking.x.tar
+CND_PACKAGE_PATH_headless=${CND_DISTDIR}/headless/package/mainprojv15trackingworking.x.tar
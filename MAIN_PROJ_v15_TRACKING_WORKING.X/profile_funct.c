@@ -0,0 +1,332 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the loop profiler. A stage is
+ |               stamped by PROF_START(), a few instructions inline, and
+ |               ended by prof_end(), which takes its time stamps before
+ |               anything else, so that its bookkeeping is counted in the
+ |               enclosing PROF_LOOP stage only. prof_end() only bins the 16
+ |               bit duration; the 32 bit arithmetic of the count, range and
+ |               mean is left to prof_stats(), when the results are shown.
+ |               The stage definitions can be found on the header file
+ |               profile_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "lcd_funct.h"
+#include "record_funct.h"
+#include "profile_funct.h"
+#include "fmt_funct.h"
+
+#ifdef PROFILE
+
+const unsigned char * const prof_names[PROF_STAGES] = {
+    TEXT("LOOP"), TEXT("SENSE"), TEXT("LCD"), TEXT("DECIDE"), TEXT("ACT"), TEXT("WAIT")
+};
+
+// Time stamps of PROF_START(), main only
+uint16_t prof_start_us[PROF_STAGES];
+unsigned int prof_start_ms[PROF_STAGES];
+
+struct ProfStage prof_stages[PROF_STAGES];
+
+/*=============================================================================
+ |  Function prof_reset
+ |
+ |  Purpose: prof_reset clears the statistics of every stage
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called at the start of each RUN, so standby shows the last one.
++============================================================================*/
+
+void prof_reset(void) {
+    unsigned char i, k;
+
+    for (i = 0; i < PROF_STAGES; i++) {
+        for (k = 0; k < PROF_BINS; k++) {
+            prof_stages[i].bins[k] = 0;
+        }
+    }
+}
+
+/*=============================================================================
+ |  Function prof_end
+ |
+ |  Purpose: prof_end adds the time since PROF_START() of a stage to its
+ |           histogram
+ |
+ |  Parameters:
+ |      stage (unsigned char) - Stage (PROF_LOOP - PROF_WAIT)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Durations below PROF_FINE_MS are binned to the us, longer ones
+ |            to the ms, each as a 16 bit count. A TIMER5 count over 32767
+ |            lands in the first ms bin, which starts at 32 ms.
++============================================================================*/
+
+void prof_end(unsigned char stage) {
+    uint16_t us = hal_timer_us();
+    unsigned int ms = time_ms();
+    unsigned int *bins = prof_stages[stage].bins;
+    uint16_t scaled;
+    unsigned char bin = 0;
+
+    ms -= prof_start_ms[stage];
+    if (ms < PROF_FINE_MS) {
+        scaled = (uint16_t) (us - prof_start_us[stage]) >> 8;
+    } else {
+        scaled = ms >> 6;
+        bin = PROF_BIN_MS;
+    }
+    for (; (scaled != 0) & (bin < PROF_BINS - 1); scaled >>= 1) {
+        bin++;
+    }
+    if (bins[bin] != 0xFFFF) {
+        bins[bin]++;
+    }
+}
+
+/*=============================================================================
+ |  Function prof_edge
+ |
+ |  Purpose: prof_edge returns the lower edge of a histogram bin
+ |
+ |  Parameters:
+ |      bin (unsigned char) - Bin (0 - PROF_BINS - 1), or PROF_BINS for the
+ |                            upper edge of the last bin
+ |
+ |  Returns:
+ |      Unsigned long of the edge in us
++============================================================================*/
+
+unsigned long prof_edge(unsigned char bin) {
+    if (bin == 0) {
+        return 0;
+    }
+    if (bin < PROF_BIN_MS) {
+        return 128UL << bin;
+    }
+    if (bin < PROF_BINS) {
+        return 32000UL << (bin - PROF_BIN_MS);
+    }
+    return 65535000UL; // Longest time G_time_ms measures
+}
+
+/*=============================================================================
+ |  Function prof_stats
+ |
+ |  Purpose: prof_stats works out the count, range and mean of a stage from
+ |           its histogram
+ |
+ |  Parameters:
+ |      *s (struct ProfStage) - Address of the histogram of the stage
+ |      *stats (struct ProfStats) - Address of the statistics to be written
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Each timing counts as the centre of its bin, and those of the
+ |            last bin, which is open, as 1.5 s. The sum holds up to 71
+ |            minutes of timings.
++============================================================================*/
+
+void prof_stats(const struct ProfStage *s, struct ProfStats *stats) {
+    unsigned long lower, upper;
+    unsigned long sum = 0;
+    unsigned char k;
+
+    stats->n = 0;
+    stats->min = 0;
+    stats->max = 0;
+    for (k = 0; k < PROF_BINS; k++) {
+        if (s->bins[k] == 0) {
+            continue;
+        }
+        lower = prof_edge(k);
+        upper = prof_edge(k + 1);
+        if (stats->n == 0) {
+            stats->min = lower;
+        }
+        stats->max = upper;
+        stats->n += s->bins[k];
+        if (k == PROF_BINS - 1) {
+            upper = lower << 1; // Open bin
+        }
+        sum += ((lower + upper) >> 1) * s->bins[k];
+    }
+    stats->mean = (stats->n == 0) ? 0 : sum / stats->n;
+}
+
+/*=============================================================================
+ |  Function prof_time
+ |
+ |  Purpose: prof_time writes a duration into a buffer as five digits and a
+ |           unit, u (us), m (ms) or s
+ |
+ |  Parameters:
+ |      us (unsigned long) - Duration in us
+ |      *buffer (unsigned char) - Buffer of at least 7 bytes
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Each unit holds up to 65535, the largest unsigned int.
++============================================================================*/
+
+void prof_time(unsigned long us, unsigned char *buffer) {
+    unsigned char unit = 'u';
+
+    if (us > 65535) {
+        us /= 1000;
+        unit = 'm';
+    }
+    if (us > 65535) {
+        us /= 1000;
+        unit = 's';
+    }
+    buffer = fmt_dec(buffer, us, 5);
+    buffer[0] = unit;
+    buffer[1] = 0;
+}
+
+/*=============================================================================
+ |  Function prof_show
+ |
+ |  Purpose: prof_show displays the statistics of every stage on the LCD,
+ |           two pages per stage, two seconds each
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Page one: name and count (up to 65535), then the range, from
+ |            the lower edge of the lowest bin to the upper edge of the
+ |            highest. Page two: name and mean, then the histogram with each
+ |            bin scaled to a digit, 9 being the largest bin.
++============================================================================*/
+
+void prof_show(void) {
+    unsigned char buffer[16];
+    unsigned char i, k;
+    unsigned int top;
+    struct ProfStage *s;
+    struct ProfStats stats;
+
+    for (i = 0; i < PROF_STAGES; i++) {
+        s = &prof_stages[i];
+        prof_stats(s, &stats);
+        clear_lcd();
+        set_line(1);
+        lcd_string(prof_names[i]);
+        lcd_string(TEXT(" n"));
+        fmt_dec(buffer, (stats.n > 0xFFFF) ? 0xFFFF : stats.n, 5);
+        lcd_string(buffer);
+        set_line(2);
+        if (stats.n == 0) {
+            lcd_string(TEXT("NOT RUN"));
+            delay_s(2);
+            continue;
+        }
+        prof_time(stats.min, buffer);
+        lcd_string(buffer);
+        lcd_string(TEXT("-"));
+        prof_time(stats.max, buffer);
+        lcd_string(buffer);
+        delay_s(2);
+
+        clear_lcd();
+        set_line(1);
+        lcd_string(prof_names[i]);
+        lcd_string(TEXT(" ~"));
+        prof_time(stats.mean, buffer);
+        lcd_string(buffer);
+        set_line(2);
+        top = 1;
+        for (k = 0; k < PROF_BINS; k++) {
+            if (s->bins[k] > top) {
+                top = s->bins[k];
+            }
+        }
+        buffer[0] = 'H';
+        for (k = 0; k < PROF_BINS; k++) {
+            buffer[k + 1] = '0' + ((unsigned long) s->bins[k] * 9 + top - 1) / top;
+        }
+        buffer[PROF_BINS + 1] = 0;
+        lcd_string(buffer);
+        delay_s(2);
+    }
+}
+
+/*=============================================================================
+ |  Function prof_dump
+ |
+ |  Purpose: prof_dump sends the statistics of every stage over serial, one
+ |           stage per line: name, count, lowest edge, mean and highest
+ |           edge in us (see prof_stats()), then the histogram bins, as
+ |           hexadecimal
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void prof_dump(void) {
+    struct ProfStats stats;
+    unsigned long value;
+    unsigned char i, k, v;
+
+    put_string_serial(TEXT("PROF\r\n"));
+    for (i = 0; i < PROF_STAGES; i++) {
+        prof_stats(&prof_stages[i], &stats);
+        put_string_serial(prof_names[i]);
+        for (v = 0; v < 4; v++) {
+            if (v == 0) {
+                value = stats.n;
+            } else if (v == 1) {
+                value = stats.min;
+            } else if (v == 2) {
+                value = stats.mean;
+            } else {
+                value = stats.max;
+            }
+            put_char_serial(' ');
+            for (k = 4; k > 0; k--) {
+                put_hex(value >> (8 * (k - 1)));
+            }
+        }
+        for (k = 0; k < PROF_BINS; k++) {
+            put_char_serial(' ');
+            put_hex(prof_stages[i].bins[k] >> 8);
+            put_hex(prof_stages[i].bins[k]);
+        }
+        put_string_serial(TEXT("\r\n"));
+    }
+    put_string_serial(TEXT("END\r\n"));
+}
+
+#endif
@@ -0,0 +1,110 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the loop profiler,
+ |               which times the stages of each RUN iteration against TIMER5
+ |               (1 us per count, free running, see init_ir()) and G_time_ms,
+ |               and keeps a histogram of each stage in RAM, from which the
+ |               count, range and mean are worked out when shown. The results are shown on the LCD from
+ |               the standby menu (PROF) and sent over serial when 'P' is
+ |               received in standby. Only built with PROFILE defined;
+ |               otherwise PROF_START() and PROF_END() compile to nothing.
+ |               Detailed function descriptions can be found in the
+ |               profile_funct.c file.
+ |               Requires functions.h to be included first.
+ +===========================================================================*/
+
+#ifndef PROFILE_FUNCT_H
+#define	PROFILE_FUNCT_H
+
+// Stages, timed by PROF_START() and PROF_END() around them in main.c. A
+// stage may be timed more than once per iteration
+#define PROF_LOOP 0 // Whole iteration of the orientation or steering loop
+#define PROF_SENSE 1 // ir_filter() or get_ir() of both sensors
+#define PROF_LCD 2 // Clearing and writing the LCD
+#define PROF_DECIDE 3 // ir_difference() and rec_sample()
+#define PROF_ACT 4 // orientate() or steer(), motor ramps included
+#define PROF_WAIT 5 // Fixed delay at the end of the iteration
+#define PROF_STAGES 6
+
+// Histogram bins, one octave each: below 256 us, then up to 512 us, 1 ms,
+// ... 32 ms from TIMER5, up to 64 ms, 128 ms, ... 1 s from G_time_ms, and
+// 1 s or more
+#define PROF_BINS 14
+#define PROF_BIN_MS 8 // First bin timed in ms, from 32 ms
+
+// Below this many ms, durations are taken from TIMER5 to the us, else from
+// G_time_ms, as TIMER5 wraps every 65 ms
+#define PROF_FINE_MS 32
+
+/*=============================================================================
+ |  Structure ProfStage
+ |
+ |  Purpose: Histogram of one stage since the start of RUN
+ |
+ |  Parameters:
+ |      bins[PROF_BINS] (unsigned int) - Timings in each histogram bin, each
+ |                                       stopping at 65535
++============================================================================*/
+
+struct ProfStage {
+    unsigned int bins[PROF_BINS];
+};
+
+/*=============================================================================
+ |  Structure ProfStats
+ |
+ |  Purpose: Statistics of one stage, worked out from its histogram by
+ |           prof_stats()
+ |
+ |  Parameters:
+ |      n (unsigned long) - Number of timings
+ |      min, max (unsigned long) - Lower edge of the lowest bin and upper
+ |                                 edge of the highest bin timed, in us
+ |      mean (unsigned long) - Mean of the bin centres, in us
++============================================================================*/
+
+struct ProfStats {
+    unsigned long n, min, max, mean;
+};
+
+#ifdef PROFILE
+extern uint16_t prof_start_us[PROF_STAGES];
+extern unsigned int prof_start_ms[PROF_STAGES];
+
+// Time stamp of the stage, with the tick held off so G_time_ms is not read
+// halfway through an increment
+#define PROF_START(stage) (hal_irq_low_off(), prof_start_us[stage] = hal_timer_us(), \
+        prof_start_ms[stage] = G_time_ms, hal_irq_low_on())
+#define PROF_END(stage) prof_end(stage)
+
+void prof_reset(void);
+void prof_end(unsigned char stage);
+void prof_show(void);
+void prof_dump(void);
+#else
+#define PROF_START(stage) ((void) 0)
+#define PROF_END(stage) ((void) 0)
+#define prof_reset() ((void) 0)
+#endif
+
+#endif
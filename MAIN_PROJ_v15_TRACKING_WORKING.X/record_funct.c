@@ -0,0 +1,278 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the mission recorder. Records
+ |               are queued in RAM by the main program and written to a ring
+ |               in the data EEPROM one byte at a time by the low priority
+ |               interrupt, such that the main program never waits for an
+ |               EEPROM write. The record layout can be found on the header
+ |               file record_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "record_funct.h"
+#include "trace_funct.h"
+
+#ifdef RECORD
+
+// Queue of records to be written, filled by main and emptied by interrupt
+unsigned char rec_queue[REC_QUEUE][4];
+volatile unsigned char rec_in = 0; // Next free entry, written by main only
+volatile unsigned char rec_out = 0; // Next entry to write, interrupt only
+unsigned char rec_byte = 1; // Next byte of entry rec_out to write
+
+// Position in EEPROM ring, interrupt only after rec_init()
+unsigned char rec_head = 0; // Next record to be written
+unsigned char rec_lap = 0; // Lap bit of records being written, 0 or 0x80
+
+// Clock, incremented by interrupt
+volatile unsigned char rec_s = 0; // Seconds since power up
+unsigned int rec_ms = 0;
+
+// Summary of current second, main only
+unsigned long rec_sum_left = 0;
+unsigned long rec_sum_right = 0;
+unsigned char rec_samples = 0;
+unsigned char rec_last_s = 0;
+unsigned char rec_lost = 0; // 1 while neither IR sensor has a signal
+
+/*=============================================================================
+ |  Function rec_push
+ |
+ |  Purpose: rec_push adds a record to the queue, to be written to EEPROM by
+ |           rec_service()
+ |
+ |  Parameters:
+ |      b0, b1, b2, b3 (unsigned char) - Bytes of the record, see
+ |                                       record_funct.h
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: If the queue is full the record is dropped, rather than
+ |            waiting. Only rec_in is written here and only rec_out in the
+ |            interrupt, both single bytes, so no locking is needed.
++============================================================================*/
+
+void rec_push(unsigned char b0, unsigned char b1, unsigned char b2, unsigned char b3) {
+    unsigned char next = (rec_in + 1) & (REC_QUEUE - 1);
+    if (next == rec_out) {
+        return; // Queue full
+    }
+    rec_queue[rec_in][0] = b0;
+    rec_queue[rec_in][1] = b1;
+    rec_queue[rec_in][2] = b2;
+    rec_queue[rec_in][3] = b3;
+    rec_in = next;
+}
+
+/*=============================================================================
+ |  Function rec_init
+ |
+ |  Purpose: rec_init finds the end of the ring left by the previous power up
+ |           and records the boot, with the cause of reset
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The newest records carry a different lap bit from the oldest, so
+ |            the next record to be written is the first whose lap bit differs
+ |            from record 0. If every lap bit is the same, the ring has just
+ |            wrapped (or is erased) and writing restarts at record 0.
++============================================================================*/
+
+void rec_init(void) {
+    unsigned char first = ee_read(REC_BASE) & 0x80;
+    unsigned char i;
+
+    rec_head = 0;
+    rec_lap = first ^ 0x80;
+    for (i = 1; i < REC_SIZE; i++) {
+        if ((ee_read(REC_BASE + (i << 2)) & 0x80) != first) {
+            rec_head = i;
+            rec_lap = first;
+            break;
+        }
+    }
+    rec_log(REC_BOOT, hal_reset_cause());
+}
+
+/*=============================================================================
+ |  Function rec_log
+ |
+ |  Purpose: rec_log queues an event record, timestamped in seconds
+ |
+ |  Parameters:
+ |      type (unsigned char) - Record type, see record_funct.h
+ |      payload (unsigned int) - Value recorded with the event
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void rec_log(unsigned char type, unsigned int payload) {
+    TRACE_MAIN(TR_REC | type, payload); // Event trace, TRACE builds only
+    rec_push(type, rec_s, payload >> 8, payload);
+}
+
+/*=============================================================================
+ |  Function rec_sample
+ |
+ |  Purpose: rec_sample accumulates IR readings into a summary record, queued
+ |           once per second along with the current motor powers, and records
+ |           the start and end of each episode without IR signal
+ |
+ |  Parameters:
+ |      ir_left (unsigned int) - Value of left IR intensity
+ |      ir_right (unsigned int) - Value of right IR intensity
+ |      *mL (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |      *mR (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: To be called once per iteration of the control loop.
++============================================================================*/
+
+void rec_sample(unsigned int ir_left, unsigned int ir_right, struct DC_motor *mL, struct DC_motor *mR) {
+    if ((ir_left == 0) & (ir_right == 0)) {
+        if (rec_lost == 0) {
+            rec_lost = 1;
+            rec_log(REC_LOST, 1);
+        }
+    } else if (rec_lost == 1) {
+        rec_lost = 0;
+        rec_log(REC_LOST, 0);
+    }
+
+    rec_sum_left += ir_left;
+    rec_sum_right += ir_right;
+    rec_samples++;
+    if ((rec_s != rec_last_s) | (rec_samples == 255)) {
+        rec_push(REC_SUMMARY,
+                (rec_sum_left / rec_samples) >> 8,
+                (rec_sum_right / rec_samples) >> 8,
+                ((mL->power / 10) << 4) | (mR->power / 10));
+        rec_sum_left = 0;
+        rec_sum_right = 0;
+        rec_samples = 0;
+        rec_last_s = rec_s;
+    }
+}
+
+/*=============================================================================
+ |  Function rec_service
+ |
+ |  Purpose: rec_service keeps the recorder clock, and writes the next queued
+ |           byte to EEPROM if no write is in progress
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called from the low priority interrupt every ms, so a record
+ |            takes at least 16 ms to write (4 ms per byte). The header byte
+ |            is written last, so a record cut short by a power cycle keeps
+ |            its old lap bit and is treated as the oldest record. ee_read()
+ |            and ee_write() hold off this interrupt while they use the EEPROM
+ |            registers.
++============================================================================*/
+
+void rec_service(void) {
+    unsigned char data;
+
+    rec_ms++;
+    if (rec_ms >= 1000) {
+        rec_ms = 0;
+        rec_s++;
+    }
+
+    if ((rec_out == rec_in) | hal_ee_busy()) {
+        return; // Nothing queued, or write in progress
+    }
+    data = rec_queue[rec_out][rec_byte];
+    if (rec_byte == 0) {
+        data |= rec_lap;
+    }
+    hal_ee_write(REC_BASE + (rec_head << 2) + rec_byte, data);
+
+    if (rec_byte == 0) {
+        // Header written, record complete
+        rec_byte = 1;
+        rec_out = (rec_out + 1) & (REC_QUEUE - 1);
+        rec_head++;
+        if (rec_head == REC_SIZE) {
+            rec_head = 0;
+            rec_lap ^= 0x80;
+        }
+    } else if (rec_byte == 3) {
+        rec_byte = 0;
+    } else {
+        rec_byte++;
+    }
+}
+
+/*=============================================================================
+ |  Function rec_dump
+ |
+ |  Purpose: rec_dump sends every record in the ring over serial, oldest
+ |           first, one record per line as four hexadecimal bytes with the
+ |           lap bit removed
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Erased records are skipped. Records still queued are not sent.
++============================================================================*/
+
+void rec_dump(void) {
+    unsigned char i, k, record;
+    unsigned char address;
+
+    put_string_serial(TEXT("REC\r\n"));
+    record = rec_head; // Oldest record
+    for (i = 0; i < REC_SIZE; i++) {
+        address = REC_BASE + (record << 2);
+        if ((ee_read(address) & 0x7F) != REC_EMPTY) {
+            put_hex(ee_read(address) & 0x7F);
+            for (k = 1; k < 4; k++) {
+                put_char_serial(' ');
+                put_hex(ee_read(address + k));
+            }
+            put_string_serial(TEXT("\r\n"));
+        }
+        record++;
+        if (record == REC_SIZE) {
+            record = 0;
+        }
+    }
+    put_string_serial(TEXT("END\r\n"));
+}
+
+#endif
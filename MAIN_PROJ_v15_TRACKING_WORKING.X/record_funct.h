@@ -0,0 +1,71 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the mission recorder,
+ |               which keeps a ring of events in the data EEPROM that survives
+ |               a power cycle. Only built with RECORD defined, as it costs
+ |               program memory the default image has not got to spare;
+ |               otherwise every call compiles to nothing. Detailed function
+ |               descriptions can be found in the record_funct.c file
+ +===========================================================================*/
+
+#ifndef RECORD_FUNCT_H
+#define	RECORD_FUNCT_H
+
+/* Record layout (4 bytes), stored in data EEPROM from REC_BASE
+ * Byte 0: Bit 7 lap (toggles each time the ring wraps), bits 6-0 type
+ * Event records (REC_BOOT - REC_RFID, REC_STALL - REC_REACT):
+ *   Byte 1: Time in seconds since power up (wraps at 256 s)
+ *   Byte 2-3: Payload, high byte first
+ * Summary records (REC_SUMMARY), one per second of RUN:
+ *   Byte 1: Mean left IR reading / 256
+ *   Byte 2: Mean right IR reading / 256
+ *   Byte 3: Left motor power / 10 (high nibble), right (low nibble) */
+#define REC_BASE 0x40 // After the parameter slots, see eeprom_funct.h
+#define REC_SIZE 48 // Records in the ring (192 bytes)
+#define REC_QUEUE 8 // Records waiting to be written
+
+// Record types
+#define REC_BOOT 1 // Payload: RCON at power up
+#define REC_STATE 2 // Payload: state as displayed on the LCD (ASCII)
+#define REC_LOST 3 // Payload: 1 signal lost, 0 signal regained
+#define REC_RFID 4 // Payload: checksum valid (high), first tag char (low)
+#define REC_SUMMARY 5
+#define REC_STALL 6 // Payload: loop stalled before a watchdog reset (SUP_)
+#define REC_OVERRUN 7 // Payload: loop (bits 15-12), new worst lateness in ms
+#define REC_REACT 8 // Payload: emergency stop (bit 15), ms from RFID to stop
+#define REC_EMPTY 0x7F // Erased EEPROM
+
+#ifdef RECORD
+void rec_init(void);
+void rec_log(unsigned char type, unsigned int payload);
+void rec_sample(unsigned int ir_left, unsigned int ir_right, struct DC_motor *mL, struct DC_motor *mR);
+void rec_service(void);
+void rec_dump(void);
+#else
+#define rec_init() ((void) 0)
+#define rec_log(type, payload) ((void) 0)
+#define rec_sample(ir_left, ir_right, mL, mR) ((void) 0)
+#define rec_service() ((void) 0)
+#endif
+
+#endif
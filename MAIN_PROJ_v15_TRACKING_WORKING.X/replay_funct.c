@@ -0,0 +1,218 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the sensor log. Records are
+ |               sent as TUNE_LOG frames through the reply queue of
+ |               tune_funct.c, by the low priority interrupt. Unlike a tuning
+ |               reply, a record is never dropped: the main program waits
+ |               for space in the queue instead, about 13 ms per record at
+ |               9600 baud, so that the log is complete. Only the TX pin of
+ |               the serial port is used, so the RFID reader stays connected
+ |               to RX. The record layout can be found on the header file
+ |               replay_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "tune_funct.h"
+#include "replay_funct.h"
+
+#ifdef REPLAY_LOG
+
+extern volatile unsigned char G_rfid_buf[16]; // Defined in main.c
+
+// Events flagged by interrupt, recorded by main on the next IR reading
+volatile unsigned char rpl_pending = 0;
+volatile unsigned int rpl_button_ms = 0;
+volatile unsigned int rpl_rfid_ms = 0;
+
+unsigned char rpl_seq = 0; // Sequence number of the next record
+
+/*=============================================================================
+ |  Function rpl_init
+ |
+ |  Purpose: rpl_init starts the log with a RPL_BOOT record
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: To be called once at power up, after init_serial() and
+ |            init_interrupt().
++============================================================================*/
+
+void rpl_init(void) {
+    hal_uart_tx_irq_low(); // Records sent by low priority interrupt
+    rpl_record(RPL_BOOT, hal_reset_cause(), time_ms());
+}
+
+/*=============================================================================
+ |  Function rpl_param
+ |
+ |  Purpose: rpl_param returns a parameter word of the RPL_PARAM records
+ |
+ |  Parameters:
+ |      i (unsigned char) - Word, 0 to RPL_PARAMS - 1
+ |
+ |  Returns:
+ |      Unsigned integer of the par_info parameter i, for i below PAR_COUNT,
+ |      then of the turn rates, the IR gains and the IR offsets
+ |
+ |  Comments: The words are independent of the layout of struct Params,
+ |            which differs between XC8 and the host.
++============================================================================*/
+
+unsigned int rpl_param(unsigned char i) {
+    if (i < PAR_COUNT) {
+        return param_get(i);
+    }
+    i -= PAR_COUNT;
+    if (i < ROT_LEVELS) {
+        return G_params.rot.rate[i];
+    }
+    i -= ROT_LEVELS;
+    if (i < 2) {
+        return G_params.cal.gain[i];
+    }
+    return (uint16_t) G_params.cal.offset[i - 2];
+}
+
+/*=============================================================================
+ |  Function rpl_record
+ |
+ |  Purpose: rpl_record queues a record, with the motor outputs as they are
+ |           now, waiting for space in the queue if needed
+ |
+ |  Parameters:
+ |      type (unsigned char) - Type and index, see replay_funct.h
+ |      value (unsigned int) - Value
+ |      time (unsigned int) - G_time_ms of the event
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called from the main program only. The PWM duty is read back
+ |            from the duty registers, as written by set_motor_pwm().
++============================================================================*/
+
+void rpl_record(unsigned char type, unsigned int value, unsigned int time) {
+    unsigned char data[RPL_DATA];
+
+    data[0] = rpl_seq;
+    data[1] = type;
+    data[2] = value >> 8;
+    data[3] = value;
+    data[4] = time >> 8;
+    data[5] = time;
+    data[6] = (*hal_pwm_duty_high(0) << 6) | (*hal_pwm_duty_low(0) >> 2);
+    data[7] = (*hal_pwm_duty_high(1) << 6) | (*hal_pwm_duty_low(1) >> 2);
+    data[8] = hal_motor_dir_get(0) | (hal_motor_dir_get(2) << 1);
+    rpl_seq++;
+
+    while (tune_space() < RPL_DATA + 4) {
+        hal_idle(); // Sent by interrupt
+    }
+    tune_reply(TUNE_LOG, data, RPL_DATA);
+}
+
+/*=============================================================================
+ |  Function rpl_flush
+ |
+ |  Purpose: rpl_flush records any button press or RFID packet flagged by the
+ |           interrupt since the last call
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by rpl_ir(), and by the main program once it has seen
+ |            the RFID, as no IR reading follows. The pending flags are taken
+ |            with interrupts disabled, as they are set by the high priority
+ |            interrupt.
++============================================================================*/
+
+void rpl_flush(void) {
+    unsigned char pending;
+    unsigned char i;
+
+    hal_irq_off();
+    pending = rpl_pending;
+    rpl_pending = 0;
+    hal_irq_on();
+
+    if (pending & RPL_PEND_BUTTON) {
+        rpl_record(RPL_BUTTON, G_run, rpl_button_ms);
+        for (i = 0; i < RPL_PARAMS; i++) {
+            rpl_record(RPL_PARAM | i, rpl_param(i), rpl_button_ms);
+        }
+    }
+    if (pending & RPL_PEND_RFID) {
+        for (i = 0; i < 16; i += 2) {
+            rpl_record(RPL_RFID | (i >> 1), (G_rfid_buf[i] << 8) | G_rfid_buf[i + 1], rpl_rfid_ms);
+        }
+    }
+}
+
+/*=============================================================================
+ |  Function rpl_ir
+ |
+ |  Purpose: rpl_ir records an IR reading, after any button press or RFID
+ |           packet received since the last one
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |      value (unsigned int) - Capture returned by get_ir()
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by get_ir(), from the main program only.
++============================================================================*/
+
+void rpl_ir(unsigned char sensor, unsigned int value) {
+    rpl_flush();
+    rpl_record(RPL_IR | sensor, value, time_ms());
+}
+
+/*=============================================================================
+ |  Function rpl_supply
+ |
+ |  Purpose: rpl_supply records a change of the duty scale of the supply
+ |           monitor, after any button press or RFID packet received since
+ |           the last record
+ |
+ |  Parameters:
+ |      gain (unsigned char) - Duty scale, Q7
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called by bat_duty(), from the main program only.
++============================================================================*/
+
+void rpl_supply(unsigned char gain) {
+    rpl_flush();
+    rpl_record(RPL_SUPPLY, gain, time_ms());
+}
+
+#endif
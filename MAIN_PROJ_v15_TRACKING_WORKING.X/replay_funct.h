@@ -0,0 +1,97 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the sensor log, which
+ |               sends every IR reading, with the motor outputs at the time,
+ |               every change of the duty scale of the supply monitor, and
+ |               every button press and RFID packet over serial, such
+ |               that a run can be replayed through the control code on the
+ |               host (see sim/replay.c). Only built with REPLAY_LOG defined,
+ |               as it costs program memory and slows the control loop while
+ |               the serial queue is full, and with TUNE defined as well, as
+ |               the log is sent through the reply queue of the tuning
+ |               protocol. Otherwise every call compiles to nothing. Detailed function descriptions can be found in the
+ |               replay_funct.c file.
+ |               Requires functions.h, rotate_funct.h and eeprom_funct.h to
+ |               be included first.
+ +===========================================================================*/
+
+#ifndef REPLAY_FUNCT_H
+#define	REPLAY_FUNCT_H
+
+/* Record layout, data of a TUNE_LOG frame (see tune_funct.h), 9 bytes
+ * Byte 0: Sequence number, from 0 at power up (wraps at 256)
+ * Byte 1: Type (high nibble), index (low nibble)
+ * Byte 2-3: Value, high byte first
+ * Byte 4-5: G_time_ms, high byte first. Of the interrupt for RPL_BUTTON
+ *           and RPL_RFID, else of the record
+ * Byte 6-7: PWM duty (0 - 199) of motor channel 0 and 1 when recorded
+ * Byte 8: Direction pins, channel 0 (RB0) bit 0, channel 1 (RB2) bit 1
+ * Button presses and RFID packets are recorded on the next IR reading, just
+ * before it, so the records are in the order in which the main program saw
+ * them, or once the main program has seen the RFID (see rpl_flush()). The
+ * parameters follow every button press. */
+#define RPL_DATA 9 // Data bytes of a record
+
+// Record types
+#define RPL_BOOT 0x00 // Value: reset cause
+#define RPL_IR 0x10 // Index: sensor, value: capture returned by get_ir()
+#define RPL_BUTTON 0x20 // Value: G_run after the press
+#define RPL_RFID 0x30 // Index: byte pair 0 - 7, value: G_rfid_buf bytes
+#define RPL_PARAM 0x40 // Index: word of rpl_param(), value: word
+#define RPL_SUPPLY 0x50 // Value: duty scale of the supply (see bat_duty())
+
+// Parameter words, par_info ids, then turn rates, then IR gains and offsets
+#define RPL_PARAMS (PAR_COUNT + ROT_LEVELS + 4) // Up to 16
+
+// Events flagged by the high priority interrupt
+#define RPL_PEND_BUTTON 0x01
+#define RPL_PEND_RFID 0x02
+
+#ifdef REPLAY_LOG
+#ifndef TUNE
+#error REPLAY_LOG requires TUNE for the reply queue
+#endif
+extern volatile unsigned char rpl_pending; // RPL_PEND_ flags
+extern volatile unsigned int rpl_button_ms; // G_time_ms of each event
+extern volatile unsigned int rpl_rfid_ms;
+
+// Called from the high priority interrupt
+#define rpl_button() (rpl_pending |= RPL_PEND_BUTTON, rpl_button_ms = G_time_ms)
+#define rpl_rfid() (rpl_pending |= RPL_PEND_RFID, rpl_rfid_ms = G_time_ms)
+
+void rpl_init(void);
+unsigned int rpl_param(unsigned char i);
+void rpl_record(unsigned char type, unsigned int value, unsigned int time);
+void rpl_flush(void);
+void rpl_ir(unsigned char sensor, unsigned int value);
+void rpl_supply(unsigned char gain);
+#else
+#define rpl_button() ((void) 0)
+#define rpl_rfid() ((void) 0)
+#define rpl_init() ((void) 0)
+#define rpl_flush() ((void) 0)
+#define rpl_ir(sensor, value) ((void) 0)
+#define rpl_supply(gain) ((void) 0)
+#endif
+
+#endif
@@ -0,0 +1,572 @@
+#!/usr/bin/env python3
+# =============================================================================
+#  Assignment: Explosive Ordinance Disposal
+#
+#  Author: Lim Siew Han & Justin Kek
+#  Language: Python 3
+#  Tools: XC8 (v2.00) build outputs
+#  Microchip: PIC18F4331
+#
+#  School: Imperial College London
+#  Department: Mechanical Engineering
+#  Module: Embedded C for Microcontrollers
+#  Class: MEng Graduating 2021
+# -----------------------------------------------------------------------------
+#  Description: Post-build report (see "make report"). Reads the .lst and
+#               .mum files which XC8 writes to dist/default/production and
+#               prints:
+#                 - the memory summary
+#                 - the RAM budget: each global and each variable of main(),
+#                   which holds its RAM for good, against the 768 bytes
+#                 - code size, RAM and hardware stack levels per function
+#                 - the estimated stack depth under main() and each interrupt
+#                 - every call chain in interrupt context
+#                 - an instruction cycle bound (WCET) for each function, for
+#                   hp_rfid(), lp_timer() and one iteration of the steering
+#                   loop of main()
+#               and warns of every figure which grew since the baseline:
+#                   report.py [--dir dist/default/production]
+#                             [--baseline report/baseline.txt] [--update]
+#                             [--strict]
+#               With --update the baseline is rewritten instead, and with
+#               --strict the exit status is 1 if any figure grew. The exit
+#               status is 1 regardless if the RAM used is over RAM_BYTES.
+#
+#               The cycle bound of a function is the longest path through
+#               its instructions (the maximum cycles of each, see
+#               inst_cycles()), with the bound of a callee added at each
+#               call. Loops generated by __delay_ms() and __delay_us() are
+#               simulated for their exact cycles. A function with any other
+#               loop needs an entry in LOOP_BOUNDS or WAIT_CYCLES, else it
+#               is unbounded, as is every caller.
+# =============================================================================
+import argparse
+import glob
+import os
+import re
+import sys
+
+FOSC_MIPS = 2  # Instruction cycles per us at 8 MHz
+RAM_BYTES = 768  # Data memory of the PIC18F4331
+STACK_LEVELS = 31  # Hardware return stack of the PIC18
+
+# Passes through a function with loops (other than delays), for a bound of
+# the passes times its loop-free path, calls included: one more than its
+# longest loop, or the product for nested loops. Coarse, but safe while the
+# loop counts hold
+LOOP_BOUNDS = {
+    "motor_write": 9,  # 1 << dir_pin (hal_motor_dir())
+    "motor_refresh": 3,  # 2 channels
+    "fmt_dec": 60,  # 5 digits, each at most 9 subtractions (6 for the first)
+    "fmt_hex": 5,  # 4 digits
+    "fix_mean": 17,  # 16 readings
+    "fix_norm": 8,  # 7 shifts after a whole byte
+    "ir_filter": 5,  # 4 readings
+    "get_packet_serial": 17,  # 16 bytes
+    "lcd_string": 41,  # One line of the display (40 characters)
+    "i2_lcd_string": 41,
+    "put_string_serial": 41,
+    "full_speed": 101,  # Power ramps, 0 - 100
+    "veer_left": 101,
+    "veer_right": 101,
+    "stop_all": 101,
+    "turn": 101,
+    "crc8": 9,  # 8 bits
+    "tune_reply": 11,  # Header and 6 data bytes
+    "tune_poll": 8,  # TUNE_RX_SIZE bytes
+    "rotate_by": 9,  # ROT_LEVELS
+    "bcn_init": 9,  # BCN_PULSES
+    "bcn_predict": 40,  # BCN_TRACKS x (BCN_COAST_SHIFT + 1), the longer inner loop
+    "bcn_detect": 48,  # 7 x 6 pairs of pulses, then BCN_TRACKS once
+    "bcn_pulse": 3,  # 2 sensors
+    "bcn_dump": 5,  # BCN_TRACKS
+    "cap_service": 3,  # 2 sensors
+    "adc_service": 5,  # The 4 words of the FIFO emptied
+    "bat_dump": 5,  # 4 values
+}
+
+# Cycles added to the loop-free path of a function which waits for the
+# hardware
+WAIT_CYCLES = {
+    "get_char_serial": 2084,  # One character at 9600 baud
+    "put_char_serial": 2084,
+    "ee_read": 8000,  # One data EEPROM write, 4 ms
+    "ee_write": 8000,
+}
+
+# Calls made by one pass of the steering loop of main(), delay_ms() (the
+# wait for the end of the steering action) excluded
+CONTROL_LOOP = [
+    ("get_ir", 2), ("clear_lcd", 1), ("set_line", 2), ("ir_display", 1),
+    ("lcd_string", 2), ("ir_difference", 1), ("rec_sample", 1), ("fmt_dec", 1),
+    ("steer", 1), ("tune_poll", 1),
+]
+
+UNBOUNDED = -1
+
+SKIPS = {"btfsc", "btfss", "cpfseq", "cpfsgt", "cpfslt", "decfsz", "dcfsnz",
+         "incfsz", "infsnz", "tstfsz"}
+BRANCHES = {"bc", "bnc", "bn", "bnn", "bov", "bnov", "bz", "bnz"}
+JUMPS = {"goto", "bra"}
+CALLS = {"call", "rcall"}
+RETURNS = {"return", "retfie", "retlw"}
+DATA = {"db", "dw", "ds"}
+
+DS_RE = re.compile(r"^\s*\d+\s+(?:[0-9A-F]{6}\s+)?ds\s+(\d+)")
+INST_RE = re.compile(r"^\s*\d+\s+([0-9A-F]{6})\s+([0-9A-F]{4})(?:\s+([0-9A-F]{4}))?\s+(\w+)\s*([^;]*)")
+LABEL_RE = re.compile(r"^\s*\d+\s+([0-9A-F]{6})\s+([\w?@$.]+):\s*$")
+FUNC_RE = re.compile(r"^\s*\d*\s*;; \*+ function (\S+) \*+")
+
+
+def display(name):
+    """C name of an assembly symbol."""
+    return name[1:] if name.startswith("_") else name
+
+
+class Inst:
+    def __init__(self, addr, ops, mnem, args):
+        self.addr = addr
+        self.words = len(ops)
+        self.mnem = mnem
+        self.args = [a.strip() for a in args.split(",")] if args.strip() else []
+        self.target = branch_target(addr, ops)
+
+
+def branch_target(addr, ops):
+    """Address to which a bra, rcall, conditional branch, goto or call goes,
+    decoded from its opcode (the listing names local labels which it does
+    not define), or None."""
+    w = ops[0]
+    if (w & 0xF000) == 0xD000:  # bra, rcall: 11 bit offset
+        n = w & 0x7FF
+        return addr + 2 + 2 * (n - 0x800 if n & 0x400 else n)
+    if (w & 0xF800) == 0xE000:  # Conditional branches: 8 bit offset
+        n = w & 0xFF
+        return addr + 2 + 2 * (n - 0x100 if n & 0x80 else n)
+    if (len(ops) == 2) and (((w & 0xFF00) == 0xEF00) or ((w & 0xFE00) == 0xEC00)):
+        return 2 * ((w & 0xFF) | ((ops[1] & 0xFFF) << 8))  # goto, call
+    return None
+
+
+def inst_cycles(inst):
+    """Cycles of an instruction, branches not taken and skips not skipping
+    (the extra cycles are on the edges, see Function.bound())."""
+    if inst.mnem in CALLS | RETURNS | JUMPS or inst.mnem.startswith("tbl"):
+        return 2
+    return inst.words  # movff and lfsr take 2
+
+
+class Function:
+    def __init__(self, name):
+        self.name = name
+        self.entry = None  # Address
+        self.code = []
+        self.ram = 0
+        self.stack = 0
+        self.callees = []
+        self.bound_cache = None
+        self.reason = ""
+
+    def size(self):
+        return 2 * sum(i.words for i in self.code if i.mnem not in DATA)
+
+    def index(self, addr):
+        """Index of the instruction at an address, or None if outside."""
+        for k, inst in enumerate(self.code):
+            if inst.addr == addr:
+                return k
+        return None
+
+    def delay_loops(self):
+        """Regions (first, last) of the __delay_ms() loops, with their exact
+        cycles, found as decfsz and bra pairs back to the first decfsz and
+        simulated from their counter setup."""
+        loops = {}
+        code = self.code
+        start = 0
+        while start + 1 < len(code):
+            last = start
+            while (last + 1 < len(code)) and (code[last].mnem == "decfsz") and \
+                    (code[last + 1].mnem in JUMPS) and (code[last + 1].target == code[start].addr):
+                last += 2
+            if last == start:
+                start += 1
+                continue
+            first = start
+            while (first > 0) and (code[first - 1].mnem in ("movlw", "movwf", "movlb")) and \
+                    (start - first < 8):
+                first -= 1
+            loops[first] = (last - 1, simulate_delay(code[first:last]))
+            start = last
+        return loops
+
+    def bound(self, functions, stack=()):
+        """Longest path in cycles from entry to return, UNBOUNDED if a loop or
+        callee has no bound. The reason is kept in self.reason."""
+        if self.bound_cache is not None:
+            return self.bound_cache
+        if self.name in stack:
+            self.reason = "recursion"
+            return UNBOUNDED
+        name = display(self.name)
+        delays = self.delay_loops()
+        n = len(self.code)
+        entries = {f.entry: f.name for f in functions.values()}
+        # Nodes are instruction indices, with their cycles and successors
+        cost = [0] * n
+        succ = [[] for _ in range(n)]
+        for i, inst in enumerate(self.code):
+            if inst.mnem in DATA:
+                continue
+            if i in delays:
+                end, cycles = delays[i]
+                cost[i] = cycles
+                succ[i] = [(end + 1, 0)] if end + 1 < n else []
+                continue
+            cost[i] = inst_cycles(inst)
+            local = None if inst.target is None else self.index(inst.target)
+            callee = None
+            if (inst.mnem in CALLS) or ((inst.mnem in JUMPS) and (local is None)):
+                # Call, or jump to another function (tail call)
+                callee = entries.get(inst.target)
+                if callee is None:
+                    self.reason = "jump to 0x%x, outside any function" % (inst.target or 0)
+                    self.bound_cache = UNBOUNDED
+                    return UNBOUNDED
+            if callee is not None:
+                if callee not in self.callees:
+                    self.callees.append(callee)
+                b = functions[callee].bound(functions, stack + (self.name,))
+                if b == UNBOUNDED:
+                    self.reason = "calls %s" % display(callee)
+                    self.bound_cache = UNBOUNDED
+                    return UNBOUNDED
+                cost[i] += b
+                if inst.mnem in JUMPS:
+                    continue  # Returns from the callee
+            if inst.mnem in RETURNS:
+                continue
+            if inst.mnem in JUMPS:
+                succ[i].append((local, 0))
+                continue
+            if i + 1 < n:
+                succ[i].append((i + 1, 0))
+            if inst.mnem in BRANCHES:
+                succ[i].append((local, 1))
+            elif inst.mnem in SKIPS and i + 2 < n:
+                succ[i].append((i + 2, self.code[i + 1].words))
+        for i in range(n):
+            succ[i] = [(j, w) for j, w in succ[i] if j is not None]
+
+        # Longest path by depth first search, a back edge being a loop
+        longest = {}
+        on_path = set()
+        loop = [False]
+
+        def visit(i):
+            if i in longest:
+                return longest[i]
+            if i in on_path:
+                loop[0] = True
+                return 0
+            on_path.add(i)
+            best = 0
+            for j, w in succ[i]:
+                best = max(best, w + visit(j))
+            on_path.discard(i)
+            longest[i] = cost[i] + best
+            return longest[i]
+
+        sys.setrecursionlimit(max(10000, 4 * n))
+        total = visit(0) if n > 0 else 0
+        if loop[0]:
+            if name in WAIT_CYCLES:
+                # Loop-free path: every node once
+                total = sum(cost) + WAIT_CYCLES[name]
+            elif name in LOOP_BOUNDS:
+                total = sum(cost) * LOOP_BOUNDS[name]
+            elif re.match(r"^__[al]?[wl](div|mod|mul)$", name):
+                # Run time library, one pass per bit
+                total = sum(cost) * (33 if name.rstrip("divmul")[-1] == "w" else 65)
+            else:
+                self.reason = "loop without a bound (see LOOP_BOUNDS)"
+                total = UNBOUNDED
+        self.bound_cache = total
+        return total
+
+
+def simulate_delay(code):
+    """Cycles of a delay loop, from its counter setup to its last skip."""
+    regs = {}
+    w = 0
+    pc = 0
+    cycles = 0
+    while pc < len(code):
+        inst = code[pc]
+        if inst.mnem == "movlw":
+            w = int(inst.args[0], 0) & 255
+            cycles += 1
+        elif inst.mnem == "movwf":
+            regs[inst.args[0]] = w
+            cycles += 1
+        elif (inst.mnem == "decfsz") and (pc + 1 < len(code)) and \
+                (code[pc + 1].target == inst.addr):
+            # Innermost loop, run to zero: 3 cycles a pass, 2 for the last
+            value = w if inst.args[0] == "wreg" else regs.get(inst.args[0], 0)
+            cycles += 3 * (((value - 1) & 255) + 1) - 1
+            if inst.args[0] == "wreg":
+                w = 0
+            else:
+                regs[inst.args[0]] = 0
+            pc += 2
+            continue
+        elif inst.mnem == "decfsz":
+            if inst.args[0] == "wreg":
+                w = (w - 1) & 255
+                value = w
+            else:
+                regs[inst.args[0]] = (regs.get(inst.args[0], 0) - 1) & 255
+                value = regs[inst.args[0]]
+            if value == 0:
+                cycles += 2
+                pc += 2
+                continue
+            cycles += 1
+        elif inst.mnem in JUMPS:
+            cycles += 2
+            pc = [k for k, c in enumerate(code) if c.addr == inst.target][0]
+            continue
+        else:
+            cycles += inst_cycles(inst)
+        pc += 1
+    return cycles
+
+
+def parse_lst(path):
+    """Functions of the listing, and the stack depth of each call graph."""
+    functions = {}
+    depths = []
+    current = None
+    in_code = False
+    graph_root = None
+    with open(path, errors="replace") as f:
+        for raw in f:
+            line = raw.rstrip("\r\n")
+            m = FUNC_RE.match(line)
+            if m:
+                current = Function(m.group(1))
+                functions[current.name] = current
+                in_code = False
+                continue
+            m = re.match(r"^\s*\((\d+)\) (\S+)", line)
+            if m and graph_root is None:
+                graph_root = m.group(2)
+            m = re.match(r"^\s*Estimated maximum stack depth (\d+)", line)
+            if m:
+                depths.append((graph_root, int(m.group(1))))
+                graph_root = None
+                continue
+            if current is None:
+                continue
+            m = re.match(r"^\s*\d*\s*;;Total ram usage:\s+(\d+)", line)
+            if m:
+                current.ram = int(m.group(1))
+            m = re.match(r"^\s*\d*\s*;; Hardware stack levels required when called:\s+(\d+)", line)
+            if m:
+                current.stack = int(m.group(1))
+            m = LABEL_RE.match(line)
+            if m:
+                if m.group(2) == current.name:
+                    in_code = True
+                    current.entry = int(m.group(1), 16)
+                elif m.group(2) in ("__end_of_" + current.name.lstrip("_"),
+                                    "__end_of_" + current.name):
+                    in_code = False
+                continue
+            m = INST_RE.match(line)
+            if m and in_code:
+                ops = [int(op, 16) for op in m.group(2, 3) if op]
+                current.code.append(Inst(int(m.group(1), 16), ops, m.group(4).lower(), m.group(5)))
+    return functions, depths
+
+
+def parse_mum(path):
+    """Used and total size of each memory space, and its unit."""
+    spaces = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            m = re.match(r"^\s*(.+?)\s+used\s+\w+h \(\s*(\d+)\) of\s+(\w+)h (\w+)", line)
+            if m:
+                spaces[m.group(1)] = (int(m.group(2)), int(m.group(3), 16), m.group(4))
+    return spaces
+
+
+def parse_ram(lst_path, map_path):
+    """Bytes of each global, from the ds directives of the data psects of
+    the listing, and of each variable of main(), from the function
+    information of the map."""
+    ram = {}
+    labels = []
+    in_data = False
+    with open(lst_path, errors="replace") as f:
+        for line in f:
+            m = re.match(r"^\s*\d+\s+psect\s+(\w+)", line)
+            if m:
+                in_data = re.match(r"(bss|data|nv)", m.group(1)) is not None
+                labels = []
+                continue
+            m = LABEL_RE.match(line)
+            if m and in_data and not m.group(2).startswith("__"):
+                labels.append(m.group(2))
+                continue
+            m = DS_RE.match(line)
+            if m:
+                for label in labels:
+                    ram[display(label)] = int(m.group(1))
+                labels = []
+    if map_path is None:
+        return ram
+    in_main = False
+    with open(map_path, errors="replace") as f:
+        for line in f:
+            m = re.match(r"^\s*\*+ function (\S+) \*+", line)
+            if m:
+                in_main = m.group(1) == "_main"
+                continue
+            m = re.match(r"^\s+(\w+)\s+(\d+)\s+\d+\[\s*\w+\s*\]", line)
+            if m and in_main:
+                ram["main@" + m.group(1)] = int(m.group(2))
+    return ram
+
+
+def chains(functions, name, prefix=()):
+    """Every call chain from a function to a leaf."""
+    f = functions.get(name)
+    path = prefix + (display(name),)
+    if (f is None) or (not f.callees) or (name in prefix):
+        return [path]
+    out = []
+    for callee in f.callees:
+        out += chains(functions, callee, path)
+    return out
+
+
+def cycles_text(cycles, reason=""):
+    if cycles == UNBOUNDED:
+        return "unbounded" + (" (%s)" % reason if reason else "")
+    return "%d (%.1f us)" % (cycles, cycles / FOSC_MIPS)
+
+
+def read_baseline(path):
+    figures = {}
+    if os.path.exists(path):
+        with open(path) as f:
+            for line in f:
+                fields = line.split()
+                if len(fields) == 3:
+                    figures[(fields[0], fields[1])] = int(fields[2])
+    return figures
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Post-build report of the XC8 outputs")
+    parser.add_argument("--dir", default="dist/default/production")
+    parser.add_argument("--baseline", default="report/baseline.txt")
+    parser.add_argument("--update", action="store_true")
+    parser.add_argument("--strict", action="store_true")
+    args = parser.parse_args()
+
+    lst = glob.glob(os.path.join(args.dir, "*.lst"))
+    mum = glob.glob(os.path.join(args.dir, "*.mum"))
+    if not lst:
+        print("report: no .lst file in %s, build the project first" % args.dir, file=sys.stderr)
+        return 2
+    functions, depths = parse_lst(lst[0])
+    figures = {}
+
+    spaces = parse_mum(mum[0]) if mum else {}
+    print("Memory")
+    for space, (used, total, unit) in spaces.items():
+        print("  %-20s %6d of %6d %-5s (%.1f%%)" % (space, used, total, unit,
+                                                   100.0 * used / total if total else 0))
+        figures[("memory", space.replace(" ", "_").lower())] = used
+
+    ram = parse_ram(lst[0], (glob.glob(os.path.join(args.dir, "*.map")) or [None])[0])
+    held = sum(ram.values())
+    data = spaces.get("Data space", (held,))[0]
+    print("\nRAM budget (%d of %d bytes used, %d free)" % (data, RAM_BYTES, RAM_BYTES - data))
+    for name in sorted(ram, key=lambda n: (-ram[n], n)):
+        print("  %-22s %5d" % (name, ram[name]))
+        figures[("ram", name)] = ram[name]
+    print("  %-22s %5d" % ("stack and temporaries", data - held))
+    if data > RAM_BYTES:
+        print("ERROR RAM used is %d bytes, over the %d of the PIC18F4331" % (data, RAM_BYTES))
+
+    print("\nFunctions")
+    print("  %-22s %6s %5s %6s  %s" % ("name", "bytes", "ram", "stack", "cycle bound"))
+    for name in sorted(functions, key=lambda n: -functions[n].size()):
+        f = functions[name]
+        b = f.bound(functions)
+        print("  %-22s %6d %5d %6d  %s" % (display(name), f.size(), f.ram, f.stack,
+                                           cycles_text(b, f.reason)))
+        figures[("code", display(name))] = f.size()
+        figures[("wcet", display(name))] = b
+
+    print("\nStack depth (hardware stack of %d levels)" % STACK_LEVELS)
+    for root, depth in depths:
+        print("  %-22s %d" % (display(root or "?"), depth))
+        figures[("stack", display(root or "?"))] = depth
+
+    for isr in ("_hp_rfid", "_lp_timer"):
+        if isr not in functions:
+            continue
+        print("\nInterrupt context of %s" % display(isr))
+        for chain in chains(functions, isr):
+            print("  " + " > ".join(chain))
+
+    print("\nCycle bounds")
+    for isr in ("_hp_rfid", "_lp_timer"):
+        if isr in functions:
+            f = functions[isr]
+            print("  %-22s %s" % (display(isr), cycles_text(f.bound(functions), f.reason)))
+    total = 0
+    missing = []
+    for name, calls in CONTROL_LOOP:
+        f = functions.get("_" + name)
+        if f is None:
+            missing.append(name)
+            continue
+        b = f.bound(functions)
+        total = UNBOUNDED if (total == UNBOUNDED) or (b == UNBOUNDED) else total + calls * b
+    figures[("wcet", "control_loop")] = total
+    print("  %-22s %s" % ("steering iteration", cycles_text(total)))
+    if missing:
+        print("    (not in listing, so not counted: %s)" % ", ".join(missing))
+
+    over = 1 if data > RAM_BYTES else 0
+    if args.update:
+        with open(args.baseline, "w") as f:
+            for (kind, name), value in sorted(figures.items()):
+                f.write("%s %s %d\n" % (kind, name, value))
+        print("\nbaseline written to %s" % args.baseline)
+        return over
+    old = read_baseline(args.baseline)
+    grown = 0
+    for key, value in sorted(figures.items()):
+        if key not in old:
+            continue
+        was = old[key]
+        if ((value == UNBOUNDED) and (was != UNBOUNDED)) or \
+                ((was != UNBOUNDED) and (value > was)):
+            if grown == 0:
+                print()
+            print("WARNING %s %s grew from %s to %s" % (key[0], key[1], was,
+                                                       "unbounded" if value == UNBOUNDED else value))
+            grown = 1
+    if old and not grown:
+        print("\nnothing grew since %s" % args.baseline)
+    return (grown if args.strict else 0) | over
+
+
+if __name__ == "__main__":
+    sys.exit(main())
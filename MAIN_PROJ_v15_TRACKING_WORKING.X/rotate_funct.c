@@ -0,0 +1,255 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for all on the spot rotation
+ |               functions. The turn rate of the vehicle at each power level is
+ |               measured against the beacon by calibrate_rotation(), allowing
+ |               rotate_by() to turn the vehicle by a given angle rather than
+ |               for a fixed time. The description of the struct Rotation can
+ |               be found on the header file rotate_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "lcd_funct.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "fmt_funct.h"
+#include "fix_funct.h"
+
+// Power levels at which the turn rate is calibrated, in ascending order
+const unsigned char rot_power[ROT_LEVELS] = {50, 70, 90};
+
+/*=============================================================================
+ |  Function init_rotation
+ |
+ |  Purpose: init_rotation marks every power level of the Rotation structure
+ |           as not calibrated
+ |
+ |  Parameters:
+ |      *rot (struct Rotation) - Address of an instance of the Rotation
+ |                               structure
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void init_rotation(struct Rotation *rot) {
+    unsigned char k;
+    for (k = 0; k < ROT_LEVELS; k++) {
+        rot->rate[k] = 0;
+    }
+}
+
+/*=============================================================================
+ |  Function measure_rate
+ |
+ |  Purpose: measure_rate turns the vehicle right on the spot at the given
+ |           power, and times ROT_CAL_REVS revolutions between passes of the
+ |           beacon. The time of each pass is taken at its intensity peak.
+ |
+ |  Parameters:
+ |      *mL (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |      *mR (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |      power (char) - Power at which to turn, 0 - 100
+ |
+ |  Returns:
+ |      Unsigned integer of the turn rate in milli-degrees per ms, or zero if
+ |      the beacon was not seen often enough or the button was pressed
+ |
+ |  Comments: CAPxBUF holds its last value when no pulses are received, so
+ |            only readings which have changed are considered. As the beacon
+ |            only pulses every 250ms, each peak is accurate to 250ms at best,
+ |            hence several revolutions are timed. The first pass is discarded,
+ |            as the vehicle may have started with the beacon part way
+ |            through its field of view.
++============================================================================*/
+
+unsigned int measure_rate(struct DC_motor *mL, struct DC_motor *mR, char power) {
+    unsigned int start, now;
+    unsigned int t_seen = 0, t_peak = 0, t_first = 0;
+    unsigned int left, right, last_left, last_right;
+    unsigned int intensity, peak = 0;
+    unsigned char passes = 0;
+    unsigned char in_view = 0;
+
+    turn(mL, mR, 1, power);
+    last_left = get_ir(1);
+    last_right = get_ir(0);
+    start = time_ms();
+    while ((passes < ROT_CAL_REVS + 2) & (G_run == 0)) {
+        now = time_ms();
+        if ((unsigned int) (now - start) > ROT_CAL_TIMEOUT_MS) {
+            break; // Beacon not found
+        }
+        left = get_ir(1);
+        right = get_ir(0);
+        if ((left != last_left) | (right != last_right)) {
+            // New pulse received
+            last_left = left;
+            last_right = right;
+            intensity = (left >> 1) + (right >> 1);
+            if ((left > G_params.ir_min) | (right > G_params.ir_min)) {
+                // Beacon in view, track the peak of this pass
+                if ((in_view == 0) | (intensity > peak)) {
+                    peak = intensity;
+                    t_peak = now;
+                }
+                in_view = 1;
+                t_seen = now;
+            }
+        }
+        if ((in_view == 1) & ((unsigned int) (now - t_seen) > ROT_CAL_GAP_MS)) {
+            // Beacon has left the field of view, pass complete
+            if (passes == 1) {
+                t_first = t_peak;
+            }
+            passes++;
+            in_view = 0;
+        }
+        __delay_ms(5);
+    }
+    stop_all(mL, mR);
+
+    if (passes < ROT_CAL_REVS + 2) {
+        return 0;
+    }
+    return (unsigned int) ((360000UL * ROT_CAL_REVS) / (unsigned int) (t_peak - t_first));
+}
+
+/*=============================================================================
+ |  Function calibrate_rotation
+ |
+ |  Purpose: calibrate_rotation measures the turn rate at each power level in
+ |           rot_power and stores it in the Rotation structure, displaying
+ |           each result on the LCD
+ |
+ |  Parameters:
+ |      *rot (struct Rotation) - Address of an instance of the Rotation
+ |                               structure
+ |      *cont (struct Control) - Address of an instance of the Control
+ |                               structure, for its display buffer
+ |      *mL (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |      *mR (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The beacon must be switched on and within range. A level which
+ |            fails to calibrate keeps its previous value. Pressing the button
+ |            aborts the calibration.
++============================================================================*/
+
+void calibrate_rotation(struct Rotation *rot, struct Control *cont, struct DC_motor *mL, struct DC_motor *mR) {
+    unsigned char k;
+    unsigned int rate;
+
+    for (k = 0; (k < ROT_LEVELS) & (G_run == 0); k++) {
+        clear_lcd();
+        set_line(1);
+        lcd_string(TEXT("CAL ROT P"));
+        fmt_dec(cont->ir_buf, rot_power[k], 5);
+        lcd_string(cont->ir_buf);
+
+        rate = measure_rate(mL, mR, rot_power[k]);
+
+        // Display turn rate in degrees per second
+        set_line(2);
+        if (rate == 0) {
+            lcd_string(TEXT("FAIL"));
+        } else {
+            rot->rate[k] = rate;
+            fmt_dec(cont->ir_buf, rate, 5);
+            lcd_string(cont->ir_buf);
+            lcd_string(TEXT("DEG/S"));
+        }
+        delay_s(2);
+    }
+}
+
+/*=============================================================================
+ |  Function rotate_by
+ |
+ |  Purpose: rotate_by turns the vehicle on the spot by the given angle in the
+ |           least time, based on the calibrated turn rates. The turn is
+ |           planned as a ramp up, a coast at constant power and a ramp down.
+ |
+ |  Parameters:
+ |      *rot (struct Rotation) - Address of an instance of the Rotation
+ |                               structure
+ |      *mL (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |      *mR (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |      angle (int) - Angle to turn in degrees, positive to the right and
+ |                    negative to the left
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: turn() and stop_all() ramp the power by 1 every 2 ms. Taking the
+ |            turn rate to be proportional to power, ramping to power p covers
+ |            rate * p milli-degrees each way. The highest power whose ramps
+ |            fit within the angle gives the shortest turn; if none fit, the
+ |            lowest power is used with no coast, and the vehicle overshoots
+ |            slightly. The vehicle does not turn if no level is calibrated.
++============================================================================*/
+
+void rotate_by(struct Rotation *rot, struct DC_motor *mL, struct DC_motor *mR, int angle) {
+    unsigned long target; // Angle in milli-degrees
+    unsigned long ramp = 0; // Angle covered while ramping up and down
+    unsigned long coast = 0; // Time at constant power in ms
+    unsigned char direction = 1; // 0: left, 1: right
+    unsigned char level = ROT_LEVELS; // ROT_LEVELS if none calibrated
+    signed char k;
+
+    if (angle < 0) {
+        direction = 0;
+        angle = -angle;
+    }
+    target = fix_mul16(angle, 1000);
+
+    // Highest calibrated power whose ramps fit, else lowest calibrated power
+    for (k = ROT_LEVELS - 1; k >= 0; k--) {
+        if (rot->rate[k] != 0) {
+            level = k;
+            ramp = fix_mul16(rot->rate[k], rot_power[k]) << 1;
+            if (ramp <= target) {
+                break;
+            }
+        }
+    }
+    if (level == ROT_LEVELS) {
+        return; // Not calibrated
+    }
+
+    if (target > ramp) {
+        coast = (target - ramp) / rot->rate[level];
+        if (coast > 60000) {
+            coast = 60000; // Limit of delay_ms
+        }
+    }
+    turn(mL, mR, direction, rot_power[level]);
+    delay_ms((unsigned int) coast);
+    stop_all(mL, mR);
+}
@@ -0,0 +1,65 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for all on the spot rotation
+ |               functions. The main interface is via the structure Rotation,
+ |               which holds the calibrated turn rates. Detailed function
+ |               descriptions can be found in the rotate_funct.c file
+ +===========================================================================*/
+
+#ifndef ROTATE_FUNCT_H
+#define	ROTATE_FUNCT_H
+
+#define ROT_LEVELS 3 // Number of calibrated power levels
+#define ROT_CAL_REVS 3 // Revolutions timed per power level
+#define ROT_CAL_GAP_MS 500 // No sightings for this long ends a beacon pass
+#define ROT_CAL_TIMEOUT_MS 20000 // Give up on a power level after 20s
+
+/*=============================================================================
+ |  Structure Rotation
+ |
+ |  Purpose: Turn rate model of the vehicle when turning on the spot, obtained
+ |           by calibrate_rotation() and used by rotate_by()
+ |
+ |  Parameters:
+ |      rate[ROT_LEVELS] (uint16_t) - Turn rate in milli-degrees per ms (i.e.
+ |                                    degrees per second) at each power in
+ |                                    rot_power, 0 if that level has not
+ |                                    been calibrated
+ |
+ |  Comments: Power levels are stored in program memory as rot_power, in
+ |            ascending order. Fixed width type, as it is stored in the data
+ |            EEPROM (see hal.h).
+ |
++============================================================================*/
+
+struct Rotation {
+    uint16_t rate[ROT_LEVELS];
+};
+
+extern const unsigned char rot_power[ROT_LEVELS];
+
+void init_rotation(struct Rotation *rot);
+void calibrate_rotation(struct Rotation *rot, struct Control *cont, struct DC_motor *mL, struct DC_motor *mR);
+void rotate_by(struct Rotation *rot, struct DC_motor *mL, struct DC_motor *mR, int angle);
+
+#endif
@@ -0,0 +1,261 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make bench")
+ |  Microchip: PIC18F4331 (simulated)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the main file of eod_bench, which simulates every
+ |               scenario of the table bench_scenarios with BENCH_SEEDS noise
+ |               seeds, prints the mission KPIs of each and compares them
+ |               with a stored baseline:
+ |                   eod_bench baseline=sim/baseline.txt [tolerance=0.05]
+ |                   eod_bench baseline=sim/baseline.txt update
+ |               A scenario regresses if fewer runs read the card than in the
+ |               baseline, or if its mean mission time (button press to
+ |               checksum, or to the time limit) grows by more than the
+ |               tolerance plus BENCH_SLACK_MS, or its mean return error by
+ |               more than the tolerance plus BENCH_SLACK_M. The exit status
+ |               is 1 if any scenario regresses, so "make bench" fails. With
+ |               "update", the baseline is rewritten with the results
+ |               instead. Further arguments are "name=value" options of
+ |               sim_set(), applied to every scenario before its own.
+ +===========================================================================*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+
+#define BENCH_SEEDS 30 // Runs of each scenario, with different noise
+#define BENCH_SLACK_MS 500 // Mission time allowed to grow regardless
+#define BENCH_SLACK_M 0.1 // Return error allowed to grow regardless
+#define BENCH_ARGS 8 // Options of a scenario
+
+// Scenarios, with the options applied to sim_default()
+struct BenchScenario {
+    const char *name;
+    const char *args[BENCH_ARGS];
+};
+
+static const struct BenchScenario bench_scenarios[] = {
+    {"straight", {"beacon_deg=0"}},
+    {"behind", {"beacon_deg=180"}},
+    {"left_90", {"beacon_deg=90"}},
+    {"occluded", {"occl_from_ms=5000", "occl_to_ms=9000"}},
+    {"noisy", {"noise=600", "dropout=0.2"}},
+    // CAL IR from the menu first, with the turn rates CAL ROT measures here
+    {"mismatched", {"gain_left=0.7", "gain_right=1.1", "strength=30", "rot_rate1=93",
+            "rot_rate2=127", "menu=CAL IR", "start_ms=25000"}},
+    {"weak_battery", {"battery=0.7"}},
+    {"stray", {"stray_strength=20"}},
+    // Card read before the forward run of orientate() ends
+    {"near", {"beacon_dist=0.8"}},
+};
+
+#define BENCH_COUNT (sizeof (bench_scenarios) / sizeof (bench_scenarios[0]))
+
+// KPIs of a scenario, means over its runs
+struct BenchKpi {
+    char name[32];
+    int success, runs;
+    double t_centre, t_tag, t_end, path, corrections, return_err;
+};
+
+/*=============================================================================
+ |  Function bench_run
+ |
+ |  Purpose: bench_run simulates a scenario BENCH_SEEDS times and averages
+ |           its KPIs
+ |
+ |  Parameters:
+ |      *scenario (struct BenchScenario) - Address of the scenario
+ |      *base (struct SimConfig) - Configuration common to every scenario
+ |      *kpi (struct BenchKpi) - Address of the KPIs to be written
+ |
+ |  Returns:
+ |      Integer of 0 if every run was simulated, -1 if not
+ |
+ |  Comments: Times to centre and tag are averaged over the runs which
+ |            reached them (-1 if none), the return error over the
+ |            successful runs, and the rest over every run.
++============================================================================*/
+
+static int bench_run(const struct BenchScenario *scenario, const struct SimConfig *base,
+        struct BenchKpi *kpi) {
+    struct SimConfig cfg;
+    struct SimResult res;
+    int centred = 0;
+    int seed, i;
+
+    memset(kpi, 0, sizeof (*kpi));
+    strncpy(kpi->name, scenario->name, sizeof (kpi->name) - 1);
+    for (seed = 1; seed <= BENCH_SEEDS; seed++) {
+        cfg = *base;
+        for (i = 0; (i < BENCH_ARGS) && (scenario->args[i] != 0); i++) {
+            sim_set(&cfg, scenario->args[i]);
+        }
+        cfg.seed = seed;
+        if (sim_run(&cfg, &res) != 0) {
+            return -1;
+        }
+        kpi->runs++;
+        if (res.t_centre >= 0) {
+            centred++;
+            kpi->t_centre += res.t_centre;
+        }
+        if (res.tagged & res.finished) {
+            kpi->success++;
+            kpi->t_tag += res.t_tag;
+            kpi->return_err += res.return_err;
+        }
+        kpi->t_end += res.t_end;
+        kpi->path += res.path;
+        kpi->corrections += res.corrections;
+    }
+    kpi->t_centre = (centred > 0) ? kpi->t_centre / centred : -1;
+    kpi->t_tag = (kpi->success > 0) ? kpi->t_tag / kpi->success : -1;
+    kpi->return_err = (kpi->success > 0) ? kpi->return_err / kpi->success : -1;
+    kpi->t_end /= kpi->runs;
+    kpi->path /= kpi->runs;
+    kpi->corrections /= kpi->runs;
+    return 0;
+}
+
+/*=============================================================================
+ |  Function bench_write
+ |
+ |  Purpose: bench_write writes the KPIs of a scenario on one line, as read
+ |           by bench_read()
+ |
+ |  Parameters:
+ |      *out (FILE) - Stream to write to
+ |      *kpi (struct BenchKpi) - Address of the KPIs
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void bench_write(FILE *out, const struct BenchKpi *kpi) {
+    fprintf(out, "%-13s success=%d/%d t_centre=%.0f t_tag=%.0f t_end=%.0f path=%.3f "
+            "corrections=%.1f return_err=%.3f\n",
+            kpi->name, kpi->success, kpi->runs, kpi->t_centre, kpi->t_tag, kpi->t_end,
+            kpi->path, kpi->corrections, kpi->return_err);
+}
+
+/*=============================================================================
+ |  Function bench_read
+ |
+ |  Purpose: bench_read reads the baseline KPIs of a scenario
+ |
+ |  Parameters:
+ |      *path (char) - Baseline file
+ |      *name (char) - Name of the scenario
+ |      *kpi (struct BenchKpi) - Address of the KPIs to be written
+ |
+ |  Returns:
+ |      Integer of 0 if found, -1 if not
++============================================================================*/
+
+static int bench_read(const char *path, const char *name, struct BenchKpi *kpi) {
+    FILE *in = fopen(path, "r");
+    char line[256];
+    int found = -1;
+
+    if (in == 0) {
+        return -1;
+    }
+    while ((found != 0) && (fgets(line, sizeof (line), in) != 0)) {
+        memset(kpi, 0, sizeof (*kpi));
+        if ((sscanf(line, "%31s success=%d/%d t_centre=%lf t_tag=%lf t_end=%lf path=%lf "
+                "corrections=%lf return_err=%lf",
+                kpi->name, &kpi->success, &kpi->runs, &kpi->t_centre, &kpi->t_tag,
+                &kpi->t_end, &kpi->path, &kpi->corrections, &kpi->return_err) == 9) &&
+                (strcmp(kpi->name, name) == 0)) {
+            found = 0;
+        }
+    }
+    fclose(in);
+    return found;
+}
+
+int main(int argc, char **argv) {
+    struct SimConfig base;
+    struct BenchKpi kpi[BENCH_COUNT];
+    struct BenchKpi old;
+    const char *baseline = 0;
+    double tolerance = 0.05;
+    int update = 0;
+    int failed = 0;
+    FILE *out;
+    unsigned int i;
+    int a;
+
+    sim_default(&base);
+    for (a = 1; a < argc; a++) {
+        if (strncmp(argv[a], "baseline=", 9) == 0) {
+            baseline = argv[a] + 9;
+        } else if (strncmp(argv[a], "tolerance=", 10) == 0) {
+            tolerance = atof(argv[a] + 10);
+        } else if (strcmp(argv[a], "update") == 0) {
+            update = 1;
+        } else if (sim_set(&base, argv[a]) != 0) {
+            fprintf(stderr, "eod_bench: unknown option %s\n", argv[a]);
+            return 2;
+        }
+    }
+
+    for (i = 0; i < BENCH_COUNT; i++) {
+        if (bench_run(&bench_scenarios[i], &base, &kpi[i]) != 0) {
+            fprintf(stderr, "eod_bench: simulation of %s failed\n", bench_scenarios[i].name);
+            return 2;
+        }
+        bench_write(stdout, &kpi[i]);
+        if ((baseline == 0) || (update == 1)) {
+            continue;
+        }
+        if (bench_read(baseline, kpi[i].name, &old) != 0) {
+            printf("  %s: not in baseline\n", kpi[i].name);
+        } else if (kpi[i].success < old.success) {
+            printf("  REGRESSION %s: card read in %d of %d runs, was %d\n",
+                    kpi[i].name, kpi[i].success, kpi[i].runs, old.success);
+            failed = 1;
+        } else if (kpi[i].t_end > old.t_end * (1 + tolerance) + BENCH_SLACK_MS) {
+            printf("  REGRESSION %s: mission time %.0f ms, was %.0f ms\n",
+                    kpi[i].name, kpi[i].t_end, old.t_end);
+            failed = 1;
+        } else if (kpi[i].return_err > old.return_err * (1 + tolerance) + BENCH_SLACK_M) {
+            printf("  REGRESSION %s: return error %.3f m, was %.3f m\n",
+                    kpi[i].name, kpi[i].return_err, old.return_err);
+            failed = 1;
+        } else if ((kpi[i].success > old.success) || (kpi[i].t_end < old.t_end * (1 - tolerance))) {
+            printf("  improved %s: card read in %d runs, mission time %.0f ms (was %d, %.0f ms)\n",
+                    kpi[i].name, kpi[i].success, kpi[i].t_end, old.success, old.t_end);
+        }
+    }
+
+    if ((baseline != 0) && (update == 1)) {
+        out = fopen(baseline, "w");
+        if (out == 0) {
+            fprintf(stderr, "eod_bench: cannot write %s\n", baseline);
+            return 2;
+        }
+        for (i = 0; i < BENCH_COUNT; i++) {
+            bench_write(out, &kpi[i]);
+        }
+        fclose(out);
+        printf("baseline written to %s\n", baseline);
+    } else if (baseline != 0) {
+        printf(failed ? "benchmark FAILED against %s\n" : "benchmark passed against %s\n", baseline);
+    }
+    return failed;
+}
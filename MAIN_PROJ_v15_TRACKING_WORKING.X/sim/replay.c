@@ -0,0 +1,487 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make replay")
+ |  Microchip: PIC18F4331 (simulated)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the main file of eod_replay, which runs the firmware
+ |               (built with REPLAY_LOG, as on the vehicle) against a sensor
+ |               log instead of the vehicle model, and compares the motor
+ |               outputs with those recorded (see replay_funct.h):
+ |                   eod_replay run.log [veer=30 ...]
+ |               Every IR reading returns the recorded capture, in order,
+ |               after checking that the same sensor is read, and the PWM
+ |               duty and direction pins at that moment are compared with
+ |               the record. Button presses and RFID packets are injected
+ |               after the same number of readings and the same time since
+ |               the last one as recorded, or just before the next reading
+ |               if that comes sooner, as are the changes of the duty scale
+ |               of the supply, which is not sampled in the replay (see
+ |               battery_funct.h). The recorded parameters are loaded at
+ |               power up and at every button press, then any "name=value"
+ |               parameter arguments applied over them, to show which
+ |               outputs a change of parameter or control code alters.
+ |               The log is the raw serial output of the vehicle, e.g. from a
+ |               USB serial adapter on TX, and frames which are not TUNE_LOG
+ |               records, or fail the CRC, are skipped. Only the first power
+ |               up of the log is replayed.
+ |               A log can also be recorded on the simulator:
+ |                   eod_replay record=run.log [beacon_deg=30 ...]
+ |               where the arguments are options of sim_set().
+ |               Once every record has been replayed, the firmware runs on
+ |               until the checksum is displayed, or for REPLAY_TAIL_MS.
+ |               The exit status is 0 if every reading was replayed with the
+ |               same outputs, 1 if not, and 2 on an error.
+ +===========================================================================*/
+#include "hal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "tune_funct.h"
+#include "replay_funct.h"
+#include "battery_funct.h"
+#include "sim.h"
+
+#define REPLAY_FRAME (RPL_DATA + 4) // Bytes of a TUNE_LOG frame
+#define REPLAY_PRESS_MS 100 // Duration of an injected button press
+#define REPLAY_TAIL_MS 100000 // Run on after the last record, for the return
+#define REPLAY_STALL_MS 120000 // Longest wait for the next IR reading
+#define REPLAY_SHOW 10 // Differences printed in full
+
+void fw_main(void); // main() of main.c, renamed by the Makefile
+
+// Record of the log, see replay_funct.h
+struct ReplayRecord {
+    unsigned char seq, type;
+    unsigned int value, time;
+    unsigned char duty[2], dir;
+};
+
+static struct ReplayRecord *replay_log;
+static long replay_count; // Records in the log
+static long replay_lost; // Records missing from the sequence
+static const struct SimConfig *replay_cfg; // Parameters to apply over the log
+
+// Progress of the replay
+static long replay_next; // Next record to be replayed
+static long replay_reads; // IR readings replayed
+static long replay_total; // IR readings in the log
+static long replay_presses, replay_packets;
+static unsigned long replay_last_us; // hal_host_us of the last reading
+static unsigned int replay_last_ms; // Recorded time of the last reading
+static unsigned long replay_release_us; // End of the button press, 0 if none
+static long replay_diffs; // Readings with different outputs
+static long replay_first = -1; // First of them
+
+/*=============================================================================
+ |  Function replay_load
+ |
+ |  Purpose: replay_load reads the records of the first power up of a log
+ |
+ |  Parameters:
+ |      *path (char) - Log file, raw serial output
+ |
+ |  Returns:
+ |      Integer of 0 if read, -1 if the file cannot be read or holds no
+ |      records
+ |
+ |  Comments: Sequence numbers which are skipped are counted in replay_lost.
++============================================================================*/
+
+static int replay_load(const char *path) {
+    FILE *in = fopen(path, "rb");
+    unsigned char *buf;
+    long size, i, n;
+    unsigned char crc;
+    unsigned char *f;
+    struct ReplayRecord *r;
+
+    if (in == 0) {
+        return -1;
+    }
+    fseek(in, 0, SEEK_END);
+    size = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    buf = malloc(size + 1);
+    replay_log = malloc((size / REPLAY_FRAME + 1) * sizeof (struct ReplayRecord));
+    if ((buf == 0) || (replay_log == 0) || (fread(buf, 1, size, in) != (size_t) size)) {
+        fclose(in);
+        return -1;
+    }
+    fclose(in);
+
+    replay_count = 0;
+    for (i = 0; i + REPLAY_FRAME <= size; i++) {
+        f = buf + i;
+        if ((f[0] != TUNE_SOF) || (f[1] != RPL_DATA + 1) || (f[2] != (TUNE_LOG | 0x80))) {
+            continue;
+        }
+        crc = 0;
+        for (n = 1; n < REPLAY_FRAME - 1; n++) {
+            crc = crc8(crc, f[n]);
+        }
+        if (crc != f[REPLAY_FRAME - 1]) {
+            continue;
+        }
+        if ((f[4] == RPL_BOOT) && (replay_count > 0)) {
+            printf("replaying the first of several power ups in %s\n", path);
+            break;
+        }
+        r = &replay_log[replay_count];
+        r->seq = f[3];
+        r->type = f[4];
+        r->value = (f[5] << 8) | f[6];
+        r->time = (f[7] << 8) | f[8];
+        r->duty[0] = f[9];
+        r->duty[1] = f[10];
+        r->dir = f[11];
+        if (replay_count > 0) {
+            replay_lost += (unsigned char) (r->seq - replay_log[replay_count - 1].seq - 1);
+        }
+        if ((r->type & 0xF0) == RPL_IR) {
+            replay_total++;
+        }
+        replay_count++;
+        i += REPLAY_FRAME - 1;
+    }
+    free(buf);
+    return (replay_count > 0) ? 0 : -1;
+}
+
+/*=============================================================================
+ |  Function replay_params
+ |
+ |  Purpose: replay_params loads the group of RPL_PARAM records starting at
+ |           a record into G_params, then applies the parameters given as
+ |           arguments
+ |
+ |  Parameters:
+ |      first (long) - Index of the first record of the group
+ |
+ |  Returns:
+ |      Long of the index of the record after the group
++============================================================================*/
+
+static long replay_params(long first) {
+    long k = first;
+    unsigned char i;
+
+    for (; (k < replay_count) && ((replay_log[k].type & 0xF0) == RPL_PARAM); k++) {
+        i = replay_log[k].type & 0x0F;
+        if (i < PAR_COUNT) {
+            param_set(i, replay_log[k].value);
+            continue;
+        }
+        i -= PAR_COUNT;
+        if (i < ROT_LEVELS) {
+            G_params.rot.rate[i] = replay_log[k].value;
+        } else if (i < ROT_LEVELS + 2) {
+            G_params.cal.gain[i - ROT_LEVELS] = replay_log[k].value;
+        } else if (i < ROT_LEVELS + 4) {
+            G_params.cal.offset[i - ROT_LEVELS - 2] = (int16_t) replay_log[k].value;
+        }
+    }
+    for (i = 0; i < SIM_PARAMS; i++) {
+        if (replay_cfg->par[i] >= 0) {
+            param_set(i, replay_cfg->par[i]);
+        }
+    }
+    return k;
+}
+
+/*=============================================================================
+ |  Function replay_finish
+ |
+ |  Purpose: replay_finish prints the outcome of the replay and exits
+ |
+ |  Parameters:
+ |      why (char) - Reason for stopping, 0 if the log was replayed
+ |
+ |  Returns: Nothing (Does not return)
++============================================================================*/
+
+static void replay_finish(const char *why) {
+    printf("replayed %ld of %ld IR readings, %ld button presses, %ld RFID packets\n",
+            replay_reads, replay_total, replay_presses, replay_packets);
+    if (replay_lost > 0) {
+        printf("%ld records missing from the log, the replay may not match\n", replay_lost);
+    }
+    if (why != 0) {
+        printf("stopped: %s\n", why);
+    }
+    printf("LCD: %.16s | %.16s\n", hal_host_lcd[0], hal_host_lcd[1]);
+    if (replay_diffs == 0) {
+        printf("motor outputs match at every reading\n");
+    } else {
+        printf("motor outputs differ at %ld readings, first at reading %ld\n",
+                replay_diffs, replay_first);
+    }
+    fflush(stdout);
+    exit(((why == 0) && (replay_diffs == 0)) ? 0 : 1);
+}
+
+/*=============================================================================
+ |  Function replay_advance
+ |
+ |  Purpose: replay_advance applies the records before the next IR reading
+ |           which are due: parameters at once, button presses, RFID
+ |           packets and duty scales once the recorded time since the last
+ |           reading has passed
+ |
+ |  Parameters:
+ |      now (unsigned char) - 1 to inject every event regardless of time, as
+ |                            the next reading is being taken
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void replay_advance(unsigned char now) {
+    struct ReplayRecord *r;
+    unsigned char packet[16];
+    unsigned int since;
+    unsigned char i;
+
+    while ((replay_next < replay_count) && ((replay_log[replay_next].type & 0xF0) != RPL_IR)) {
+        r = &replay_log[replay_next];
+        if ((r->type & 0xF0) == RPL_PARAM) {
+            replay_next = replay_params(replay_next);
+            continue;
+        }
+        if (((r->type & 0xF0) != RPL_BUTTON) && ((r->type & 0xF0) != RPL_RFID) &&
+                ((r->type & 0xF0) != RPL_SUPPLY)) {
+            replay_next++; // RPL_BOOT
+            continue;
+        }
+        since = r->time - replay_last_ms;
+        if (since > 0x8000) {
+            since = 0; // G_time_ms reset since the last reading
+        }
+        if ((now == 0) && ((hal_host_us - replay_last_us) / 1000 < since)) {
+            return; // Not yet
+        }
+        if ((r->type & 0xF0) == RPL_SUPPLY) {
+            bat_gain = r->value;
+            replay_next++;
+            continue;
+        }
+        if ((r->type & 0xF0) == RPL_BUTTON) {
+            hal_host_button(0);
+            hal_host_button(1);
+            replay_release_us = hal_host_us + REPLAY_PRESS_MS * 1000UL;
+            replay_presses++;
+            replay_next++;
+            continue;
+        }
+        // RFID packet, as stored by get_packet_serial(): the 0x02 dropped
+        // and the 0x03 replaced by 0, or 0 if it did not start with 0x02
+        memset(packet, 0, sizeof (packet));
+        for (; (replay_next < replay_count) &&
+                ((replay_log[replay_next].type & 0xF0) == RPL_RFID); replay_next++) {
+            i = (replay_log[replay_next].type & 0x07) * 2;
+            packet[i] = replay_log[replay_next].value >> 8;
+            packet[i + 1] = replay_log[replay_next].value;
+        }
+        if (packet[0] == 0) {
+            hal_host_uart_feed(0);
+        } else {
+            hal_host_uart_feed(0x02);
+            for (i = 0; (i < 16) && (packet[i] != 0); i++) {
+                hal_host_uart_feed(packet[i]);
+            }
+            hal_host_uart_feed(0x03);
+        }
+        replay_packets++;
+    }
+}
+
+/*=============================================================================
+ |  Function replay_capture
+ |
+ |  Purpose: replay_capture returns the next recorded IR reading and compares
+ |           the motor outputs with the record, for hal_host_capture_fn
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |
+ |  Returns:
+ |      Unsigned integer of the recorded capture
+ |
+ |  Comments: The replay stops if the firmware reads the other sensor than
+ |            recorded, as the two have then taken different paths, or
+ |            reads beyond the end of the log.
++============================================================================*/
+
+static unsigned int replay_capture(unsigned char sensor) {
+    struct ReplayRecord *r;
+    unsigned char duty[2];
+    unsigned char dir;
+    unsigned char ch;
+    char why[96];
+
+    replay_advance(1);
+    if (replay_next >= replay_count) {
+        replay_finish(0);
+    }
+    r = &replay_log[replay_next];
+    if ((r->type & 0x0F) != sensor) {
+        snprintf(why, sizeof (why), "reading %ld is of sensor %u, recorded of sensor %u",
+                replay_reads, sensor, r->type & 0x0F);
+        replay_finish(why);
+    }
+
+    for (ch = 0; ch < 2; ch++) {
+        duty[ch] = (*hal_pwm_duty_high(ch) << 6) | (*hal_pwm_duty_low(ch) >> 2);
+    }
+    dir = hal_motor_dir_get(0) | (hal_motor_dir_get(2) << 1);
+    if ((duty[0] != r->duty[0]) || (duty[1] != r->duty[1]) || (dir != r->dir)) {
+        if (replay_diffs < REPLAY_SHOW) {
+            printf("reading %ld (%u ms): duty %u,%u dir %u,%u recorded, duty %u,%u dir %u,%u replayed\n",
+                    replay_reads, r->time, r->duty[0], r->duty[1], r->dir & 1, r->dir >> 1,
+                    duty[0], duty[1], dir & 1, dir >> 1);
+        }
+        if (replay_diffs == 0) {
+            replay_first = replay_reads;
+        }
+        replay_diffs++;
+    }
+
+    replay_reads++;
+    replay_last_us = hal_host_us;
+    replay_last_ms = r->time;
+    replay_next++;
+    return r->value;
+}
+
+/*=============================================================================
+ |  Function replay_step
+ |
+ |  Purpose: replay_step injects events once due and ends the replay, for
+ |           hal_host_ms_fn
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void replay_step(void) {
+    if ((replay_release_us != 0) && (hal_host_us >= replay_release_us)) {
+        hal_host_button(0);
+        replay_release_us = 0;
+    }
+    replay_advance(0);
+    if ((replay_next >= replay_count) && (hal_host_us - replay_last_us > REPLAY_TAIL_MS * 1000UL)) {
+        replay_finish(0);
+    }
+    if (hal_host_us - replay_last_us > REPLAY_STALL_MS * 1000UL) {
+        replay_finish("no IR reading for 120 s");
+    }
+}
+
+/*=============================================================================
+ |  Function replay_discard
+ |
+ |  Purpose: replay_discard discards the sensor log of the replayed firmware,
+ |           for hal_host_uart_tx_fn
+ |
+ |  Parameters:
+ |      byte (unsigned char) - Byte sent
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void replay_discard(unsigned char byte) {
+    (void) byte;
+}
+
+/*=============================================================================
+ |  Function replay_lcd
+ |
+ |  Purpose: replay_lcd ends the replay once the checksum is displayed, with
+ |           every record replayed, for hal_host_lcd_fn
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void replay_lcd(void) {
+    if ((replay_next >= replay_count) && (memcmp(hal_host_lcd[0], "CHECKSUM ", 9) == 0) &&
+            ((hal_host_lcd[0][9] == 'V') | (hal_host_lcd[0][9] == 'I'))) {
+        replay_finish(0);
+    }
+}
+
+int main(int argc, char **argv) {
+    struct SimConfig cfg;
+    struct SimResult res;
+    const char *path = 0;
+    const char *record = 0;
+    long k;
+    int a;
+
+    sim_default(&cfg);
+    for (a = 1; a < argc; a++) {
+        if (strncmp(argv[a], "record=", 7) == 0) {
+            record = argv[a] + 7;
+        } else if (strchr(argv[a], '=') == 0) {
+            path = argv[a];
+        } else if (sim_set(&cfg, argv[a]) != 0) {
+            fprintf(stderr, "eod_replay: unknown option %s\n", argv[a]);
+            return 2;
+        }
+    }
+
+    if (record != 0) {
+        cfg.log = record;
+        if (sim_run(&cfg, &res) != 0) {
+            fprintf(stderr, "eod_replay: simulation failed\n");
+            return 2;
+        }
+        sim_print(&res);
+        printf("log written to %s\n", record);
+        return 0;
+    }
+    if (path == 0) {
+        fprintf(stderr, "usage: eod_replay log [name=value ...] | record=log [name=value ...]\n");
+        return 2;
+    }
+    if (replay_load(path) != 0) {
+        fprintf(stderr, "eod_replay: no sensor log records in %s\n", path);
+        return 2;
+    }
+    replay_cfg = &cfg;
+
+    // Parameters of the first press stored as they would be by the tuning
+    // protocol, for params_load() at power up
+    hal_init_clock(); // Simulated EEPROM erased
+    params_default();
+    for (k = 0; (k < replay_count) && ((replay_log[k].type & 0xF0) != RPL_PARAM); k++);
+    replay_params(k);
+    params_save();
+
+    hal_host_capture_fn = replay_capture;
+    hal_host_uart_tx_fn = replay_discard;
+    hal_host_ms_fn = replay_step;
+    hal_host_lcd_fn = replay_lcd;
+    fw_main();
+    replay_finish("firmware returned");
+    return 1;
+}
@@ -0,0 +1,953 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make sim")
+ |  Microchip: PIC18F4331 (simulated)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the vehicle simulator. The
+ |               firmware is run in a child process for every mission, as its
+ |               global variables can only be reset by starting afresh, and
+ |               the model is stepped once per simulated ms from the
+ |               hal_host_ms_fn hook of hal_host.c:
+ |               - Wheels: the signed power of each motor is decoded from the
+ |                 PWM duty and direction pin written by set_motor_pwm(), and
+ |                 each wheel follows it with a first order lag. Motor channel
+ |                 0 (motorL, RB0) drives the right wheel and channel 1
+ |                 (motorR, RB2) the left wheel.
+ |               - Battery: the speed of each power scales with the supply,
+ |                 which sags in proportion to the mean duty of both motors,
+ |                 and is sampled on AN2 through the divider of
+ |                 battery_funct.h.
+ |               - Beacon: at the start of each pulse, each tube sees the
+ |                 beacon with gain * strength * cos^n(angle off its axis) /
+ |                 d^2, when within its field of view. The pulse width
+ |                 received is then pulse_ms * 1000 * (1 - e^-signal) us plus
+ |                 noise, ending with the pulse, or none if the signal is too
+ |                 weak. The receiver output of each sensor is low while it
+ |                 receives any beacon, and each of its edges sets the
+ |                 capture flag, with the capture buffer holding TMR5 at the
+ |                 edge, or in the pulse width mode of BEACON_RAW builds the
+ |                 width, modulo 65536, at the rising edge. For the analog
+ |                 sensors of IR_ANALOG builds, each ADC sample is instead
+ |                 1023 * (1 - e^-signal) per beacon within its pulse, plus
+ |                 noise scaled alike, clipped to 0 - 1023. Sensor 0 (CAP2,
+ |                 IR3, AN0) is on the right and sensor 1 (CAP3, IR2, AN1)
+ |                 on the left.
+ |                 A stray beacon, as that of a neighbouring course, is
+ |                 modelled alike with its own timing, without occlusion or
+ |                 RFID card.
+ |               - RFID: the packet of the card is received once, when the
+ |                 reader at the front comes within rfid_radius of it.
+ |               The mission ends once the checksum is displayed, and the
+ |               results are sent to the parent through a pipe.
+ +===========================================================================*/
+#include "hal.h"
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "battery_funct.h"
+#include "sim.h"
+
+#define SIM_PI 3.14159265358979
+#define SIM_PERIOD 199 // PWM_PERIOD of both motors, see dc_motor_struct.h
+#define SIM_PRESS_MS 100 // Duration of the button press
+#define SIM_ADC_FULL 1023 // Sample of an infinite signal, 10 bit ADC
+
+void fw_main(void); // main() of main.c, renamed by the Makefile
+
+// Options of sim_set(), each a double of SimConfig
+struct SimOption {
+    const char *name;
+    size_t offset;
+};
+
+static const struct SimOption sim_options[] = {
+    {"beacon_dist", offsetof(struct SimConfig, beacon_dist)},
+    {"beacon_deg", offsetof(struct SimConfig, beacon_deg)},
+    {"strength", offsetof(struct SimConfig, strength)},
+    {"period_ms", offsetof(struct SimConfig, period_ms)},
+    {"pulse_ms", offsetof(struct SimConfig, pulse_ms)},
+    {"occl_from_ms", offsetof(struct SimConfig, occl_from_ms)},
+    {"occl_to_ms", offsetof(struct SimConfig, occl_to_ms)},
+    {"stray_dist", offsetof(struct SimConfig, stray_dist)},
+    {"stray_deg", offsetof(struct SimConfig, stray_deg)},
+    {"stray_strength", offsetof(struct SimConfig, stray_strength)},
+    {"stray_period_ms", offsetof(struct SimConfig, stray_period_ms)},
+    {"stray_pulse_ms", offsetof(struct SimConfig, stray_pulse_ms)},
+    {"stray_phase_ms", offsetof(struct SimConfig, stray_phase_ms)},
+    {"tube_deg", offsetof(struct SimConfig, tube_deg)},
+    {"half_deg", offsetof(struct SimConfig, half_deg)},
+    {"cos_n", offsetof(struct SimConfig, cos_n)},
+    {"gain_left", offsetof(struct SimConfig, gain_left)},
+    {"gain_right", offsetof(struct SimConfig, gain_right)},
+    {"noise", offsetof(struct SimConfig, noise)},
+    {"dropout", offsetof(struct SimConfig, dropout)},
+    {"detect", offsetof(struct SimConfig, detect)},
+    {"v_max", offsetof(struct SimConfig, v_max)},
+    {"tau_ms", offsetof(struct SimConfig, tau_ms)},
+    {"deadband", offsetof(struct SimConfig, deadband)},
+    {"wheelbase", offsetof(struct SimConfig, wheelbase)},
+    {"wheel_left", offsetof(struct SimConfig, wheel_left)},
+    {"wheel_right", offsetof(struct SimConfig, wheel_right)},
+    {"battery", offsetof(struct SimConfig, battery)},
+    {"sag", offsetof(struct SimConfig, sag)},
+    {"rfid_arm", offsetof(struct SimConfig, rfid_arm)},
+    {"rfid_radius", offsetof(struct SimConfig, rfid_radius)},
+    {"rot_rate0", offsetof(struct SimConfig, rot_rate0)},
+    {"rot_rate1", offsetof(struct SimConfig, rot_rate1)},
+    {"rot_rate2", offsetof(struct SimConfig, rot_rate2)},
+    {"start_ms", offsetof(struct SimConfig, start_ms)},
+    {"limit_ms", offsetof(struct SimConfig, limit_ms)},
+    {"seed", offsetof(struct SimConfig, seed)},
+    {"trace_ms", offsetof(struct SimConfig, trace_ms)},
+};
+
+#define SIM_OPTIONS (sizeof (sim_options) / sizeof (sim_options[0]))
+
+// State of the mission, child process only
+static const struct SimConfig *sim_cfg;
+static struct SimResult sim_res;
+static int sim_fd; // Write end of the pipe to the parent
+static FILE *sim_trace;
+static FILE *sim_log;
+static double sim_x, sim_y, sim_th; // Pose of the axle centre, m and rad
+static double sim_bx, sim_by; // Beacon and RFID card, m
+static double sim_sx, sim_sy; // Stray beacon, m
+static double sim_vl, sim_vr; // Wheel speeds, m/s
+static unsigned int sim_cap[2]; // Capture buffers
+static double sim_fall[2][2], sim_rise[2][2]; // Edges due per beacon (target,
+                                              // stray) and sensor, ms, or -1
+static unsigned char sim_low[2]; // Beacons received by each sensor
+static unsigned long sim_start[2]; // Falling edge of each sensor, us
+static unsigned long sim_width[2]; // Last pulse width of each sensor, us
+static double sim_amp[2][2]; // Analog amplitude per beacon and sensor
+static double sim_amp_end[2]; // End of the pulse of each beacon, ms
+static unsigned long long sim_rng;
+static char sim_counted[8]; // LCD line 2 of last veering action counted
+static unsigned char sim_menu_held; // Button held until the menu label shows
+
+/*=============================================================================
+ |  Function sim_default
+ |
+ |  Purpose: sim_default sets a configuration to the nominal vehicle, facing
+ |           the beacon 2 m away, with the compiled firmware parameters
+ |
+ |  Parameters:
+ |      *cfg (struct SimConfig) - Address of the configuration
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The beacon strength is such that the sensors read just over
+ |            the IR MIN parameter (47000) at 2 m facing the beacon.
++============================================================================*/
+
+void sim_default(struct SimConfig *cfg) {
+    unsigned char i;
+
+    memset(cfg, 0, sizeof (*cfg));
+    cfg->beacon_dist = 2.0;
+    cfg->beacon_deg = 0;
+    cfg->strength = 20;
+    cfg->period_ms = 250;
+    cfg->pulse_ms = 50;
+    cfg->occl_from_ms = 0;
+    cfg->occl_to_ms = 0;
+    cfg->stray_dist = 2.0;
+    cfg->stray_deg = 30;
+    cfg->stray_strength = 0; // None
+    cfg->stray_period_ms = 400;
+    cfg->stray_pulse_ms = 50;
+    cfg->stray_phase_ms = 120;
+    cfg->tube_deg = 10;
+    cfg->half_deg = 30;
+    cfg->cos_n = 8;
+    cfg->gain_left = 1;
+    cfg->gain_right = 1;
+    cfg->noise = 150;
+    cfg->dropout = 0.02;
+    cfg->detect = 0.05;
+    cfg->v_max = 0.3;
+    cfg->tau_ms = 150;
+    cfg->deadband = 0.15;
+    cfg->wheelbase = 0.22;
+    cfg->wheel_left = 1;
+    cfg->wheel_right = 1;
+    cfg->battery = 1;
+    cfg->sag = 0.1;
+    cfg->rfid_arm = 0.12;
+    cfg->rfid_radius = 0.12;
+    strcpy(cfg->tag, "0415AB7C33F5");
+    cfg->start_ms = 2000;
+    cfg->limit_ms = 300000;
+    cfg->seed = 1;
+    cfg->trace_ms = 0;
+    cfg->trace = 0;
+    for (i = 0; i < SIM_PARAMS; i++) {
+        cfg->par[i] = -1;
+    }
+}
+
+/*=============================================================================
+ |  Function sim_par_name
+ |
+ |  Purpose: sim_par_name gives the option name of a firmware parameter, its
+ |           par_info label in lower case with spaces as underscores
+ |
+ |  Parameters:
+ |      id (unsigned char) - Index of par_info
+ |      *name (char) - Buffer of at least 16 characters for the name
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void sim_par_name(unsigned char id, char *name) {
+    const unsigned char *label = par_info[id].label;
+    unsigned char i;
+
+    for (i = 0; (label[i] != 0) && (i < 15); i++) {
+        name[i] = (label[i] == ' ') ? '_' : (char) (label[i] | 0x20);
+    }
+    name[i] = 0;
+}
+
+/*=============================================================================
+ |  Function sim_set
+ |
+ |  Purpose: sim_set sets one value of a configuration from a "name=value"
+ |           argument, where the name is that of a SimConfig member, of a
+ |           firmware parameter (e.g. brg_thr, act_ms) or "tag", "trace",
+ |           "log" or "menu"
+ |
+ |  Parameters:
+ |      *cfg (struct SimConfig) - Address of the configuration
+ |      *arg (char) - Argument
+ |
+ |  Returns:
+ |      Integer of 0 if set, -1 if the name is not known
+ |
+ |  Comments: The trace and log file names and the menu label are not copied,
+ |            so arg must remain valid.
++============================================================================*/
+
+int sim_set(struct SimConfig *cfg, const char *arg) {
+    const char *value = strchr(arg, '=');
+    size_t n;
+    char name[16];
+    unsigned char i;
+
+    if (value == 0) {
+        return -1;
+    }
+    n = value - arg;
+    value++;
+    for (i = 0; i < SIM_OPTIONS; i++) {
+        if ((strlen(sim_options[i].name) == n) && (strncmp(arg, sim_options[i].name, n) == 0)) {
+            *(double *) ((char *) cfg + sim_options[i].offset) = atof(value);
+            return 0;
+        }
+    }
+    for (i = 0; i < SIM_PARAMS; i++) {
+        sim_par_name(i, name);
+        if ((strlen(name) == n) && (strncmp(arg, name, n) == 0)) {
+            cfg->par[i] = atol(value);
+            return 0;
+        }
+    }
+    if ((n == 3) && (strncmp(arg, "tag", 3) == 0)) {
+        strncpy(cfg->tag, value, 12);
+        cfg->tag[12] = 0;
+        return 0;
+    }
+    if ((n == 5) && (strncmp(arg, "trace", 5) == 0)) {
+        cfg->trace = value;
+        return 0;
+    }
+    if ((n == 3) && (strncmp(arg, "log", 3) == 0)) {
+        cfg->log = value;
+        return 0;
+    }
+    if ((n == 4) && (strncmp(arg, "menu", 4) == 0)) {
+        cfg->menu = value;
+        return 0;
+    }
+    return -1;
+}
+
+/*=============================================================================
+ |  Function sim_print_config
+ |
+ |  Purpose: sim_print_config prints every option of a configuration as
+ |           "name=value", one per line
+ |
+ |  Parameters:
+ |      *cfg (struct SimConfig) - Address of the configuration
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Firmware parameters left at the compiled default are shown as
+ |            -1.
++============================================================================*/
+
+void sim_print_config(const struct SimConfig *cfg) {
+    char name[16];
+    unsigned char i;
+
+    for (i = 0; i < SIM_OPTIONS; i++) {
+        printf("%s=%g\n", sim_options[i].name,
+                *(const double *) ((const char *) cfg + sim_options[i].offset));
+    }
+    for (i = 0; i < SIM_PARAMS; i++) {
+        sim_par_name(i, name);
+        printf("%s=%ld\n", name, cfg->par[i]);
+    }
+    printf("tag=%s\n", cfg->tag);
+    printf("trace=%s\n", (cfg->trace != 0) ? cfg->trace : "");
+    printf("log=%s\n", (cfg->log != 0) ? cfg->log : "");
+    printf("menu=%s\n", (cfg->menu != 0) ? cfg->menu : "");
+}
+
+/*=============================================================================
+ |  Function sim_random
+ |
+ |  Purpose: sim_random returns a uniformly distributed random number, from a
+ |           generator seeded by the configuration so that runs repeat
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      Double between 0 (inclusive) and 1 (exclusive)
++============================================================================*/
+
+static double sim_random(void) {
+    // xorshift64*
+    sim_rng ^= sim_rng >> 12;
+    sim_rng ^= sim_rng << 25;
+    sim_rng ^= sim_rng >> 27;
+    return ((sim_rng * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*=============================================================================
+ |  Function sim_gauss
+ |
+ |  Purpose: sim_gauss returns a normally distributed random number
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      Double with a mean of 0 and standard deviation of 1
++============================================================================*/
+
+static double sim_gauss(void) {
+    return sqrt(-2 * log(1 - sim_random())) * cos(2 * SIM_PI * sim_random());
+}
+
+/*=============================================================================
+ |  Function sim_finish
+ |
+ |  Purpose: sim_finish completes the results, sends them to the parent and
+ |           ends the child process
+ |
+ |  Parameters:
+ |      t (double) - Simulated ms since power up
+ |
+ |  Returns: Nothing (Does not return)
++============================================================================*/
+
+static void sim_finish(double t) {
+    const char *p = (const char *) &sim_res;
+    size_t left = sizeof (sim_res);
+    ssize_t n;
+
+    sim_res.t_end = t - sim_cfg->start_ms;
+    sim_res.return_err = hypot(sim_x, sim_y);
+    if (sim_trace != 0) {
+        fclose(sim_trace);
+    }
+    if (sim_log != 0) {
+        fclose(sim_log);
+    }
+    while (left > 0) {
+        n = write(sim_fd, p, left);
+        if (n <= 0) {
+            break;
+        }
+        p += n;
+        left -= n;
+    }
+    _exit(0);
+}
+
+/*=============================================================================
+ |  Function sim_duty
+ |
+ |  Purpose: sim_duty returns the duty written to a motor channel
+ |
+ |  Parameters:
+ |      channel (unsigned char) - Motor channel, 0 (RB0) or 1 (RB2)
+ |
+ |  Returns:
+ |      Double of the duty, -1 to 1, negative in reverse
+ |
+ |  Comments: With the direction pin high the duty is inverted, as done by
+ |            set_motor_pwm().
++============================================================================*/
+
+static double sim_duty(unsigned char channel) {
+    unsigned int duty = (hal_pwm_duty[channel][0] >> 2) | (hal_pwm_duty[channel][1] << 6);
+
+    if (hal_host_latb & (1 << (channel * 2))) {
+        return -(double) (SIM_PERIOD - (int) duty) / SIM_PERIOD; // Reverse
+    }
+    return (double) duty / SIM_PERIOD;
+}
+
+/*=============================================================================
+ |  Function sim_supply
+ |
+ |  Purpose: sim_supply returns the battery voltage under the load of both
+ |           motors
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      Double of the supply relative to BAT_NOMINAL_MV
+ |
+ |  Comments: The sag is taken as proportional to the mean duty of both
+ |            motors, as is their current.
++============================================================================*/
+
+static double sim_supply(void) {
+    double load = (fabs(sim_duty(0)) + fabs(sim_duty(1))) / 2;
+
+    return sim_cfg->battery * (1 - sim_cfg->sag * load);
+}
+
+/*=============================================================================
+ |  Function sim_wheel
+ |
+ |  Purpose: sim_wheel returns the steady wheel speed for the power written
+ |           to a motor channel
+ |
+ |  Parameters:
+ |      channel (unsigned char) - Motor channel, 0 (RB0) or 1 (RB2)
+ |      scale (double) - Speed of the wheel relative to nominal
+ |
+ |  Returns:
+ |      Double of the wheel speed in m/s, negative in reverse
+ |
+ |  Comments: The speed is that of the duty at BAT_NOMINAL_MV, scaled by the
+ |            supply (see sim_supply()).
++============================================================================*/
+
+static double sim_wheel(unsigned char channel, double scale) {
+    double power = sim_duty(channel);
+
+    if (fabs(power) <= sim_cfg->deadband) {
+        return 0;
+    }
+    power = (power > 0) ? power - sim_cfg->deadband : power + sim_cfg->deadband;
+    power /= 1 - sim_cfg->deadband;
+    return power * sim_cfg->v_max * sim_supply() * scale;
+}
+
+/*=============================================================================
+ |  Function sim_sense
+ |
+ |  Purpose: sim_sense plans the edges of each sensor at the start of a
+ |           beacon pulse
+ |
+ |  Parameters:
+ |      beacon (unsigned char) - 0 (target), 1 (stray)
+ |      t (double) - Simulated ms at the start of the pulse
+ |      bx (double) - Position of the beacon, m
+ |      by (double)
+ |      strength (double) - Signal at 1 m dead ahead of a tube
+ |      pulse_ms (double) - Pulse length, the widest capture
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void sim_sense(unsigned char beacon, double t, double bx, double by,
+        double strength, double pulse_ms) {
+    double d = hypot(bx - sim_x, by - sim_y);
+    double bearing = atan2(by - sim_y, bx - sim_x);
+    double half = sim_cfg->half_deg * SIM_PI / 180;
+    double angle, signal, width;
+    unsigned char sensor;
+
+    if (d < 0.1) {
+        d = 0.1;
+    }
+    sim_amp_end[beacon] = t + pulse_ms;
+    for (sensor = 0; sensor < 2; sensor++) {
+        sim_amp[beacon][sensor] = 0;
+        // Sensor 0 right of the centre line, sensor 1 left
+        angle = bearing - sim_th + ((sensor == 0) ? 1 : -1) * sim_cfg->tube_deg * SIM_PI / 180;
+        angle = atan2(sin(angle), cos(angle));
+        if (fabs(angle) >= half) {
+            continue; // Outside tube
+        }
+        signal = strength * pow(cos(angle), sim_cfg->cos_n) / (d * d);
+        signal *= (sensor == 0) ? sim_cfg->gain_right : sim_cfg->gain_left;
+        if ((signal < sim_cfg->detect) | (sim_random() < sim_cfg->dropout)) {
+            continue; // Missed, no edges
+        }
+        sim_amp[beacon][sensor] = SIM_ADC_FULL * (1 - exp(-signal));
+        width = pulse_ms * 1000 * (1 - exp(-signal)) + sim_cfg->noise * sim_gauss();
+        if (width < 1) {
+            width = 1;
+        }
+        sim_fall[beacon][sensor] = t + pulse_ms - width / 1000;
+        sim_rise[beacon][sensor] = t + pulse_ms;
+    }
+}
+
+/*=============================================================================
+ |  Function sim_edge
+ |
+ |  Purpose: sim_edge captures an edge of the receiver output of a sensor
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |      us (unsigned long) - Simulated time of the edge, us
+ |      level (unsigned char) - Output after the edge, 0 falling, 1 rising
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: An edge captured before the firmware took the previous one
+ |            overwrites it, as on the PIC.
++============================================================================*/
+
+static void sim_edge(unsigned char sensor, unsigned long us, unsigned char level) {
+    hal_host_cap_pin[sensor] = level;
+    if (level == 0) {
+        sim_start[sensor] = us;
+    } else {
+        sim_width[sensor] = us - sim_start[sensor];
+    }
+    if (hal_host_cap_mode == HAL_CAP_EDGES) {
+        sim_cap[sensor] = us & 0xFFFF;
+        hal_host_captured(sensor);
+    } else if ((hal_host_cap_mode == HAL_CAP_WIDTH) && (level == 1)) {
+        sim_cap[sensor] = sim_width[sensor] & 0xFFFF;
+        hal_host_captured(sensor);
+    }
+}
+
+/*=============================================================================
+ |  Function sim_edges
+ |
+ |  Purpose: sim_edges captures the edges of both sensors due by a time, in
+ |           order, with the output low while any beacon is received
+ |
+ |  Parameters:
+ |      t (double) - Simulated ms
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void sim_edges(double t) {
+    unsigned char sensor, beacon, b, rise;
+    double at;
+
+    for (sensor = 0; sensor < 2; sensor++) {
+        for (;;) {
+            at = t + 1; // Earliest edge due, falling edges first
+            b = 0;
+            rise = 0;
+            for (beacon = 0; beacon < 2; beacon++) {
+                if ((sim_fall[beacon][sensor] >= 0) && (sim_fall[beacon][sensor] < at)) {
+                    at = sim_fall[beacon][sensor];
+                    b = beacon;
+                    rise = 0;
+                }
+                if ((sim_fall[beacon][sensor] < 0) && (sim_rise[beacon][sensor] >= 0) &&
+                        (sim_rise[beacon][sensor] < at)) {
+                    at = sim_rise[beacon][sensor];
+                    b = beacon;
+                    rise = 1;
+                }
+            }
+            if (at > t) {
+                break;
+            }
+            if (rise == 0) {
+                sim_fall[b][sensor] = -1;
+                if (sim_low[sensor]++ == 0) {
+                    sim_edge(sensor, (unsigned long) (at * 1000), 0);
+                }
+            } else {
+                sim_rise[b][sensor] = -1;
+                if (--sim_low[sensor] == 0) {
+                    sim_edge(sensor, (unsigned long) (at * 1000), 1);
+                }
+            }
+        }
+    }
+}
+
+/*=============================================================================
+ |  Function sim_adc
+ |
+ |  Purpose: sim_adc samples the output of an analog sensor or the battery,
+ |           for hal_host_adc_fn
+ |
+ |  Parameters:
+ |      channel (unsigned char) - AN0 (IR3), AN1 (IR2), AN2 (battery)
+ |
+ |  Returns:
+ |      uint16_t of the sample, 0 - 1023
++============================================================================*/
+
+static uint16_t sim_adc(unsigned char channel) {
+    double t = hal_host_us / 1000.0;
+    double level;
+    unsigned char beacon;
+
+    if (channel == 2) {
+        level = sim_supply() * BAT_COUNTS(BAT_NOMINAL_MV);
+        return (level > SIM_ADC_FULL) ? SIM_ADC_FULL : (uint16_t) (level + 0.5);
+    }
+    if (channel > 2) {
+        return 0;
+    }
+    level = SIM_ADC_FULL * sim_cfg->noise / (sim_cfg->pulse_ms * 1000) * sim_gauss();
+
+    for (beacon = 0; beacon < 2; beacon++) {
+        if (t < sim_amp_end[beacon]) {
+            level += sim_amp[beacon][channel & 1];
+        }
+    }
+    if (level < 0) {
+        return 0;
+    }
+    return (level > SIM_ADC_FULL) ? SIM_ADC_FULL : (uint16_t) (level + 0.5);
+}
+
+/*=============================================================================
+ |  Function sim_capture
+ |
+ |  Purpose: sim_capture returns a capture buffer, for hal_host_capture_fn
+ |
+ |  Parameters:
+ |      sensor (unsigned char) - 0 (IR3), 1 (IR2)
+ |
+ |  Returns:
+ |      Unsigned integer of the last capture
++============================================================================*/
+
+static unsigned int sim_capture(unsigned char sensor) {
+    return sim_cap[sensor & 1];
+}
+
+/*=============================================================================
+ |  Function sim_uart_tx
+ |
+ |  Purpose: sim_uart_tx writes bytes sent over serial to the log file, if
+ |           any, for hal_host_uart_tx_fn
+ |
+ |  Parameters:
+ |      byte (unsigned char) - Byte sent
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void sim_uart_tx(unsigned char byte) {
+    if (sim_log != 0) {
+        fputc(byte, sim_log);
+    }
+}
+
+/*=============================================================================
+ |  Function sim_lcd
+ |
+ |  Purpose: sim_lcd follows the progress of the firmware on the LCD, as a
+ |           person watching the vehicle would, for hal_host_lcd_fn
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: "CTR" on line 2 when orientate() has centred, ":VL" or ":VR"
+ |            after the action number on line 2 for each veering action of
+ |            steer(), and the checksum on line 1 at the end of the mission.
+ |            Called on every character, as the checksum is only displayed
+ |            for a moment when invalid.
++============================================================================*/
+
+static void sim_lcd(void) {
+    double t = hal_host_us / 1000.0;
+    size_t n;
+
+    if (sim_menu_held) {
+        n = strlen(sim_cfg->menu);
+        if ((memcmp(hal_host_lcd[0], sim_cfg->menu, n) == 0) && (hal_host_lcd[0][n] == ' ')) {
+            sim_menu_held = 0;
+            hal_host_button(0); // Selects the mode shown
+        }
+    }
+    if ((sim_res.t_centre < 0) && (memcmp(hal_host_lcd[1], "CTR", 3) == 0)) {
+        sim_res.t_centre = t - sim_cfg->start_ms;
+    }
+    if ((memcmp(hal_host_lcd[1], "1b|", 3) == 0) && (memcmp(hal_host_lcd[1] + 8, ":V", 2) == 0) &&
+            (memcmp(hal_host_lcd[1], sim_counted, 8) != 0)) {
+        memcpy(sim_counted, hal_host_lcd[1], 8); // "1b|" and action number
+        sim_res.corrections++;
+    }
+    if ((memcmp(hal_host_lcd[0], "CHECKSUM ", 9) == 0) &&
+            ((hal_host_lcd[0][9] == 'V') | (hal_host_lcd[0][9] == 'I'))) {
+        sim_res.finished = 1;
+        sim_res.valid = hal_host_lcd[0][9] == 'V';
+        sim_finish(t);
+    }
+}
+
+/*=============================================================================
+ |  Function sim_step
+ |
+ |  Purpose: sim_step advances the model by 1 ms, for hal_host_ms_fn
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void sim_step(void) {
+    double t = hal_host_us / 1000.0;
+    double k = 1 / sim_cfg->tau_ms;
+    double v, fx, fy, d;
+    unsigned char i;
+    long phase;
+
+    // Button
+    if (t == sim_cfg->start_ms) {
+        hal_host_button(1);
+    } else if (t == sim_cfg->start_ms + SIM_PRESS_MS) {
+        hal_host_button(0);
+    }
+
+    // Wheels, channel 0 right and channel 1 left
+    sim_vr += (sim_wheel(0, sim_cfg->wheel_right) - sim_vr) * k;
+    sim_vl += (sim_wheel(1, sim_cfg->wheel_left) - sim_vl) * k;
+    v = (sim_vl + sim_vr) / 2;
+    sim_x += v * cos(sim_th) * 0.001;
+    sim_y += v * sin(sim_th) * 0.001;
+    sim_th += (sim_vr - sim_vl) / sim_cfg->wheelbase * 0.001;
+    sim_res.path += fabs(v) * 0.001;
+
+    // Beacon, seen at the start of each pulse unless occluded
+    phase = (long) t % (long) sim_cfg->period_ms;
+    if ((phase == 0) && !((t >= sim_cfg->occl_from_ms) && (t < sim_cfg->occl_to_ms))) {
+        sim_sense(0, t, sim_bx, sim_by, sim_cfg->strength, sim_cfg->pulse_ms);
+    }
+    if ((sim_cfg->stray_strength > 0) && (t >= sim_cfg->stray_phase_ms)) {
+        phase = (long) (t - sim_cfg->stray_phase_ms) % (long) sim_cfg->stray_period_ms;
+        if (phase == 0) {
+            sim_sense(1, t, sim_sx, sim_sy, sim_cfg->stray_strength, sim_cfg->stray_pulse_ms);
+        }
+    }
+    sim_edges(t);
+
+    // RFID card, read once
+    fx = sim_x + sim_cfg->rfid_arm * cos(sim_th);
+    fy = sim_y + sim_cfg->rfid_arm * sin(sim_th);
+    d = hypot(sim_bx - fx, sim_by - fy);
+    if ((sim_res.miss < 0) || (d < sim_res.miss)) {
+        sim_res.miss = d;
+    }
+    if ((sim_res.tagged == 0) && (d < sim_cfg->rfid_radius) && (t > sim_cfg->start_ms)) {
+        sim_res.tagged = 1;
+        sim_res.t_tag = t - sim_cfg->start_ms;
+        hal_host_uart_feed(0x02);
+        for (i = 0; sim_cfg->tag[i] != 0; i++) {
+            hal_host_uart_feed(sim_cfg->tag[i]);
+        }
+        hal_host_uart_feed('\r');
+        hal_host_uart_feed('\n');
+        hal_host_uart_feed(0x03);
+    }
+
+    if ((sim_trace != 0) && ((long) t % (long) sim_cfg->trace_ms == 0)) {
+        fprintf(sim_trace, "%.0f,%.4f,%.4f,%.2f,%.4f,%.4f,%u,%u,%.16s,%.16s\n",
+                t, sim_x, sim_y, sim_th * 180 / SIM_PI, sim_vl, sim_vr,
+                (unsigned int) sim_width[1], (unsigned int) sim_width[0], hal_host_lcd[0], hal_host_lcd[1]);
+    }
+    if (t >= sim_cfg->limit_ms) {
+        sim_finish(t);
+    }
+}
+
+/*=============================================================================
+ |  Function sim_child
+ |
+ |  Purpose: sim_child runs one mission in the child process
+ |
+ |  Parameters:
+ |      *cfg (struct SimConfig) - Address of the configuration
+ |      fd (int) - Write end of the pipe to the parent
+ |
+ |  Returns: Nothing (Does not return)
+ |
+ |  Comments: The firmware parameters are saved to the simulated data EEPROM
+ |            before power up, as they would be by the tuning protocol, and
+ |            loaded from it by params_load().
++============================================================================*/
+
+static void sim_child(const struct SimConfig *cfg, int fd) {
+    unsigned char i;
+
+    sim_cfg = cfg;
+    sim_fd = fd;
+    memset(&sim_res, 0, sizeof (sim_res));
+    sim_res.t_centre = -1;
+    sim_res.t_tag = -1;
+    sim_res.miss = -1;
+    sim_x = 0;
+    sim_y = 0;
+    sim_th = 0;
+    sim_bx = cfg->beacon_dist * cos(cfg->beacon_deg * SIM_PI / 180);
+    sim_by = cfg->beacon_dist * sin(cfg->beacon_deg * SIM_PI / 180);
+    sim_sx = cfg->stray_dist * cos(cfg->stray_deg * SIM_PI / 180);
+    sim_sy = cfg->stray_dist * sin(cfg->stray_deg * SIM_PI / 180);
+    sim_rng = 0x9E3779B97F4A7C15ULL ^ (unsigned long long) cfg->seed;
+    memset(sim_counted, 0, sizeof (sim_counted));
+    for (i = 0; i < 4; i++) {
+        sim_fall[i >> 1][i & 1] = -1;
+        sim_rise[i >> 1][i & 1] = -1;
+    }
+    memset(sim_low, 0, sizeof (sim_low));
+    memset(sim_amp_end, 0, sizeof (sim_amp_end));
+    sim_trace = 0;
+    if ((cfg->trace != 0) && (cfg->trace_ms > 0)) {
+        sim_trace = fopen(cfg->trace, "w");
+        if (sim_trace != 0) {
+            fprintf(sim_trace, "t_ms,x,y,heading,v_left,v_right,ir_left,ir_right,lcd1,lcd2\n");
+        }
+    }
+    sim_log = 0;
+    if (cfg->log != 0) {
+        sim_log = fopen(cfg->log, "wb");
+    }
+
+    sim_menu_held = cfg->menu != 0;
+    if (sim_menu_held) {
+        hal_host_button(1); // Held from power up to open the menu
+    }
+    hal_init_clock(); // Simulated EEPROM erased
+    params_default();
+    for (i = 0; i < SIM_PARAMS; i++) {
+        if (cfg->par[i] >= 0) {
+            param_set(i, cfg->par[i]);
+        }
+    }
+    G_params.rot.rate[0] = (uint16_t) cfg->rot_rate0;
+    G_params.rot.rate[1] = (uint16_t) cfg->rot_rate1;
+    G_params.rot.rate[2] = (uint16_t) cfg->rot_rate2;
+    params_save();
+
+    hal_host_capture_fn = sim_capture;
+    hal_host_adc_fn = sim_adc;
+    hal_host_uart_tx_fn = sim_uart_tx;
+    hal_host_ms_fn = sim_step;
+    hal_host_lcd_fn = sim_lcd;
+    fw_main();
+    sim_finish(hal_host_us / 1000.0);
+}
+
+/*=============================================================================
+ |  Function sim_run
+ |
+ |  Purpose: sim_run simulates one mission, from power up until the checksum
+ |           is displayed or limit_ms is reached
+ |
+ |  Parameters:
+ |      *cfg (struct SimConfig) - Address of the configuration
+ |      *res (struct SimResult) - Address of the results to be written
+ |
+ |  Returns:
+ |      Integer of 0 if the mission was simulated, -1 if the child process
+ |      failed
+ |
+ |  Comments: Several missions may be simulated at once by calling sim_run()
+ |            from several processes.
++============================================================================*/
+
+int sim_run(const struct SimConfig *cfg, struct SimResult *res) {
+    char *p = (char *) res;
+    size_t left = sizeof (*res);
+    ssize_t n;
+    int fd[2];
+    int status;
+    pid_t pid;
+
+    if (pipe(fd) != 0) {
+        return -1;
+    }
+    fflush(stdout); // Not to be printed again by the child
+    pid = fork();
+    if (pid < 0) {
+        close(fd[0]);
+        close(fd[1]);
+        return -1;
+    }
+    if (pid == 0) {
+        close(fd[0]);
+        sim_child(cfg, fd[1]);
+    }
+    close(fd[1]);
+    while (left > 0) {
+        n = read(fd[0], p, left);
+        if (n <= 0) {
+            break;
+        }
+        p += n;
+        left -= n;
+    }
+    close(fd[0]);
+    waitpid(pid, &status, 0);
+    return (left == 0) ? 0 : -1;
+}
+
+/*=============================================================================
+ |  Function sim_print
+ |
+ |  Purpose: sim_print prints the results of a mission on one line, as
+ |           "name=value" pairs
+ |
+ |  Parameters:
+ |      *res (struct SimResult) - Address of the results
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void sim_print(const struct SimResult *res) {
+    printf("tagged=%d finished=%d valid=%d t_centre=%.0f t_tag=%.0f t_end=%.0f "
+            "path=%.3f corrections=%d return_err=%.3f miss=%.3f\n",
+            res->tagged, res->finished, res->valid, res->t_centre, res->t_tag,
+            res->t_end, res->path, res->corrections, res->return_err, res->miss);
+}
@@ -0,0 +1,128 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make sim")
+ |  Microchip: PIC18F4331 (simulated)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the header file for the vehicle simulator, which runs
+ |               the unmodified firmware (main.c renamed to fw_main()) on the
+ |               host implementation of the hardware abstraction layer, and
+ |               closes the loop with a model of the two wheel drive, the IR
+ |               beacon, the two IR sensor tubes and the RFID card. Detailed
+ |               function descriptions can be found in the sim.c file.
+ +===========================================================================*/
+
+#ifndef SIM_H
+#define	SIM_H
+
+#define SIM_PARAMS 8 // Firmware parameters which can be set, see par_info
+
+/*=============================================================================
+ |  Structure SimConfig
+ |
+ |  Purpose: Describes the vehicle, the course and the firmware parameters of
+ |           one simulated mission
+ |
+ |  Parameters:
+ |      Course: beacon_dist (m) and beacon_deg (degrees, positive to the left)
+ |              of the beacon from the start, with the vehicle facing 0 deg
+ |      Beacon: strength (signal at 1 m dead ahead of a tube), period_ms,
+ |              pulse_ms, and occlusion between occl_from_ms and occl_to_ms
+ |      Stray beacon: stray_dist and stray_deg from the start, as the
+ |                    beacon, stray_strength (0 for none), stray_period_ms,
+ |                    stray_pulse_ms, and stray_phase_ms (time of its first
+ |                    pulse)
+ |      Sensors: tube_deg (axis of each tube from the centre line),
+ |               half_deg (field of view of each tube), cos_n (fall off
+ |               within it), gain_left and gain_right, noise (standard
+ |               deviation of each capture), dropout (probability of a pulse
+ |               being missed), detect (weakest signal captured)
+ |      Drive: v_max (m/s at full power), tau_ms (wheel speed lag), deadband
+ |             (fraction of power which does not move a wheel), wheelbase
+ |             (m), wheel_left and wheel_right (speed of each wheel relative
+ |             to nominal), battery (supply at rest relative to
+ |             BAT_NOMINAL_MV), sag (fraction of it lost at full duty on
+ |             both motors)
+ |      RFID: rfid_arm (m ahead of the axle), rfid_radius (m from the card,
+ |            held at the beacon, within which it is read), tag (10 data
+ |            and 2 checksum characters)
+ |      EEPROM: rot_rate0 to rot_rate2 (turn rates in degrees per second at
+ |              each power of rot_power, as left by an earlier CAL ROT, 0
+ |              for uncalibrated)
+ |      Run: start_ms (button press), limit_ms, seed, trace_ms (CSV trace
+ |           period, 0 for none), trace (file), log (file of the bytes
+ |           sent over serial, such as the sensor log of a REPLAY_LOG
+ |           build, see replay_funct.h) and menu (mode label, such as
+ |           "CAL IR", selected with the button held from power up, see
+ |           select_mode())
+ |      par[SIM_PARAMS] (long) - Firmware parameters, by index of par_info,
+ |                               or -1 to keep the compiled default
++============================================================================*/
+
+struct SimConfig {
+    double beacon_dist, beacon_deg;
+    double strength, period_ms, pulse_ms, occl_from_ms, occl_to_ms;
+    double stray_dist, stray_deg, stray_strength, stray_period_ms, stray_pulse_ms,
+            stray_phase_ms;
+    double tube_deg, half_deg, cos_n, gain_left, gain_right;
+    double noise, dropout, detect;
+    double v_max, tau_ms, deadband, wheelbase, wheel_left, wheel_right, battery, sag;
+    double rfid_arm, rfid_radius;
+    char tag[13];
+    double rot_rate0, rot_rate1, rot_rate2;
+    double start_ms, limit_ms, seed, trace_ms;
+    const char *trace;
+    const char *log;
+    const char *menu;
+    long par[SIM_PARAMS];
+};
+
+/*=============================================================================
+ |  Structure SimResult
+ |
+ |  Purpose: Key performance indicators of one simulated mission
+ |
+ |  Parameters:
+ |      tagged (int) - 1 if the RFID card was read
+ |      finished (int) - 1 if the checksum was displayed before limit_ms
+ |      valid (int) - 1 if the checksum was displayed as valid
+ |      t_centre (double) - ms from the button press to the first centring
+ |                          by orientate(), -1 if never
+ |      t_tag (double) - ms from the button press to the RFID card, -1 if
+ |                       never
+ |      t_end (double) - ms from the button press to the checksum display,
+ |                       or to limit_ms
+ |      path (double) - Distance travelled by the axle centre in m
+ |      corrections (int) - Number of veering actions taken by steer()
+ |      return_err (double) - Distance of the final position from the start
+ |                            in m
+ |      miss (double) - Closest approach of the RFID reader to the card in m
++============================================================================*/
+
+struct SimResult {
+    int tagged, finished, valid;
+    double t_centre, t_tag, t_end;
+    double path;
+    int corrections;
+    double return_err, miss;
+};
+
+void sim_default(struct SimConfig *cfg);
+int sim_set(struct SimConfig *cfg, const char *arg);
+void sim_print_config(const struct SimConfig *cfg);
+int sim_run(const struct SimConfig *cfg, struct SimResult *res);
+void sim_print(const struct SimResult *res);
+
+#endif
@@ -0,0 +1,53 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make sim")
+ |  Microchip: PIC18F4331 (simulated)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the main file of eod_sim, which simulates one mission
+ |               and prints its results. Every argument is a "name=value"
+ |               option of sim_set(), for example
+ |                   eod_sim beacon_deg=60 gain_left=0.8 act_ms=300
+ |                           trace=run.csv trace_ms=50
+ |               Run with -h to list the options and their defaults. The exit
+ |               status is 0 if the card was read and the checksum displayed.
+ +===========================================================================*/
+#include <stdio.h>
+#include <string.h>
+#include "sim.h"
+
+int main(int argc, char **argv) {
+    struct SimConfig cfg;
+    struct SimResult res;
+    int i;
+
+    sim_default(&cfg);
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-h") == 0) {
+            sim_print_config(&cfg);
+            return 0;
+        }
+        if (sim_set(&cfg, argv[i]) != 0) {
+            fprintf(stderr, "eod_sim: unknown option %s (-h to list)\n", argv[i]);
+            return 2;
+        }
+    }
+    if (sim_run(&cfg, &res) != 0) {
+        fprintf(stderr, "eod_sim: simulation failed\n");
+        return 2;
+    }
+    sim_print(&res);
+    return (res.tagged & res.finished) ? 0 : 1;
+}
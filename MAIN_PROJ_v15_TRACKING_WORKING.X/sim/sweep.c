@@ -0,0 +1,551 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: gcc or clang (host build, see "make sweep")
+ |  Microchip: PIC18F4331 (simulated)
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the main file of eod_sweep, which simulates every
+ |               parameter set of a grid or random sample over the same
+ |               randomly placed beacons, ranks the sets by success rate,
+ |               time to tag and return error, and optionally writes the best
+ |               set as a header of compiled defaults (see PAR_TUNED in
+ |               eeprom_funct.h). For example
+ |                   eod_sweep gain=20:60:10 brg_thr=15,25,35
+ |                             act_ms=200~600 samples=8 runs=20
+ |                             header=params_tuned.h
+ |               Arguments are "name=value" options of sim_set(), which apply
+ |               to every run, or which are swept when the value is a grid
+ |               (first:last:step), a list (a,b,c) or a random range (a~b,
+ |               drawn "samples" times), along with:
+ |               runs - Beacon placements per parameter set (default 10)
+ |               spread_deg - Placements within +/- this bearing (default 60)
+ |               dist_min, dist_max - Range of placements (default 1.5, 2.5)
+ |               jobs - Simultaneous runs (default number of cores)
+ |               top - Parameter sets printed (default 10)
+ |               header - File to write the best parameter set to
+ |               csv - File to write the result of every run to
+ |               Each run is a process of its own (see sim_run()), so the
+ |               runs are shared between "jobs" worker processes rather than
+ |               threads.
+ +===========================================================================*/
+#include "hal.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "sim.h"
+
+#define SWEEP_DIMS 16 // Options which can be swept at once
+
+// Macros of the compiled defaults in eeprom_funct.h, by index of par_info
+static const char *const sweep_macros[SIM_PARAMS] = {
+    "PAR_GAIN", "PAR_BEARING_THR", "PAR_IR_MIN", "PAR_CRUISE_POWER",
+    "PAR_TURN_POWER", "PAR_VEER_DROP", "PAR_ACTION_MS", "PAR_RUN_S"
+};
+
+// Compile error if par_info has changed without sweep_macros
+typedef char sweep_macros_match[(SIM_PARAMS == PAR_COUNT) ? 1 : -1];
+
+// Swept option
+struct SweepDim {
+    char name[32];
+    int random; // 1 for a random range, 0 for a grid or list
+    int whole; // 1 for a firmware parameter, drawn as whole numbers
+    double lo, hi; // Random range
+    double values[64]; // Grid or list
+    int count;
+};
+
+// Result of one run, sent by a worker to the parent
+struct SweepMsg {
+    int set, run, ok;
+    struct SimResult res;
+};
+
+// Totals of one parameter set
+struct SweepSet {
+    int index;
+    int runs, tagged;
+    double t_tag, return_err; // Sums over the successful runs
+};
+
+static struct SweepDim dims[SWEEP_DIMS];
+static int n_dims = 0;
+static double *set_values; // n_sets x n_dims
+static int n_sets = 0;
+
+/*=============================================================================
+ |  Function sweep_random
+ |
+ |  Purpose: sweep_random returns a uniformly distributed random number from
+ |           the generator of the sweep, so that sweeps repeat
+ |
+ |  Parameters:
+ |      *state (unsigned long long) - Address of the generator state
+ |
+ |  Returns:
+ |      Double between 0 (inclusive) and 1 (exclusive)
++============================================================================*/
+
+static double sweep_random(unsigned long long *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return ((*state * 2685821657736338717ULL) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*=============================================================================
+ |  Function sweep_dim
+ |
+ |  Purpose: sweep_dim adds a swept option, if the value of an argument is a
+ |           grid, list or random range
+ |
+ |  Parameters:
+ |      *arg (char) - Argument, "name=value"
+ |
+ |  Returns:
+ |      Integer of 1 if added, 0 if the argument is not swept, -1 if invalid
++============================================================================*/
+
+static int sweep_dim(const char *arg) {
+    const char *value = strchr(arg, '=');
+    struct SweepDim *dim = &dims[n_dims];
+    double first, last, step, x;
+    char *end;
+
+    if ((value == 0) || (strpbrk(value, ":,~") == 0)) {
+        return 0;
+    }
+    if ((n_dims == SWEEP_DIMS) || (value - arg >= (long) sizeof (dim->name))) {
+        return -1;
+    }
+    memset(dim, 0, sizeof (*dim));
+    memcpy(dim->name, arg, value - arg);
+    value++;
+    if (strchr(value, '~') != 0) {
+        dim->random = 1;
+        dim->lo = strtod(value, &end);
+        dim->hi = strtod(end + 1, 0);
+    } else if (strchr(value, ':') != 0) {
+        first = strtod(value, &end);
+        last = strtod(end + 1, &end);
+        step = (*end == ':') ? strtod(end + 1, 0) : 1;
+        if (step <= 0) {
+            return -1;
+        }
+        for (x = first; (x <= last + step * 1e-9) && (dim->count < 64); x += step) {
+            dim->values[dim->count++] = x;
+        }
+    } else {
+        while ((*value != 0) && (dim->count < 64)) {
+            dim->values[dim->count++] = strtod(value, &end);
+            value = (*end == ',') ? end + 1 : end;
+            if (end == value) {
+                break;
+            }
+        }
+    }
+    n_dims++;
+    return 1;
+}
+
+/*=============================================================================
+ |  Function sweep_check
+ |
+ |  Purpose: sweep_check checks that a swept option is known to sim_set(),
+ |           and notes whether it is a firmware parameter
+ |
+ |  Parameters:
+ |      *base (struct SimConfig) - Configuration common to every run
+ |      *dim (struct SweepDim) - Swept option
+ |
+ |  Returns:
+ |      Integer of 0 if known, -1 if not
++============================================================================*/
+
+static int sweep_check(const struct SimConfig *base, struct SweepDim *dim) {
+    struct SimConfig cfg = *base;
+    char arg[48];
+    unsigned char i;
+
+    snprintf(arg, sizeof (arg), "%s=12345", dim->name);
+    if (sim_set(&cfg, arg) != 0) {
+        return -1;
+    }
+    for (i = 0; i < SIM_PARAMS; i++) {
+        if (cfg.par[i] == 12345) {
+            dim->whole = 1;
+        }
+    }
+    return 0;
+}
+
+/*=============================================================================
+ |  Function sweep_apply
+ |
+ |  Purpose: sweep_apply sets the swept options of a parameter set in a
+ |           configuration
+ |
+ |  Parameters:
+ |      *cfg (struct SimConfig) - Address of the configuration
+ |      set (int) - Index of the parameter set
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void sweep_apply(struct SimConfig *cfg, int set) {
+    char arg[64];
+    int d;
+
+    for (d = 0; d < n_dims; d++) {
+        snprintf(arg, sizeof (arg), "%.31s=%.10g", dims[d].name, set_values[set * n_dims + d]);
+        sim_set(cfg, arg);
+    }
+}
+
+/*=============================================================================
+ |  Function sweep_label
+ |
+ |  Purpose: sweep_label writes the swept options of a parameter set as
+ |           "name=value" pairs
+ |
+ |  Parameters:
+ |      *out (FILE) - Stream to write to
+ |      set (int) - Index of the parameter set
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+static void sweep_label(FILE *out, int set) {
+    int d;
+
+    for (d = 0; d < n_dims; d++) {
+        fprintf(out, "%s%s=%g", (d > 0) ? " " : "", dims[d].name, set_values[set * n_dims + d]);
+    }
+}
+
+/*=============================================================================
+ |  Function sweep_compare
+ |
+ |  Purpose: sweep_compare orders parameter sets for qsort(), best first: by
+ |           success rate, then mean time to tag, then mean return error
+ |
+ |  Parameters:
+ |      *a, *b (void) - Addresses of the two SweepSet structures
+ |
+ |  Returns:
+ |      Integer, negative if a is better than b
++============================================================================*/
+
+static int sweep_compare(const void *a, const void *b) {
+    const struct SweepSet *x = a;
+    const struct SweepSet *y = b;
+    double rx = (x->runs > 0) ? (double) x->tagged / x->runs : 0;
+    double ry = (y->runs > 0) ? (double) y->tagged / y->runs : 0;
+    double tx = (x->tagged > 0) ? x->t_tag / x->tagged : 1e30;
+    double ty = (y->tagged > 0) ? y->t_tag / y->tagged : 1e30;
+    double ex = (x->tagged > 0) ? x->return_err / x->tagged : 1e30;
+    double ey = (y->tagged > 0) ? y->return_err / y->tagged : 1e30;
+
+    if (rx != ry) {
+        return (rx > ry) ? -1 : 1;
+    }
+    if (tx != ty) {
+        return (tx < ty) ? -1 : 1;
+    }
+    if (ex != ey) {
+        return (ex < ey) ? -1 : 1;
+    }
+    return x->index - y->index;
+}
+
+/*=============================================================================
+ |  Function sweep_header
+ |
+ |  Purpose: sweep_header writes a parameter set as a header of compiled
+ |           defaults, to be included by eeprom_funct.h when PAR_TUNED is
+ |           defined
+ |
+ |  Parameters:
+ |      *path (char) - File to write
+ |      *base (struct SimConfig) - Configuration common to every run
+ |      *best (struct SweepSet) - Totals of the parameter set
+ |
+ |  Returns:
+ |      Integer of 0 if written, -1 if the file could not be opened
+ |
+ |  Comments: Every parameter is written, limited as param_set() would, with
+ |            those not swept at the value of the runs.
++============================================================================*/
+
+static int sweep_header(const char *path, const struct SimConfig *base, const struct SweepSet *best) {
+    struct SimConfig cfg = *base;
+    FILE *out = fopen(path, "wb");
+    unsigned char i;
+
+    if (out == 0) {
+        return -1;
+    }
+    sweep_apply(&cfg, best->index);
+    params_default();
+    for (i = 0; i < SIM_PARAMS; i++) {
+        if (cfg.par[i] >= 0) {
+            param_set(i, cfg.par[i]);
+        }
+    }
+    fprintf(out, "/* Compiled defaults from a tuning campaign, written by eod_sweep (see\r\n");
+    fprintf(out, " * sim/sweep.c). Included by eeprom_funct.h when PAR_TUNED is defined.\r\n");
+    fprintf(out, " * Sweep: ");
+    sweep_label(out, best->index);
+    fprintf(out, "\r\n * Success %d of %d runs, mean time to tag %.1f s, mean return error\r\n",
+            best->tagged, best->runs,
+            (best->tagged > 0) ? best->t_tag / best->tagged / 1000 : 0);
+    fprintf(out, " * %.3f m. Values stored in the data EEPROM take precedence. */\r\n\r\n",
+            (best->tagged > 0) ? best->return_err / best->tagged : 0);
+    fprintf(out, "#ifndef PARAMS_TUNED_H\r\n#define\tPARAMS_TUNED_H\r\n\r\n");
+    for (i = 0; i < SIM_PARAMS; i++) {
+        fprintf(out, "#define %s %u\r\n", sweep_macros[i], param_get(i));
+    }
+    fprintf(out, "\r\n#endif\r\n");
+    fclose(out);
+    return 0;
+}
+
+/*=============================================================================
+ |  Function sweep_worker
+ |
+ |  Purpose: sweep_worker simulates every "jobs"th run, starting from its
+ |           own number, and sends the results to the parent
+ |
+ |  Parameters:
+ |      *base (struct SimConfig) - Configuration common to every run
+ |      *place (double) - Beacon distance, bearing and seed of each run
+ |      runs (int) - Runs per parameter set
+ |      worker, jobs (int) - Number of this worker, and number of workers
+ |      fd (int) - Write end of the pipe to the parent
+ |
+ |  Returns: Nothing (Does not return)
+ |
+ |  Comments: Each message is shorter than PIPE_BUF, so messages from
+ |            several workers are not interleaved.
++============================================================================*/
+
+static void sweep_worker(const struct SimConfig *base, const double *place, int runs,
+        int worker, int jobs, int fd) {
+    struct SimConfig cfg;
+    struct SweepMsg msg;
+    int job;
+
+    for (job = worker; job < n_sets * runs; job += jobs) {
+        cfg = *base;
+        msg.set = job / runs;
+        msg.run = job % runs;
+        sweep_apply(&cfg, msg.set);
+        cfg.beacon_dist = place[msg.run * 3];
+        cfg.beacon_deg = place[msg.run * 3 + 1];
+        cfg.seed = place[msg.run * 3 + 2];
+        cfg.trace = 0;
+        msg.ok = sim_run(&cfg, &msg.res) == 0;
+        if (write(fd, &msg, sizeof (msg)) != sizeof (msg)) {
+            break;
+        }
+    }
+    _exit(0);
+}
+
+int main(int argc, char **argv) {
+    struct SimConfig base;
+    struct SweepSet *sets;
+    struct SweepMsg msg;
+    double *place;
+    const char *header = 0;
+    const char *csv_path = 0;
+    FILE *csv = 0;
+    unsigned long long rng;
+    int runs = 10, samples = 1, jobs = 0, top = 10;
+    double spread = 60, dist_min = 1.5, dist_max = 2.5;
+    int fd[2];
+    int i, d, k, n, grid, done;
+    const char *value;
+
+    sim_default(&base);
+    for (i = 1; i < argc; i++) {
+        value = strchr(argv[i], '=');
+        value = (value != 0) ? value + 1 : "";
+        if (strncmp(argv[i], "runs=", 5) == 0) {
+            runs = atoi(value);
+        } else if (strncmp(argv[i], "samples=", 8) == 0) {
+            samples = atoi(value);
+        } else if (strncmp(argv[i], "jobs=", 5) == 0) {
+            jobs = atoi(value);
+        } else if (strncmp(argv[i], "top=", 4) == 0) {
+            top = atoi(value);
+        } else if (strncmp(argv[i], "spread_deg=", 11) == 0) {
+            spread = atof(value);
+        } else if (strncmp(argv[i], "dist_min=", 9) == 0) {
+            dist_min = atof(value);
+        } else if (strncmp(argv[i], "dist_max=", 9) == 0) {
+            dist_max = atof(value);
+        } else if (strncmp(argv[i], "header=", 7) == 0) {
+            header = value;
+        } else if (strncmp(argv[i], "csv=", 4) == 0) {
+            csv_path = value;
+        } else {
+            k = sweep_dim(argv[i]);
+            if (k == 0) {
+                k = (sim_set(&base, argv[i]) == 0) ? 1 : -1;
+            } else if ((k == 1) && (sweep_check(&base, &dims[n_dims - 1]) != 0)) {
+                k = -1;
+            }
+            if (k < 0) {
+                fprintf(stderr, "eod_sweep: invalid option %s\n", argv[i]);
+                return 2;
+            }
+        }
+    }
+    if (jobs <= 0) {
+        jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if ((runs < 1) || (samples < 1) || (jobs < 1)) {
+        fprintf(stderr, "eod_sweep: runs, samples and jobs must be at least 1\n");
+        return 2;
+    }
+
+    // Parameter sets, every combination of the grids for each random sample
+    grid = 1;
+    for (d = 0; d < n_dims; d++) {
+        if (dims[d].random == 0) {
+            grid *= dims[d].count;
+        }
+    }
+    n_sets = grid * samples;
+    set_values = malloc(sizeof (double) * n_sets * (n_dims > 0 ? n_dims : 1));
+    sets = calloc(n_sets, sizeof (struct SweepSet));
+    place = malloc(sizeof (double) * 3 * runs);
+    if ((set_values == 0) || (sets == 0) || (place == 0)) {
+        return 2;
+    }
+    rng = 0x2545F4914F6CDD1DULL ^ (unsigned long long) base.seed;
+    for (i = 0; i < n_sets; i++) {
+        k = i % grid;
+        for (d = 0; d < n_dims; d++) {
+            if (dims[d].random == 1) {
+                set_values[i * n_dims + d] = dims[d].lo +
+                        (dims[d].hi - dims[d].lo) * sweep_random(&rng);
+                if (dims[d].whole == 1) {
+                    set_values[i * n_dims + d] = round(set_values[i * n_dims + d]);
+                }
+            } else {
+                set_values[i * n_dims + d] = dims[d].values[k % dims[d].count];
+                k /= dims[d].count;
+            }
+        }
+        sets[i].index = i;
+    }
+
+    // Beacon placements, the same for every parameter set. A single run
+    // keeps the placement given
+    for (k = 0; k < runs; k++) {
+        place[k * 3] = base.beacon_dist;
+        place[k * 3 + 1] = base.beacon_deg;
+        place[k * 3 + 2] = base.seed + k;
+        if (runs > 1) {
+            place[k * 3] = dist_min + (dist_max - dist_min) * sweep_random(&rng);
+            place[k * 3 + 1] = spread * (2 * sweep_random(&rng) - 1);
+        }
+    }
+
+    if (pipe(fd) != 0) {
+        return 2;
+    }
+    fflush(stdout);
+    for (i = 0; i < jobs; i++) {
+        if (fork() == 0) {
+            close(fd[0]);
+            sweep_worker(&base, place, runs, i, jobs, fd[1]);
+        }
+    }
+    close(fd[1]);
+
+    if (csv_path != 0) {
+        csv = fopen(csv_path, "w");
+        if (csv != 0) {
+            fprintf(csv, "set,run,beacon_dist,beacon_deg,");
+            for (d = 0; d < n_dims; d++) {
+                fprintf(csv, "%s,", dims[d].name);
+            }
+            fprintf(csv, "tagged,finished,t_centre,t_tag,t_end,path,corrections,return_err,miss\n");
+        }
+    }
+    done = 0;
+    while (read(fd[0], &msg, sizeof (msg)) == sizeof (msg)) {
+        struct SweepSet *s = &sets[msg.set];
+        done++;
+        if ((done % 100 == 0) || (done == n_sets * runs)) {
+            fprintf(stderr, "\r%d of %d runs", done, n_sets * runs);
+        }
+        if (msg.ok == 0) {
+            continue; // Counted as neither run nor success
+        }
+        s->runs++;
+        if (msg.res.tagged & msg.res.finished) {
+            s->tagged++;
+            s->t_tag += msg.res.t_tag;
+            s->return_err += msg.res.return_err;
+        }
+        if (csv != 0) {
+            fprintf(csv, "%d,%d,%.3f,%.1f,", msg.set, msg.run,
+                    place[msg.run * 3], place[msg.run * 3 + 1]);
+            for (d = 0; d < n_dims; d++) {
+                fprintf(csv, "%g,", set_values[msg.set * n_dims + d]);
+            }
+            fprintf(csv, "%d,%d,%.0f,%.0f,%.0f,%.3f,%d,%.3f,%.3f\n",
+                    msg.res.tagged, msg.res.finished, msg.res.t_centre, msg.res.t_tag,
+                    msg.res.t_end, msg.res.path, msg.res.corrections,
+                    msg.res.return_err, msg.res.miss);
+        }
+    }
+    fprintf(stderr, "\n");
+    close(fd[0]);
+    while (wait(0) > 0);
+    if (csv != 0) {
+        fclose(csv);
+    }
+
+    qsort(sets, n_sets, sizeof (struct SweepSet), sweep_compare);
+    printf("rank success  t_tag_s return_m  parameters\n");
+    n = (top < n_sets) ? top : n_sets;
+    for (i = 0; i < n; i++) {
+        printf("%4d %3d/%-3d %8.1f %8.3f  ", i + 1, sets[i].tagged, sets[i].runs,
+                (sets[i].tagged > 0) ? sets[i].t_tag / sets[i].tagged / 1000 : 0,
+                (sets[i].tagged > 0) ? sets[i].return_err / sets[i].tagged : 0);
+        sweep_label(stdout, sets[i].index);
+        printf("\n");
+    }
+    if (header != 0) {
+        if (sweep_header(header, &base, &sets[0]) != 0) {
+            fprintf(stderr, "eod_sweep: cannot write %s\n", header);
+            return 2;
+        }
+        printf("best parameter set written to %s\n", header);
+    }
+    return 0;
+}
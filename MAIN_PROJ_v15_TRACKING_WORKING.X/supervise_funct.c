@@ -0,0 +1,263 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the loop supervisor. The main
+ |               program checks in, and the low priority interrupt counts
+ |               down the time left until the loop is stalled, clearing the
+ |               watchdog on every tick until then. Outside the control loops
+ |               (standby, calibration, the RFID display) no loop is
+ |               supervised, and only a stall of the interrupts resets the
+ |               PIC. The deadlines can be found on the header file
+ |               supervise_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "record_funct.h"
+#include "supervise_funct.h"
+
+const unsigned char * const sup_names[SUP_TASKS + 1] = {
+    TEXT("ORIENT"), TEXT("STEER"), TEXT("RETURN"), TEXT("IRQ")
+};
+
+struct SupTask sup_tasks[SUP_TASKS]; // Main only
+
+// Loop being supervised, and ms left for it to check in (0: none)
+volatile unsigned char sup_task = 0;
+volatile unsigned int sup_left_ms = 0;
+volatile unsigned char sup_on = 0; // 1 after sup_init()
+
+// Loop which stalled, kept through the watchdog reset
+HAL_PERSISTENT volatile unsigned char sup_stalled;
+
+/*=============================================================================
+ |  Function sup_init
+ |
+ |  Purpose: sup_init records a reset by the watchdog, and starts the watchdog
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      Unsigned char of the loop which stalled (SUP_ORIENT - SUP_RETURN), or
+ |      SUP_IRQ if the interrupts stalled, if reset by the watchdog, else
+ |      SUP_NONE
+ |
+ |  Comments: To be called once at power up, after rec_init(). The cause of
+ |            reset is read before the watchdog is first cleared, as clearing
+ |            it sets the TO bit again.
++============================================================================*/
+
+unsigned char sup_init(void) {
+    unsigned char stalled = SUP_NONE;
+
+    if ((hal_reset_cause() & HAL_RESET_TO) == 0) {
+        stalled = (sup_stalled < SUP_TASKS) ? sup_stalled : SUP_IRQ;
+        rec_log(REC_STALL, stalled);
+    }
+    sup_stalled = SUP_NONE;
+    sup_left_ms = 0;
+    hal_wdt_clear();
+    hal_wdt_enable(1);
+    sup_on = 1;
+    return stalled;
+}
+
+/*=============================================================================
+ |  Function sup_deadline
+ |
+ |  Purpose: sup_deadline returns the deadline of an iteration of a loop
+ |
+ |  Parameters:
+ |      task (unsigned char) - Loop (SUP_ORIENT - SUP_RETURN)
+ |
+ |  Returns:
+ |      Unsigned integer of the deadline in ms
++============================================================================*/
+
+unsigned int sup_deadline(unsigned char task) {
+    if (task == SUP_ORIENT) {
+        return SUP_ORIENT_MS;
+    }
+    return G_params.action_ms + SUP_SLACK_MS;
+}
+
+/*=============================================================================
+ |  Function sup_arm
+ |
+ |  Purpose: sup_arm gives a loop until its hang limit to check in again
+ |
+ |  Parameters:
+ |      task (unsigned char) - Loop (SUP_ORIENT - SUP_RETURN)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The forward run at the end of orientation is done within one
+ |            iteration (see orientate()), so it is added to the limit.
++============================================================================*/
+
+void sup_arm(unsigned char task) {
+    unsigned int limit = SUP_HANG * sup_deadline(task);
+
+    if (task == SUP_ORIENT) {
+        limit += G_params.run_s * 1000;
+    }
+    hal_irq_low_off();
+    sup_task = task;
+    sup_left_ms = limit;
+    hal_irq_low_on();
+}
+
+/*=============================================================================
+ |  Function sup_start
+ |
+ |  Purpose: sup_start starts supervising a loop, before its first iteration
+ |
+ |  Parameters:
+ |      task (unsigned char) - Loop (SUP_ORIENT - SUP_RETURN)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void sup_start(unsigned char task) {
+    sup_tasks[task].last_ms = time_ms();
+    sup_arm(task);
+}
+
+/*=============================================================================
+ |  Function sup_checkin
+ |
+ |  Purpose: sup_checkin ends an iteration of the loop being supervised,
+ |           counting an overrun if it took longer than the deadline
+ |
+ |  Parameters:
+ |      task (unsigned char) - Loop (SUP_ORIENT - SUP_RETURN)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called at the top of each iteration, so the last iteration of
+ |            a loop, which may leave it early, is not timed. A new worst
+ |            lateness is recorded as REC_OVERRUN.
++============================================================================*/
+
+void sup_checkin(unsigned char task) {
+    struct SupTask *t = &sup_tasks[task];
+    unsigned int now = time_ms();
+    unsigned int period = (unsigned int) (now - t->last_ms);
+    unsigned int deadline = sup_deadline(task);
+
+    t->last_ms = now;
+    sup_arm(task);
+    if (period <= deadline) {
+        return;
+    }
+    period -= deadline; // Lateness
+    if (t->overruns < 255) {
+        t->overruns++;
+    }
+    if (period > t->worst_ms) {
+        t->worst_ms = period;
+        rec_log(REC_OVERRUN, (task << 12) | ((period > 0xFFF) ? 0xFFF : period));
+    }
+}
+
+/*=============================================================================
+ |  Function sup_stop
+ |
+ |  Purpose: sup_stop stops supervising the loop, on leaving it
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void sup_stop(void) {
+    hal_irq_low_off();
+    sup_left_ms = 0;
+    hal_irq_low_on();
+}
+
+/*=============================================================================
+ |  Function sup_service
+ |
+ |  Purpose: sup_service counts down the time left for the loop to check in,
+ |           and clears the watchdog while it has not run out
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called from the low priority interrupt every ms. Once the loop
+ |            has stalled, the motors are held stopped on every tick until
+ |            the watchdog resets the PIC, up to 2 s later.
++============================================================================*/
+
+void sup_service(void) {
+    if (sup_on == 0) {
+        return; // Before sup_init()
+    }
+    if (sup_stalled != SUP_NONE) {
+        MOTOR_CUT();
+        return;
+    }
+    if (sup_left_ms != 0) {
+        sup_left_ms--;
+        if (sup_left_ms == 0) {
+            sup_stalled = sup_task;
+            return;
+        }
+    }
+    hal_wdt_clear();
+}
+
+/*=============================================================================
+ |  Function sup_dump
+ |
+ |  Purpose: sup_dump sends the deadline statistics of every loop over
+ |           serial, one loop per line: name, overruns and worst lateness in
+ |           ms, as hexadecimal
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void sup_dump(void) {
+    unsigned char i;
+
+    put_string_serial(TEXT("SUP\r\n"));
+    for (i = 0; i < SUP_TASKS; i++) {
+        put_string_serial(sup_names[i]);
+        put_char_serial(' ');
+        put_hex(sup_tasks[i].overruns);
+        put_char_serial(' ');
+        put_hex(sup_tasks[i].worst_ms >> 8);
+        put_hex(sup_tasks[i].worst_ms);
+        put_string_serial(TEXT("\r\n"));
+    }
+    put_string_serial(TEXT("END\r\n"));
+}
@@ -0,0 +1,85 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the loop supervisor.
+ |               Each control loop of RUN checks in once per iteration. An
+ |               iteration longer than the deadline of its loop is counted as
+ |               an overrun, with the worst lateness kept and recorded (see
+ |               record_funct.h). The hardware watchdog is cleared by the
+ |               low priority interrupt only while the loop being supervised
+ |               has checked in within its hang limit, so a stall of either
+ |               the loop or the interrupts resets the PIC, which starts in
+ |               STANDBY with the motors stopped. A stalled loop also has its
+ |               motors stopped at once, before the reset. Overruns are sent
+ |               over serial when 'W' is received in standby. Detailed
+ |               function descriptions can be found in the supervise_funct.c
+ |               file.
+ +===========================================================================*/
+
+#ifndef SUPERVISE_FUNCT_H
+#define	SUPERVISE_FUNCT_H
+
+// Supervised loops, one at a time
+#define SUP_ORIENT 0 // Initial orientation, one orientate() per iteration
+#define SUP_STEER 1 // Steering, one steer() per iteration
+#define SUP_RETURN 2 // Return sequence, one steering action per iteration
+#define SUP_TASKS 3
+#define SUP_IRQ 3 // Reset cause: interrupts stalled, not a loop
+#define SUP_NONE 0xFF
+
+// Deadlines: two ir_filter() (2 s) and a 1 s turn per orientation iteration,
+// G_params.action_ms plus the motor ramps per steering action
+#define SUP_ORIENT_MS 3500
+#define SUP_SLACK_MS 250
+
+// A loop is stalled after this many deadlines without checking in. The
+// forward run of G_params.run_s is added for the orientation loop
+#define SUP_HANG 2
+
+/*=============================================================================
+ |  Structure SupTask
+ |
+ |  Purpose: Deadline statistics of one loop since power up
+ |
+ |  Parameters:
+ |      last_ms (unsigned int) - G_time_ms of the last check in
+ |      worst_ms (unsigned int) - Worst lateness past the deadline
+ |      overruns (unsigned char) - Iterations past the deadline, which stops
+ |                                 at 255
++============================================================================*/
+
+struct SupTask {
+    unsigned int last_ms;
+    unsigned int worst_ms;
+    unsigned char overruns;
+};
+
+extern const unsigned char * const sup_names[SUP_TASKS + 1];
+
+unsigned char sup_init(void);
+void sup_start(unsigned char task);
+void sup_checkin(unsigned char task);
+void sup_stop(void);
+void sup_service(void);
+void sup_dump(void);
+
+#endif
@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+# =============================================================================
+#  Assignment: Explosive Ordinance Disposal
+#
+#  Author: Lim Siew Han & Justin Kek
+#  Language: Python 3
+#  Tools: Serial capture of the firmware built with TRACE defined
+#  Microchip: PIC18F4331
+#
+#  School: Imperial College London
+#  Department: Mechanical Engineering
+#  Module: Embedded C for Microcontrollers
+#  Class: MEng Graduating 2021
+# -----------------------------------------------------------------------------
+#  Description: Decoder of the event trace (see trace_funct.h). Reads the
+#               last TRACE ... END block sent in standby on 'T', merges the
+#               rings of the three priorities into one timeline and prints
+#               each event with the time since the one before, flagging
+#               interrupts which took longer than --spike-us, late ticks
+#               and ticks lost while interrupts were held off:
+#                   trace.py [capture.txt] [--spike-us 500]
+#               The capture is read from stdin if no file is given. The
+#               exit status is 1 if no trace is found.
+#
+#               Each event carries TIMER5 (1 us, wraps every 65.5 ms) and
+#               the tick count of the low priority interrupt. Between events
+#               up to MAX_FINE_MS ticks apart, the time is taken from TIMER5
+#               to the us, else from the ticks (marked ~). If TIMER5 shows
+#               more time than the ticks allow, ticks were lost (marked !),
+#               i.e. the interrupts were held off for at least a tick, and
+#               the time is only known modulo 65.5 ms.
+# =============================================================================
+import argparse
+import functools
+import sys
+
+MAX_FINE_MS = 32  # Ticks over which TIMER5 cannot have wrapped
+TICK_US = 1012  # Tick period, 253 counts of 4 us (see init_counter())
+WRAP_US = 65536
+
+LEVELS = {"M": "main", "L": "low", "H": "high"}
+RECORDS = {1: "BOOT", 2: "STATE", 3: "LOST", 4: "RFID", 5: "SUMMARY",
+           6: "STALL", 7: "OVERRUN", 8: "REACT"}
+MOTORS = {0: "FULL", 1: "VEER_LEFT", 2: "VEER_RIGHT", 3: "STOP", 4: "TURN"}
+
+
+class Event:
+    def __init__(self, level, us, ms, eid, value):
+        self.level = level
+        self.us = us
+        self.ms = ms
+        self.id = eid
+        self.value = value
+
+
+def parse(lines):
+    """Events of the last trace block, ring by ring, each oldest first."""
+    found = None
+    events = None
+    for line in lines:
+        line = line.strip()
+        if line == "TRACE":
+            events = []
+        elif line == "END":
+            if events is not None:
+                found = events
+            events = None
+        elif events is not None:
+            fields = line.split()
+            if (len(fields) == 5) and (fields[0] in LEVELS):
+                try:
+                    events.append(Event(fields[0], *(int(f, 16) for f in fields[1:])))
+                except ValueError:
+                    pass
+    return found
+
+
+def signed(value, bits):
+    """Two's complement of value, bits wide."""
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >= (1 << (bits - 1)) else value
+
+
+def delta(a, b):
+    """Time from event a to event b as (us, mark): mark is "" if taken from
+    TIMER5, "~" if from the ticks and "!" if ticks were lost, in which case
+    us is the least time TIMER5 allows."""
+    ticks = signed(b.ms - a.ms, 16)
+    if abs(ticks) > MAX_FINE_MS:
+        return ticks * TICK_US, "~"
+    us = signed(b.us - a.us, 16)
+    if us < (ticks - 2) * TICK_US:
+        us += WRAP_US
+    if us > (ticks + 2) * TICK_US:
+        return us, "!"
+    return us, ""
+
+
+def compare(a, b):
+    """Order of two events of different rings."""
+    ticks = signed(b.ms - a.ms, 16)
+    if abs(ticks) > MAX_FINE_MS:
+        return -1 if ticks > 0 else 1
+    us = signed(b.us - a.us, 16)
+    if us != 0:
+        return -1 if us > 0 else 1
+    return -1 if ticks > 0 else (1 if ticks < 0 else 0)
+
+
+def merge(events):
+    """Events of all rings in one timeline, each ring keeping its order."""
+    rings = {}
+    for e in events:
+        rings.setdefault(e.level, []).append(e)
+    heads = [r for r in rings.values() if r]
+    timeline = []
+    while heads:
+        first = min(heads, key=functools.cmp_to_key(lambda x, y: compare(x[0], y[0])))
+        timeline.append(first.pop(0))
+        heads = [r for r in heads if r]
+    return timeline
+
+
+def describe(e):
+    """Name and value of an event."""
+    if e.id == 0x01:
+        causes = [n for bit, n in ((1, "rx"), (2, "button")) if e.value & bit]
+        return "HIGH_IN", " ".join(causes)
+    if e.id == 0x02:
+        return "HIGH_OUT", ""
+    if e.id == 0x03:
+        causes = [n for bit, n in ((1, "tick"), (2, "tx"), (4, "ir")) if e.value & bit]
+        return "LOW_IN", " ".join(causes)
+    if e.id == 0x04:
+        return "LOW_OUT", ""
+    if e.id == 0x05:
+        return "STOP", ""
+    if e.id & 0xF0 == 0x10:
+        name = RECORDS.get(e.id & 0x0F, "REC%d" % (e.id & 0x0F))
+        if (e.id & 0x0F) == 2:
+            text = "".join(chr(c) for c in (e.value >> 8, e.value & 0xFF) if 32 < c < 127)
+            return "REC " + name, text
+        return "REC " + name, "0x%04X" % e.value
+    if e.id & 0xF0 == 0x20:
+        name = MOTORS.get(e.id & 0x0F, "M%d" % (e.id & 0x0F))
+        return "MOTOR " + name, "dir %d power %d" % (e.value >> 8, e.value & 0xFF)
+    if e.id & 0xF0 == 0x30:
+        return "IR %d" % (e.id & 0x0F), "%d" % e.value
+    return "0x%02X" % e.id, "0x%04X" % e.value
+
+
+def report(timeline, spike_us):
+    """Prints the timeline and a summary of the interrupts, returning the
+    number of flagged events."""
+    flagged = 0
+    entered = {}  # Level: entry event of the interrupt being run
+    last_tick = None
+    durations = {"L": [], "H": []}
+    t = 0
+    approx = ""
+    print("%12s %9s  %-4s  %-16s %-16s %s" % ("t (ms)", "dt (us)", "pri", "event", "value", "notes"))
+    for i, e in enumerate(timeline):
+        notes = []
+        if i > 0:
+            dt, mark = delta(timeline[i - 1], e)
+            t += dt
+            approx = approx or mark
+            if mark == "!":
+                notes.append("ticks lost, interrupts held off")
+        else:
+            dt, mark = 0, ""
+        name, value = describe(e)
+        if e.id in (0x01, 0x03):
+            entered[e.level] = e
+            if (e.id == 0x01) and (entered.get("L") is not None):
+                notes.append("preempts lp_timer()")
+            if (e.id == 0x03) and (e.value & 1):
+                if last_tick is not None:
+                    gap, gap_mark = delta(last_tick, e)
+                    if (gap_mark != "~") and (gap > TICK_US * 3 // 2):
+                        notes.append("tick late by %d us" % (gap - TICK_US))
+                last_tick = e
+        elif e.id in (0x02, 0x04):
+            entry = entered.get(e.level)
+            if entry is not None:
+                took, took_mark = delta(entry, e)
+                durations[e.level].append(took)
+                if took > spike_us:
+                    notes.append("took %s%d us" % (took_mark, took))
+            entered[e.level] = None
+        if any(n.startswith(("took", "tick late", "ticks lost")) for n in notes):
+            flagged += 1
+        print("%12s %9s  %-4s  %-16s %-16s %s" % (
+            "%s%.3f" % (approx, t / 1000.0), "%s%d" % (mark, dt), LEVELS[e.level],
+            name, value, ", ".join(notes)))
+    print()
+    for level, name in (("H", "hp_rfid()"), ("L", "lp_timer()")):
+        d = durations[level]
+        if d:
+            print("%s: %d calls, mean %d us, max %d us" % (name, len(d), sum(d) // len(d), max(d)))
+    print("%d events, %d flagged" % (len(timeline), flagged))
+    return flagged
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode the event trace of a RUN")
+    parser.add_argument("capture", nargs="?", help="serial capture, else stdin")
+    parser.add_argument("--spike-us", type=int, default=500,
+                        help="flag interrupts which take longer (default 500)")
+    args = parser.parse_args()
+    if args.capture is None:
+        events = parse(sys.stdin)
+    else:
+        with open(args.capture, errors="replace") as f:
+            events = parse(f)
+    if not events:
+        print("no trace found", file=sys.stderr)
+        return 1
+    report(merge(events), args.spike_us)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
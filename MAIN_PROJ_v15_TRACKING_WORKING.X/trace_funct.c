@@ -0,0 +1,154 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the event trace. Events are
+ |               written by the TRACE_ macros of trace_funct.h, inline, into
+ |               the ring of their priority, each ring keeping its last
+ |               events. The event list can be found on the header file
+ |               trace_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "record_funct.h"
+#include "trace_funct.h"
+
+#ifdef TRACE
+
+struct TrEvent tr_main[TR_MAIN_SIZE];
+struct TrEvent tr_low[TR_LOW_SIZE];
+struct TrEvent tr_high[TR_HIGH_SIZE];
+unsigned char tr_main_in = 0;
+unsigned char tr_low_in = 0;
+unsigned char tr_high_in = 0;
+volatile uint16_t tr_ms = 0; // Incremented by tr_tick()
+volatile unsigned char tr_on = 0;
+
+/*=============================================================================
+ |  Function tr_start
+ |
+ |  Purpose: tr_start empties the rings and starts tracing
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called at the start of each RUN, so standby shows the last one.
++============================================================================*/
+
+void tr_start(void) {
+    unsigned char i;
+
+    tr_on = 0;
+    for (i = 0; i < TR_MAIN_SIZE; i++) {
+        tr_main[i].id = 0;
+    }
+    for (i = 0; i < TR_LOW_SIZE; i++) {
+        tr_low[i].id = 0;
+    }
+    for (i = 0; i < TR_HIGH_SIZE; i++) {
+        tr_high[i].id = 0;
+    }
+    tr_on = 1;
+}
+
+/*=============================================================================
+ |  Function tr_stop
+ |
+ |  Purpose: tr_stop marks the end of the trace and stops tracing, keeping
+ |           the rings for tr_dump()
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void tr_stop(void) {
+    TRACE_MAIN(TR_STOP, 0);
+    tr_on = 0;
+}
+
+/*=============================================================================
+ |  Function tr_ring
+ |
+ |  Purpose: tr_ring sends the events of one ring over serial, oldest first,
+ |           one per line: priority, TIMER5, tick, event and value, as
+ |           hexadecimal
+ |
+ |  Parameters:
+ |      level (char) - 'M' (main), 'L' (low) or 'H' (high priority)
+ |      *ring (struct TrEvent) - Ring of events
+ |      size (unsigned char) - Events in the ring
+ |      next (unsigned char) - Next slot, i.e. the oldest event
+ |
+ |  Returns: Nothing (Void function)
++============================================================================*/
+
+void tr_ring(char level, struct TrEvent *ring, unsigned char size, unsigned char next) {
+    unsigned char i;
+    struct TrEvent *e;
+
+    for (i = 0; i < size; i++) {
+        e = &ring[(next + i) & (size - 1)];
+        if (e->id == 0) {
+            continue; // Empty
+        }
+        put_char_serial(level);
+        put_char_serial(' ');
+        put_hex(e->us >> 8);
+        put_hex(e->us);
+        put_char_serial(' ');
+        put_hex(e->ms >> 8);
+        put_hex(e->ms);
+        put_char_serial(' ');
+        put_hex(e->id);
+        put_char_serial(' ');
+        put_hex(e->value >> 8);
+        put_hex(e->value);
+        put_string_serial(TEXT("\r\n"));
+    }
+}
+
+/*=============================================================================
+ |  Function tr_dump
+ |
+ |  Purpose: tr_dump sends the trace over serial, ring by ring
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called in standby, once tracing has stopped.
++============================================================================*/
+
+void tr_dump(void) {
+    put_string_serial(TEXT("TRACE\r\n"));
+    tr_ring('M', tr_main, TR_MAIN_SIZE, tr_main_in);
+    tr_ring('L', tr_low, TR_LOW_SIZE, tr_low_in);
+    tr_ring('H', tr_high, TR_HIGH_SIZE, tr_high_in);
+    put_string_serial(TEXT("END\r\n"));
+}
+
+#endif
@@ -0,0 +1,132 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the event trace, which
+ |               keeps the last events of a RUN in RAM: interrupt entry and
+ |               exit, records of the mission recorder (state changes, signal
+ |               lost, RFID), motor commands and IR readings, each with the
+ |               time to the us. Tracing starts with each RUN and stops on
+ |               entering standby, where the trace is sent over serial when
+ |               'T' is received, to be decoded into a timeline by
+ |               trace/trace.py. Only built with TRACE defined; otherwise
+ |               every event compiles to nothing. Detailed function
+ |               descriptions can be found in the trace_funct.c file.
+ +===========================================================================*/
+
+#ifndef TRACE_FUNCT_H
+#define	TRACE_FUNCT_H
+
+// Events, 0 for an empty slot
+#define TR_HIGH_IN 0x01 // Value: RCIF (bit 0), INT0IF (bit 1)
+#define TR_HIGH_OUT 0x02
+#define TR_LOW_IN 0x03 // Value: tick (bit 0), serial TX (bit 1), IR capture or ADC (bit 2)
+#define TR_LOW_OUT 0x04
+#define TR_STOP 0x05 // Tracing stopped
+#define TR_REC 0x10 // Plus record type (see record_funct.h), value: payload
+#define TR_MOTOR 0x20 // Plus TR_M_ command, value: direction (high), power
+#define TR_IR 0x30 // Plus sensor, value: capture returned by get_ir()
+
+// Motor commands, primitives of dc_motor_funct.c
+#define TR_M_FULL 0 // full_speed()
+#define TR_M_VEER_LEFT 1 // veer_left()
+#define TR_M_VEER_RIGHT 2 // veer_right()
+#define TR_M_STOP 3 // stop_all()
+#define TR_M_TURN 4 // turn()
+
+// Events kept per priority, powers of 2. 7 bytes per event
+#ifndef TR_MAIN_SIZE
+#define TR_MAIN_SIZE 16
+#endif
+#ifndef TR_LOW_SIZE
+#define TR_LOW_SIZE 8
+#endif
+#ifndef TR_HIGH_SIZE
+#define TR_HIGH_SIZE 8
+#endif
+
+#ifdef TRACE
+/*=============================================================================
+ |  Structure TrEvent
+ |
+ |  Purpose: One traced event
+ |
+ |  Parameters:
+ |      us (uint16_t) - TIMER5 (1 us per count, wraps every 65.5 ms)
+ |      ms (uint16_t) - Ticks of the low priority interrupt since power up
+ |      id (unsigned char) - Event, see above
+ |      value (uint16_t) - Value, see above
++============================================================================*/
+
+struct TrEvent {
+    uint16_t us;
+    uint16_t ms;
+    unsigned char id;
+    uint16_t value;
+};
+
+// One ring per priority, so each is written by one priority only and needs
+// no locking. Only reading the time is done with interrupts held off, for a
+// few instructions, as the high byte of TIMER5 is latched by the low one
+extern struct TrEvent tr_main[TR_MAIN_SIZE];
+extern struct TrEvent tr_low[TR_LOW_SIZE];
+extern struct TrEvent tr_high[TR_HIGH_SIZE];
+extern unsigned char tr_main_in, tr_low_in, tr_high_in; // Next slot
+extern volatile uint16_t tr_ms;
+extern volatile unsigned char tr_on;
+
+#define TR_PUT(ring, size, event, v, off, on) do { \
+        if (tr_on) { \
+            struct TrEvent *tr_e = &ring[ring##_in]; \
+            ring##_in = (ring##_in + 1) & ((size) - 1); \
+            off; \
+            tr_e->us = hal_timer_us(); \
+            tr_e->ms = tr_ms; \
+            on; \
+            tr_e->id = (event); \
+            tr_e->value = (v); \
+        } \
+    } while (0)
+
+// Main program, not to be used with interrupts disabled
+#define TRACE_MAIN(event, v) TR_PUT(tr_main, TR_MAIN_SIZE, event, v, \
+        hal_irq_off(), hal_irq_on())
+// Low priority interrupt
+#define TRACE_LOW(event, v) TR_PUT(tr_low, TR_LOW_SIZE, event, v, \
+        hal_irq_off(), hal_irq_on())
+// High priority interrupt, which is never interrupted
+#define TRACE_HIGH(event, v) TR_PUT(tr_high, TR_HIGH_SIZE, event, v, \
+        (void) 0, (void) 0)
+#define tr_tick() (tr_ms++) // Every tick of the low priority interrupt
+
+void tr_start(void);
+void tr_stop(void);
+void tr_dump(void);
+#else
+#define TRACE_MAIN(event, v) ((void) 0)
+#define TRACE_LOW(event, v) ((void) 0)
+#define TRACE_HIGH(event, v) ((void) 0)
+#define tr_tick() ((void) 0)
+#define tr_start() ((void) 0)
+#define tr_stop() ((void) 0)
+#endif
+
+#endif
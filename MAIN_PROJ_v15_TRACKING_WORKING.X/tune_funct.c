@@ -0,0 +1,310 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function file for the tuning protocol. Requests
+ |               are collected by the high priority interrupt and handled by
+ |               the main program in tune_poll(), so that parameters are never
+ |               changed part way through a control step. Replies are queued
+ |               and sent by the low priority interrupt, such that the main
+ |               program never waits for the serial port. The frame layout
+ |               can be found on the header file tune_funct.h
+ +===========================================================================*/
+#include "hal.h"
+#include "dc_motor_struct.h"
+#include "functions.h"
+#include "rotate_funct.h"
+#include "eeprom_funct.h"
+#include "tune_funct.h"
+
+#ifdef TUNE
+
+volatile unsigned char tune_on = 0;
+
+// Request being received, written by interrupt until tune_ready is set
+unsigned char tune_frame[TUNE_RX_SIZE]; // Length, command, data, CRC
+unsigned char tune_rx_n = 0; // Bytes received + 1, 0 waiting for start
+volatile unsigned char tune_ready = 0; // 1 when tune_frame holds a request
+
+// Reply queue, filled by main and emptied by interrupt
+unsigned char tune_tx_buf[TUNE_TX_SIZE];
+volatile unsigned char tune_tx_in = 0;
+volatile unsigned char tune_tx_out = 0;
+
+/*=============================================================================
+ |  Function tune_enable
+ |
+ |  Purpose: tune_enable hands the serial port over to the tuning protocol,
+ |           until the next power cycle
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The RFID reader must be disconnected, as its bytes would no
+ |            longer be recognised and the RFID can then not be retrieved.
++============================================================================*/
+
+void tune_enable(void) {
+    tune_rx_n = 0;
+    tune_ready = 0;
+    tune_tx_in = 0;
+    tune_tx_out = 0;
+    hal_uart_tx_irq_low(); // Replies sent by low priority interrupt
+    tune_on = 1;
+}
+
+/*=============================================================================
+ |  Function tune_rx
+ |
+ |  Purpose: tune_rx collects a received byte into the request frame, setting
+ |           tune_ready once the whole frame has arrived
+ |
+ |  Parameters:
+ |      byte (unsigned char) - Byte from RCREG
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called from the high priority interrupt only. Bytes arriving
+ |            before the previous request has been handled are dropped, as
+ |            are frames with an invalid length. The CRC is checked by
+ |            tune_poll().
++============================================================================*/
+
+void tune_rx(unsigned char byte) {
+    if (tune_ready == 1) {
+        return; // Previous request not handled yet
+    }
+    if (tune_rx_n == 0) {
+        if (byte == TUNE_SOF) {
+            tune_rx_n = 1;
+        }
+        return;
+    }
+    if ((tune_rx_n == 1) & ((byte == 0) | (byte > TUNE_RX_SIZE - 2))) {
+        tune_rx_n = 0; // Invalid length, wait for next start
+        return;
+    }
+    tune_frame[tune_rx_n - 1] = byte;
+    tune_rx_n++;
+    if (tune_rx_n == tune_frame[0] + 3) {
+        // Length, command and data, CRC received
+        tune_rx_n = 0;
+        tune_ready = 1;
+    }
+}
+
+/*=============================================================================
+ |  Function tune_tx
+ |
+ |  Purpose: tune_tx sends the next queued reply byte, and disables the
+ |           transmit interrupt once the queue is empty
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: Called from the low priority interrupt when TXIF is set.
++============================================================================*/
+
+void tune_tx(void) {
+    hal_uart_tx(tune_tx_buf[tune_tx_out]);
+    tune_tx_out = (tune_tx_out + 1) & (TUNE_TX_SIZE - 1);
+    if (tune_tx_out == tune_tx_in) {
+        hal_uart_tx_irq(0); // Queue empty
+    }
+}
+
+/*=============================================================================
+ |  Function tune_space
+ |
+ |  Purpose: tune_space returns the number of bytes which can be queued for
+ |           tune_tx()
+ |
+ |  Parameters:
+ |      Nothing (No arguments)
+ |
+ |  Returns:
+ |      Unsigned char of the free bytes, such that tune_reply() queues a
+ |      reply of n data bytes if n + 4 is at most this
++============================================================================*/
+
+unsigned char tune_space(void) {
+    return TUNE_TX_SIZE - 1 - ((tune_tx_in - tune_tx_out) & (TUNE_TX_SIZE - 1));
+}
+
+/*=============================================================================
+ |  Function tune_reply
+ |
+ |  Purpose: tune_reply queues a reply frame to be sent by tune_tx()
+ |
+ |  Parameters:
+ |      command (unsigned char) - Command of the reply, without 0x80
+ |      *data (unsigned char) - Data of the reply
+ |      n (unsigned char) - Number of data bytes
+ |
+ |  Returns: Nothing (Void function)
+ |
+ |  Comments: The reply is dropped if the queue does not have space for all
+ |            of it, rather than waiting.
++============================================================================*/
+
+void tune_reply(unsigned char command, unsigned char *data, unsigned char n) {
+    unsigned char used = (tune_tx_in - tune_tx_out) & (TUNE_TX_SIZE - 1);
+    unsigned char frame[4];
+    unsigned char crc;
+    unsigned char i;
+
+    if (used + n + 4 >= TUNE_TX_SIZE) {
+        return; // No space
+    }
+    frame[0] = TUNE_SOF;
+    frame[1] = n + 1;
+    frame[2] = command | 0x80;
+    crc = crc8(crc8(0, frame[1]), frame[2]);
+    for (i = 0; i < 3; i++) {
+        tune_tx_buf[tune_tx_in] = frame[i];
+        tune_tx_in = (tune_tx_in + 1) & (TUNE_TX_SIZE - 1);
+    }
+    for (i = 0; i < n; i++) {
+        crc = crc8(crc, data[i]);
+        tune_tx_buf[tune_tx_in] = data[i];
+        tune_tx_in = (tune_tx_in + 1) & (TUNE_TX_SIZE - 1);
+    }
+    tune_tx_buf[tune_tx_in] = crc;
+    tune_tx_in = (tune_tx_in + 1) & (TUNE_TX_SIZE - 1);
+    hal_uart_tx_irq(1); // Start sending
+}
+
+/*=============================================================================
+ |  Function tune_poll
+ |
+ |  Purpose: tune_poll handles a received request, if any, and queues the
+ |           reply
+ |
+ |  Parameters:
+ |      *cont (struct Control) - Address of the instance of the structure
+ |                               Control
+ |      *mL (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |      *mR (struct DC_motor) - Address of an instance of the DC_motor
+ |                              structure
+ |
+ |  Returns:
+ |      Unsigned char of the calibration mode requested (MODE_CAL_ROT or
+ |      MODE_CAL_IR), to be run by the caller, else MODE_STANDBY
+ |
+ |  Comments: To be called from the standby program and once per iteration
+ |            of the control loops, so a request is answered within one
+ |            control step. Calibration and saving are refused in RUN, as
+ |            they would stall the control loop.
++============================================================================*/
+
+unsigned char tune_poll(struct Control *cont, struct DC_motor *mL, struct DC_motor *mR) {
+    unsigned char n = tune_frame[0]; // Length of command and data
+    unsigned char command = tune_frame[1];
+    unsigned char *data = tune_frame + 2;
+    unsigned char reply[14];
+    unsigned char error = 0;
+    unsigned char mode = MODE_STANDBY;
+    unsigned int value;
+    unsigned char crc = 0;
+    unsigned char i;
+
+    if (tune_ready == 0) {
+        return MODE_STANDBY; // Nothing received
+    }
+    for (i = 0; i <= n; i++) {
+        crc = crc8(crc, tune_frame[i]);
+    }
+
+    if (crc != tune_frame[n + 1]) {
+        error = TUNE_ERR_CRC;
+    } else if (command == TUNE_GET) {
+        if ((n != 2) | (data[0] >= PAR_COUNT)) {
+            error = TUNE_ERR_ARG;
+        } else {
+            value = param_get(data[0]);
+            reply[0] = data[0];
+            reply[1] = value >> 8;
+            reply[2] = value;
+            tune_reply(command, reply, 3);
+        }
+    } else if (command == TUNE_SET) {
+        if ((n != 4) | (data[0] >= PAR_COUNT)) {
+            error = TUNE_ERR_ARG;
+        } else {
+            param_set(data[0], ((unsigned int) data[1] << 8) | data[2]);
+            value = param_get(data[0]);
+            reply[0] = data[0];
+            reply[1] = value >> 8;
+            reply[2] = value;
+            tune_reply(command, reply, 3);
+        }
+    } else if (command == TUNE_SAVE) {
+        if (G_run == 1) {
+            error = TUNE_ERR_BUSY;
+        } else {
+            params_save();
+            tune_reply(command, reply, 0);
+        }
+    } else if (command == TUNE_CAL) {
+        if (G_run == 1) {
+            error = TUNE_ERR_BUSY;
+        } else if ((n != 2) | ((data[0] != MODE_CAL_ROT) & (data[0] != MODE_CAL_IR))) {
+            error = TUNE_ERR_ARG;
+        } else {
+            mode = data[0]; // Run by caller after reply is queued
+            tune_reply(command, data, 1);
+        }
+    } else if (command == TUNE_COUNT) {
+        value = time_ms();
+        reply[0] = value >> 8;
+        reply[1] = value;
+        reply[2] = G_run;
+        reply[3] = G_rfid_retrieved;
+        reply[4] = cont->finding_direction;
+        reply[5] = cont->i;
+        reply[6] = cont->ir_left >> 8;
+        reply[7] = cont->ir_left;
+        reply[8] = cont->ir_right >> 8;
+        reply[9] = cont->ir_right;
+        reply[10] = cont->ir_diff >> 8;
+        reply[11] = cont->ir_diff;
+        reply[12] = mL->power;
+        reply[13] = mR->power;
+        tune_reply(command, reply, 14);
+    } else {
+        error = TUNE_ERR_CMD;
+    }
+
+    if (error != 0) {
+        reply[0] = command;
+        reply[1] = error;
+        tune_reply(TUNE_ERR, reply, 2);
+    }
+    tune_ready = 0; // Allow next request
+    return mode;
+}
+
+#endif
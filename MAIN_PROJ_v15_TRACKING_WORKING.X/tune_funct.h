@@ -0,0 +1,94 @@
+/* ============================================================================
+ |  Assignment: Explosive Ordinance Disposal
+ |
+ |  Author: Lim Siew Han & Justin Kek
+ |  Language: C
+ |  IDE: MPLAB X IDE v4.20
+ |  Compiler: XC8 (v2.00)
+ |  Compiler Settings: Optimisation Level 1
+ |  Microchip: PIC18F4331
+ |  Programmer: PICkit3
+ |  Program Memory Usage: 87%
+ |  Data Memory Usage: 46%
+ |
+ |  School: Imperial College London
+ |  Department: Mechanical Engineering
+ |  Module: Embedded C for Microcontrollers
+ |  Class: MEng Graduating 2021
+ |
+ |  Instructor: Dr Ravi Vaidyanathan
+ |  Due Date: 10 December 2019
+ |  Last Updated: 9 December 2019 1300
+ +-----------------------------------------------------------------------------
+ |  Description: This is the function header file for the tuning protocol,
+ |               which reads and writes parameters, triggers calibration and
+ |               reports counters over the serial port in place of the RFID
+ |               reader, once enabled from the standby menu (TUNE). Only
+ |               built with TUNE defined; otherwise the serial port is for
+ |               the RFID reader and standby commands only, and every call
+ |               compiles to nothing. Detailed function descriptions can be
+ |               found in the tune_funct.c file.
+ |               Requires functions.h to be included first.
+ +===========================================================================*/
+
+#ifndef TUNE_FUNCT_H
+#define	TUNE_FUNCT_H
+
+/* Frame layout, 9600 baud, both directions
+ * Byte 0: TUNE_SOF
+ * Byte 1: Length n, number of bytes from command to end of data (1 - 6)
+ * Byte 2: Command (request), command | 0x80 (reply)
+ * Byte 3 - n+1: Data, unsigned ints high byte first
+ * Byte n+2: CRC-8 (see crc8()) of bytes 1 to n+1
+ *
+ * Request                  Data sent            Data replied
+ * TUNE_GET  Get parameter  id                   id, value
+ * TUNE_SET  Set parameter  id, value            id, value after limiting
+ * TUNE_SAVE Save to EEPROM -                    -
+ * TUNE_CAL  Calibrate      mode (MODE_CAL_...)  mode
+ * TUNE_COUNT Counters      -                    time_ms, G_run, RFID flag,
+ *                                               finding_direction, i,
+ *                                               ir_left, ir_right, ir_diff,
+ *                                               left power, right power
+ * Parameter ids are indices of par_info (see eeprom_funct.c). A request which
+ * fails is answered with TUNE_ERR, data: command, error code.
+ * TUNE_LOG frames are sent unrequested by builds with REPLAY_LOG defined,
+ * whether or not tuning is enabled (see replay_funct.h), which so require
+ * TUNE defined as well. */
+#define TUNE_SOF 0x7E // Not used by the RFID reader (0x02 - 0x03)
+#define TUNE_RX_SIZE 8 // Longest request, excluding start byte
+#define TUNE_TX_SIZE 32 // Reply queue, must be a power of 2. A reply which
+                        // does not fit is dropped
+
+// Commands
+#define TUNE_GET 'g'
+#define TUNE_SET 's'
+#define TUNE_SAVE 'w'
+#define TUNE_CAL 'c'
+#define TUNE_COUNT 'n'
+#define TUNE_ERR '!'
+#define TUNE_LOG 'l' // Sensor log record, reply only
+
+// Error codes
+#define TUNE_ERR_CRC 1 // Frame corrupted
+#define TUNE_ERR_CMD 2 // Unknown command
+#define TUNE_ERR_ARG 3 // Wrong length or value out of range
+#define TUNE_ERR_BUSY 4 // Not allowed in RUN
+
+#ifdef TUNE
+extern volatile unsigned char tune_on; // 1 when serial is used for tuning
+
+void tune_enable(void);
+void tune_rx(unsigned char byte);
+void tune_tx(void);
+unsigned char tune_space(void);
+void tune_reply(unsigned char command, unsigned char *data, unsigned char n);
+unsigned char tune_poll(struct Control *cont, struct DC_motor *mL, struct DC_motor *mR);
+#else
+#define tune_on 0 // Serial never used for tuning
+#define tune_rx(byte) ((void) 0)
+#define tune_tx() ((void) 0)
+#define tune_poll(cont, mL, mR) ((void) 0) // Never requests a calibration
+#endif
+
+#endif